@@ -1,6 +1,8 @@
 #include "airfoil.h"
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 #include "panel.h"
@@ -134,8 +136,8 @@ Airfoil Airfoil::getNACA4Airfoil(int pointCount, double maxCamberPercent, double
         throw std::invalid_argument("Max Camber Position Percentage must be at least 0 and at most 90.");
     if (thicknessPercent < 1 || thicknessPercent > 40)
         throw std::invalid_argument("Thickness Percentage must be at least 0 and at most 40.");
-    if (pointCount < 20 || pointCount > 200)
-        throw std::invalid_argument("Point Count must be at least 20 and at most 200.");
+    if (pointCount < 20 || pointCount > 20000)
+        throw std::invalid_argument("Point Count must be at least 20 and at most 20000.");
     if (pointCount % 2 != 0)
         throw std::invalid_argument("Point Count must be an even number.");
 
@@ -146,7 +148,7 @@ Airfoil Airfoil::getNACA4Airfoil(int pointCount, double maxCamberPercent, double
     double t = thicknessPercent / 100.0;
     std::vector<Point> upper((pointCount + 2) / 2);
     std::vector<Point> lower((pointCount + 2) / 2);
-    for (int i = 0; i <= (pointCount + 2) / 2; ++i)
+    for (int i = 0; i < (pointCount + 2) / 2; ++i)
     {
         double x = (1 - std::cos(i * (M_PI / (pointCount / 2)))) / 2.0;
         double y_C = x < p ? (m / (p * p)) * (2 * p * x - x * x) : (m / ((1 - p) * (1 - p))) * (1 - 2 * p + 2 * p * x - x * x);
@@ -164,7 +166,7 @@ Airfoil Airfoil::getNACA4Airfoil(int pointCount, double maxCamberPercent, double
     // Combine upper and lower points in order
     std::reverse(lower.begin(), lower.end());
     std::vector<Point> points(pointCount + 1);
-    for (int i = 0; i <= points.size() + 1; ++i)
+    for (int i = 0; i < points.size(); ++i)
         if (i < lower.size())
             points[i] = lower[i];
         else
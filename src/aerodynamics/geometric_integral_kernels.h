@@ -0,0 +1,50 @@
+#ifndef AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALKERNELS_H_
+#define AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALKERNELS_H_
+
+namespace aerodynamics
+{
+    /// @brief the panel geometry arrays the kernels read, as plain pointers so the translation units built for one instruction set compile no inline function the rest of the program shares
+    struct KernelGeometry
+    {
+        const double *startX;
+        const double *startY;
+        const double *midX;
+        const double *midY;
+        const double *sinPhi;
+        const double *cosPhi;
+        const double *length;
+    };
+
+    /// @brief the GeometricIntegrals kernels compiled for one instruction set
+    struct GeometricIntegralKernels
+    {
+        /// @brief source panels evaluated together
+        int laneCount;
+
+        /// @brief I_ij and J_ij at the control point of panel i for the source panels [begin, end), either output may be null to skip it
+        void (*computePanelIntegrals)(const KernelGeometry &geometry, int i, int begin, int end, double *normal, double *tangential);
+
+        /// @brief Mx and My of the source panels [begin, end) at a point
+        void (*computePointIntegrals)(const KernelGeometry &geometry, double x, double y, int begin, int end, double *mx, double *my);
+
+        /// @brief the natural logarithm of count inputs
+        void (*log)(const double *x, double *result, int count);
+
+        /// @brief the two argument arctangent of count inputs
+        void (*atan2)(const double *y, const double *x, double *result, int count);
+    };
+
+    /// @brief gets the portable kernels, one panel at a time
+    /// @return the scalar kernels
+    const GeometricIntegralKernels *getScalarGeometricIntegralKernels();
+
+    /// @brief gets the kernels for AVX2 with FMA, four panels at a time
+    /// @return the AVX2 kernels, or null when the compiler could not build them
+    const GeometricIntegralKernels *getAvx2GeometricIntegralKernels();
+
+    /// @brief gets the kernels for AVX-512, eight panels at a time
+    /// @return the AVX-512 kernels, or null when the compiler could not build them
+    const GeometricIntegralKernels *getAvx512GeometricIntegralKernels();
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
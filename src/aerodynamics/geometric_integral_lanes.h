@@ -0,0 +1,295 @@
+#ifndef AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALLANES_H_
+#define AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALLANES_H_
+
+// The body of one set of GeometricIntegrals kernels, included once by each translation unit that builds them after it
+// defines GEOMETRIC_INTEGRAL_LANES to 1 for the portable build, 4 for AVX2 or 8 for AVX-512 and compiles for that target
+
+#include <cmath>
+#include <cstring>
+
+#if GEOMETRIC_INTEGRAL_LANES > 1
+#include <immintrin.h>
+#endif
+
+#include "geometric_integral_kernels.h"
+
+namespace
+{
+    /// @brief the logarithm and arctangent terms shared by every c and d, atan((s + a) / e) - atan(a / e) = atan2(s e, b + a s) and d - a c vanishes with e on the panel line
+    inline void findTerms(double a, double b, double s, double &logTerm, double &atanTerm)
+    {
+        double e = b - a * a > 0 ? std::sqrt(b - a * a) : 0.0;
+        logTerm = 0.5 * std::log((s * s + 2.0 * a * s + b) / b);
+        atanTerm = e > 0 ? std::atan2(s * e, b + a * s) / e : 0.0;
+    }
+
+    /// @brief scalar I_ij and J_ij for the lanes left over after the last full batch and for the portable build
+    inline void panelIntegrals(const aerodynamics::KernelGeometry &geometry, int i, int j, double &normal, double &tangential)
+    {
+        double sinI = geometry.sinPhi[i];
+        double cosI = geometry.cosPhi[i];
+        double sinJ = geometry.sinPhi[j];
+        double cosJ = geometry.cosPhi[j];
+        double dx = geometry.midX[i] - geometry.startX[j];
+        double dy = geometry.midY[i] - geometry.startY[j];
+        double a = -dx * cosJ - dy * sinJ;
+        double b = dx * dx + dy * dy;
+        double logTerm, atanTerm;
+        findTerms(a, b, geometry.length[j], logTerm, atanTerm);
+        double cI = sinI * cosJ - cosI * sinJ;
+        double dI = -dx * sinI + dy * cosI;
+        double cJ = -(cosI * cosJ + sinI * sinJ);
+        double dJ = dx * cosI + dy * sinI;
+        normal = cI * logTerm + (dI - a * cI) * atanTerm;
+        tangential = cJ * logTerm + (dJ - a * cJ) * atanTerm;
+    }
+
+    /// @brief scalar Mx and My of one source panel given its midpoint, orientation and length
+    inline void pointIntegrals(double x, double y, double midX, double midY, double sinJ, double cosJ, double length, double &mx, double &my)
+    {
+        double dx = x - midX;
+        double dy = y - midY;
+        double a = -dx * cosJ - dy * sinJ;
+        double b = dx * dx + dy * dy;
+        double logTerm, atanTerm;
+        findTerms(a, b, length, logTerm, atanTerm);
+        mx = -cosJ * logTerm + (dx + a * cosJ) * atanTerm;
+        my = -sinJ * logTerm + (dy + a * sinJ) * atanTerm;
+    }
+
+#if GEOMETRIC_INTEGRAL_LANES > 1
+    typedef double Lanes __attribute__((vector_size(GEOMETRIC_INTEGRAL_LANES * sizeof(double))));
+    typedef long long LaneBits __attribute__((vector_size(GEOMETRIC_INTEGRAL_LANES * sizeof(double))));
+
+    inline Lanes broadcast(double value)
+    {
+        Lanes lanes = {};
+        return lanes + value;
+    }
+
+    inline LaneBits broadcastBits(long long value)
+    {
+        LaneBits lanes = {};
+        return lanes + value;
+    }
+
+    inline Lanes load(const double *values)
+    {
+        Lanes lanes;
+        std::memcpy(&lanes, values, sizeof(Lanes));
+        return lanes;
+    }
+
+    inline void store(Lanes lanes, double *values)
+    {
+        std::memcpy(values, &lanes, sizeof(Lanes));
+    }
+
+    inline LaneBits toBits(Lanes lanes)
+    {
+        LaneBits bits;
+        std::memcpy(&bits, &lanes, sizeof(Lanes));
+        return bits;
+    }
+
+    inline Lanes fromBits(LaneBits bits)
+    {
+        Lanes lanes;
+        std::memcpy(&lanes, &bits, sizeof(Lanes));
+        return lanes;
+    }
+
+    inline bool anyLane(LaneBits mask)
+    {
+        for (int t = 0; t < GEOMETRIC_INTEGRAL_LANES; t++)
+            if (mask[t] != 0)
+                return true;
+        return false;
+    }
+
+#if GEOMETRIC_INTEGRAL_LANES == 8
+    inline Lanes sqrtLanes(Lanes x) { return _mm512_sqrt_pd(x); }
+#else
+    inline Lanes sqrtLanes(Lanes x) { return _mm256_sqrt_pd(x); }
+#endif
+
+    /// @brief fdlibm's log: x = 2^k m with m in [sqrt(2) / 2, sqrt(2)), then log(m) = 2 atanh(f / (2 + f)) with f = m - 1 from a degree 14 polynomial, error below 1 ulp
+    inline Lanes logLanes(Lanes x)
+    {
+        const double ln2Hi = 6.93147180369123816490e-01, ln2Lo = 1.90821492927058770002e-10;
+        const double lg1 = 6.666666666666735130e-01, lg2 = 3.999999999940941908e-01, lg3 = 2.857142874366239149e-01, lg4 = 2.222219843214978396e-01;
+        const double lg5 = 1.818357216161805012e-01, lg6 = 1.531383769920937332e-01, lg7 = 1.479819860511658591e-01;
+
+        LaneBits bits = toBits(x);
+        // zero, subnormal, negative, infinite and NaN lanes fall back to the library
+        LaneBits special = (bits < broadcastBits(0x0010000000000000LL)) | (bits >= broadcastBits(0x7ff0000000000000LL));
+        LaneBits exponent = bits >> 52;
+        Lanes m = fromBits((bits & broadcastBits(0x000fffffffffffffLL)) | broadcastBits(0x3ff0000000000000LL));
+        LaneBits high = m > broadcast(M_SQRT2);
+        m = high ? m * 0.5 : m;
+        // the biased exponent is below 2^52, so adding it to the bits of 2^52 converts it exactly
+        Lanes k = fromBits((exponent - high) | broadcastBits(0x4330000000000000LL)) - broadcast(4503599627370496.0 + 1023.0);
+
+        Lanes f = m - 1.0;
+        Lanes hfsq = 0.5 * f * f;
+        Lanes s = f / (2.0 + f);
+        Lanes z = s * s;
+        Lanes w = z * z;
+        Lanes t1 = w * (lg2 + w * (lg4 + w * lg6));
+        Lanes t2 = z * (lg1 + w * (lg3 + w * (lg5 + w * lg7)));
+        Lanes r = t2 + t1;
+        Lanes result = k * ln2Hi - ((hfsq - (s * (hfsq + r) + k * ln2Lo)) - f);
+        if (anyLane(special))
+            for (int t = 0; t < GEOMETRIC_INTEGRAL_LANES; t++)
+                if (special[t] != 0)
+                    result[t] = std::log(x[t]);
+        return result;
+    }
+
+    /// @brief Cephes' atan: |y / x| is reduced to at most 0.66 through tan(pi / 4 + u) and tan(pi / 2 + u) with a single division, then a degree 4/5 rational approximation, error below 2 ulp
+    inline Lanes atan2Lanes(Lanes y, Lanes x)
+    {
+        const double p0 = -8.750608600031904122785e-01, p1 = -1.615753718733365076637e+01, p2 = -7.500855792314704667340e+01;
+        const double p3 = -1.228866684490136173410e+02, p4 = -6.485021904942025371773e+01;
+        const double q0 = 2.485846490142306297962e+01, q1 = 1.650270098316988542046e+02, q2 = 4.328810604912902668951e+02;
+        const double q3 = 4.853903996359136964868e+02, q4 = 1.945506571482613964425e+02;
+        const double moreBits = 6.123233995736765886130e-17;
+        const double tan3PiOver8 = 2.41421356237309504880;
+
+        LaneBits signMask = broadcastBits(0x8000000000000000LL);
+        LaneBits yBits = toBits(y);
+        LaneBits xBits = toBits(x);
+        Lanes ay = fromBits(yBits & ~signMask);
+        Lanes ax = fromBits(xBits & ~signMask);
+        Lanes zero = {};
+        Lanes infinity = broadcast(HUGE_VAL);
+        // infinite, NaN and double zero lanes fall back to the library
+        LaneBits special = ((ay == zero) & (ax == zero)) | ~(ay < infinity) | ~(ax < infinity);
+
+        LaneBits big = ay > tan3PiOver8 * ax;
+        LaneBits middle = ay > 0.66 * ax;
+        Lanes numerator = big ? -ax : (middle ? ay - ax : ay);
+        Lanes denominator = big ? ay : (middle ? ay + ax : ax);
+        Lanes u = numerator / denominator;
+        Lanes base = big ? broadcast(M_PI_2) : (middle ? broadcast(M_PI_4) : zero);
+        Lanes more = big ? broadcast(moreBits) : (middle ? broadcast(0.5 * moreBits) : zero);
+        Lanes z = u * u;
+        Lanes p = (((p0 * z + p1) * z + p2) * z + p3) * z + p4;
+        Lanes q = ((((z + q0) * z + q1) * z + q2) * z + q3) * z + q4;
+        Lanes angle = base + ((u * (z * p / q) + u) + more);
+        angle = (xBits < broadcastBits(0)) ? broadcast(M_PI) - angle : angle;
+        Lanes result = fromBits(toBits(angle) | (yBits & signMask));
+        if (anyLane(special))
+            for (int t = 0; t < GEOMETRIC_INTEGRAL_LANES; t++)
+                if (special[t] != 0)
+                    result[t] = std::atan2(y[t], x[t]);
+        return result;
+    }
+
+    /// @brief vector form of findTerms
+    inline void findTermLanes(Lanes a, Lanes b, Lanes s, Lanes &logTerm, Lanes &atanTerm)
+    {
+        Lanes zero = {};
+        Lanes e2 = b - a * a;
+        LaneBits offLine = e2 > zero;
+        Lanes e = sqrtLanes(offLine ? e2 : zero);
+        logTerm = 0.5 * logLanes((s * s + 2.0 * a * s + b) / b);
+        Lanes angle = atan2Lanes(s * e, b + a * s);
+        atanTerm = offLine ? angle / e : zero;
+    }
+#endif
+
+    /// @brief I_ij and J_ij of the source panels [begin, end) at the control point of panel i, a full batch of lanes at a time, skipping a null output
+    void computePanelIntegralLanes(const aerodynamics::KernelGeometry &geometry, int i, int begin, int end, double *normal, double *tangential)
+    {
+        int j = begin;
+#if GEOMETRIC_INTEGRAL_LANES > 1
+        double sinI = geometry.sinPhi[i];
+        double cosI = geometry.cosPhi[i];
+        Lanes midX = broadcast(geometry.midX[i]);
+        Lanes midY = broadcast(geometry.midY[i]);
+        for (; j + GEOMETRIC_INTEGRAL_LANES <= end; j += GEOMETRIC_INTEGRAL_LANES)
+        {
+            Lanes sinJ = load(geometry.sinPhi + j);
+            Lanes cosJ = load(geometry.cosPhi + j);
+            Lanes dx = midX - load(geometry.startX + j);
+            Lanes dy = midY - load(geometry.startY + j);
+            Lanes a = -dx * cosJ - dy * sinJ;
+            Lanes b = dx * dx + dy * dy;
+            Lanes logTerm, atanTerm;
+            findTermLanes(a, b, load(geometry.length + j), logTerm, atanTerm);
+            Lanes cI = sinI * cosJ - cosI * sinJ;
+            Lanes dI = -dx * sinI + dy * cosI;
+            Lanes cJ = -(cosI * cosJ + sinI * sinJ);
+            Lanes dJ = dx * cosI + dy * sinI;
+            if (normal != nullptr)
+                store(cI * logTerm + (dI - a * cI) * atanTerm, normal + j - begin);
+            if (tangential != nullptr)
+                store(cJ * logTerm + (dJ - a * cJ) * atanTerm, tangential + j - begin);
+        }
+#endif
+        for (; j < end; j++)
+        {
+            double normalJ, tangentialJ;
+            panelIntegrals(geometry, i, j, normalJ, tangentialJ);
+            if (normal != nullptr)
+                normal[j - begin] = normalJ;
+            if (tangential != nullptr)
+                tangential[j - begin] = tangentialJ;
+        }
+    }
+
+    /// @brief Mx and My of the source panels [begin, end) at a point, a full batch of lanes at a time
+    void computePointIntegralLanes(const aerodynamics::KernelGeometry &geometry, double x, double y, int begin, int end, double *mx, double *my)
+    {
+        int j = begin;
+#if GEOMETRIC_INTEGRAL_LANES > 1
+        Lanes pointX = broadcast(x);
+        Lanes pointY = broadcast(y);
+        for (; j + GEOMETRIC_INTEGRAL_LANES <= end; j += GEOMETRIC_INTEGRAL_LANES)
+        {
+            Lanes sinJ = load(geometry.sinPhi + j);
+            Lanes cosJ = load(geometry.cosPhi + j);
+            Lanes dx = pointX - load(geometry.midX + j);
+            Lanes dy = pointY - load(geometry.midY + j);
+            Lanes a = -dx * cosJ - dy * sinJ;
+            Lanes b = dx * dx + dy * dy;
+            Lanes logTerm, atanTerm;
+            findTermLanes(a, b, load(geometry.length + j), logTerm, atanTerm);
+            store(-cosJ * logTerm + (dx + a * cosJ) * atanTerm, mx + j - begin);
+            store(-sinJ * logTerm + (dy + a * sinJ) * atanTerm, my + j - begin);
+        }
+#endif
+        for (; j < end; j++)
+            pointIntegrals(x, y, geometry.midX[j], geometry.midY[j], geometry.sinPhi[j], geometry.cosPhi[j], geometry.length[j], mx[j - begin], my[j - begin]);
+    }
+
+    /// @brief logarithms a full batch of lanes at a time
+    void logLaneKernel(const double *x, double *result, int count)
+    {
+        int k = 0;
+#if GEOMETRIC_INTEGRAL_LANES > 1
+        for (; k + GEOMETRIC_INTEGRAL_LANES <= count; k += GEOMETRIC_INTEGRAL_LANES)
+            store(logLanes(load(x + k)), result + k);
+#endif
+        for (; k < count; k++)
+            result[k] = std::log(x[k]);
+    }
+
+    /// @brief arctangents a full batch of lanes at a time
+    void atan2LaneKernel(const double *y, const double *x, double *result, int count)
+    {
+        int k = 0;
+#if GEOMETRIC_INTEGRAL_LANES > 1
+        for (; k + GEOMETRIC_INTEGRAL_LANES <= count; k += GEOMETRIC_INTEGRAL_LANES)
+            store(atan2Lanes(load(y + k), load(x + k)), result + k);
+#endif
+        for (; k < count; k++)
+            result[k] = std::atan2(y[k], x[k]);
+    }
+
+    // The kernels of this translation unit
+    const aerodynamics::GeometricIntegralKernels laneKernels = {GEOMETRIC_INTEGRAL_LANES, computePanelIntegralLanes, computePointIntegralLanes, logLaneKernel, atan2LaneKernel};
+} // namespace
+
+#endif
\ No newline at end of file
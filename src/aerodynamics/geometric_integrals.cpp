@@ -0,0 +1,124 @@
+#include "geometric_integrals.h"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "panel.h"
+#include "panel_geometry.h"
+#include "point.h"
+#include "profiler.h"
+
+// the portable kernels, compiled for the baseline target like the rest of the solver
+#define GEOMETRIC_INTEGRAL_LANES 1
+#include "geometric_integral_lanes.h"
+
+using aerodynamics::GeometricIntegrals;
+
+using aerodynamics::GeometricIntegralKernels;
+using aerodynamics::KernelGeometry;
+using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
+using geometry::Point;
+
+namespace
+{
+    /// @brief the kernels the compiler built and the CPU runs, from narrowest to widest
+    std::vector<const GeometricIntegralKernels *> findSupportedKernels()
+    {
+        std::vector<const GeometricIntegralKernels *> supported{aerodynamics::getScalarGeometricIntegralKernels()};
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        const GeometricIntegralKernels *avx2 = aerodynamics::getAvx2GeometricIntegralKernels();
+        if (avx2 != nullptr && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            supported.push_back(avx2);
+        const GeometricIntegralKernels *avx512 = aerodynamics::getAvx512GeometricIntegralKernels();
+        if (avx512 != nullptr && __builtin_cpu_supports("avx512f"))
+            supported.push_back(avx512);
+#endif
+        return supported;
+    }
+
+    /// @brief the kernels every call uses, chosen on first use
+    std::atomic<const GeometricIntegralKernels *> &getActiveKernels()
+    {
+        static std::atomic<const GeometricIntegralKernels *> kernels(findSupportedKernels().back());
+        return kernels;
+    }
+
+    /// @brief the arrays of a panel geometry the kernels read
+    KernelGeometry getKernelGeometry(const PanelGeometry &geometry)
+    {
+        return KernelGeometry{geometry.getStartX().data(), geometry.getStartY().data(), geometry.getMidX().data(), geometry.getMidY().data(), geometry.getSinPhi().data(), geometry.getCosPhi().data(), geometry.getLength().data()};
+    }
+} // namespace
+
+const GeometricIntegralKernels *aerodynamics::getScalarGeometricIntegralKernels()
+{
+    return &laneKernels;
+}
+
+int GeometricIntegrals::laneCount()
+{
+    return getActiveKernels().load(std::memory_order_relaxed)->laneCount;
+}
+
+std::vector<int> GeometricIntegrals::getSupportedLaneCounts()
+{
+    std::vector<int> laneCounts;
+    for (const GeometricIntegralKernels *kernels : findSupportedKernels())
+        laneCounts.push_back(kernels->laneCount);
+    return laneCounts;
+}
+
+void GeometricIntegrals::setLaneCount(int laneCount)
+{
+    for (const GeometricIntegralKernels *kernels : findSupportedKernels())
+        if (kernels->laneCount == laneCount)
+        {
+            getActiveKernels().store(kernels, std::memory_order_relaxed);
+            return;
+        }
+    throw std::invalid_argument("The lane count must be one of the supported lane counts");
+}
+
+void GeometricIntegrals::computePanelIntegrals(const PanelGeometry &geometry, int i, int begin, int end, double *normal, double *tangential)
+{
+    // one logarithm and one arctangent per panel
+    AIRFOILS_PROFILE_COUNT(TranscendentalCalls, 2 * (end - begin));
+    getActiveKernels().load(std::memory_order_relaxed)->computePanelIntegrals(getKernelGeometry(geometry), i, begin, end, normal, tangential);
+    if (i < begin || i >= end)
+        return;
+    if (normal != nullptr)
+        normal[i - begin] = 0.0;
+    if (tangential != nullptr)
+        tangential[i - begin] = 0.0;
+}
+
+void GeometricIntegrals::computePointIntegrals(const PanelGeometry &geometry, double x, double y, int begin, int end, double *mx, double *my)
+{
+    AIRFOILS_PROFILE_COUNT(TranscendentalCalls, 2 * (end - begin));
+    getActiveKernels().load(std::memory_order_relaxed)->computePointIntegrals(getKernelGeometry(geometry), x, y, begin, end, mx, my);
+}
+
+void GeometricIntegrals::computePointIntegrals(const Panel &panel, double x, double y, double &mx, double &my)
+{
+    AIRFOILS_PROFILE_COUNT(TranscendentalCalls, 2);
+    Point start = panel.getStart();
+    Point end = panel.getEnd();
+    Point mid = panel.getMid();
+    double length = panel.getLength();
+    // sin and cos of the panel angle straight from its direction, which needs no trigonometry
+    pointIntegrals(x, y, mid.x, mid.y, (end.y - start.y) / length, (end.x - start.x) / length, length, mx, my);
+}
+
+void GeometricIntegrals::log(const double *x, double *result, int count)
+{
+    getActiveKernels().load(std::memory_order_relaxed)->log(x, result, count);
+}
+
+void GeometricIntegrals::atan2(const double *y, const double *x, double *result, int count)
+{
+    getActiveKernels().load(std::memory_order_relaxed)->atan2(y, x, result, count);
+}
\ No newline at end of file
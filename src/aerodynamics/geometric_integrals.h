@@ -0,0 +1,69 @@
+#ifndef AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALS_H_
+#define AIRFOILS_AERODYNAMICS_GEOMETRICINTEGRALS_H_
+
+#include <vector>
+
+#include "panel.h"
+#include "panel_geometry.h"
+
+namespace aerodynamics
+{
+    /// @brief batched geometric integrals of (c s + d) / (s^2 + 2 a s + b) over source panels, evaluated several panels at a time in SIMD lanes when the CPU supports them
+    class GeometricIntegrals
+    {
+    public:
+        /// @brief gets the number of source panels evaluated together, the widest the CPU supports unless setLaneCount chose another
+        /// @return 8 with AVX-512, 4 with AVX2 and FMA, and 1 for the portable kernels
+        static int laneCount();
+
+        /// @brief gets the lane counts of the kernels built into the library that the CPU can run
+        /// @return the lane counts from narrowest to widest, always starting with 1
+        static std::vector<int> getSupportedLaneCounts();
+
+        /// @brief selects the kernels every later call uses, to compare the instruction sets against each other
+        /// @param laneCount one of getSupportedLaneCounts()
+        static void setLaneCount(int laneCount);
+
+        /// @brief computes the normal (I) and tangential (J) velocity integrals at the control point of panel i for the source panels [begin, end), the vortex integrals L are -I
+        /// @param geometry panel geometry of the airfoil
+        /// @param i target panel
+        /// @param begin first source panel
+        /// @param end one past the last source panel
+        /// @param normal receives I_ij at normal[j - begin], zero for j == i, or null to compute only J
+        /// @param tangential receives J_ij at tangential[j - begin], zero for j == i, or null to compute only I
+        static void computePanelIntegrals(const aerodynamics::PanelGeometry &geometry, int i, int begin, int end, double *normal, double *tangential);
+
+        /// @brief computes the x (Mx) and y (My) velocity integrals of the source panels [begin, end) at a point, where the vortex integrals are Nx = -My and Ny = Mx
+        /// @param geometry panel geometry of the airfoil
+        /// @param x point x
+        /// @param y point y
+        /// @param begin first source panel
+        /// @param end one past the last source panel
+        /// @param mx receives Mx at mx[j - begin]
+        /// @param my receives My at my[j - begin]
+        static void computePointIntegrals(const aerodynamics::PanelGeometry &geometry, double x, double y, int begin, int end, double *mx, double *my);
+
+        /// @brief computes the x (Mx) and y (My) velocity integrals of a single source panel at a point, without building a panel geometry
+        /// @param panel source panel
+        /// @param x point x
+        /// @param y point y
+        /// @param mx receives Mx
+        /// @param my receives My
+        static void computePointIntegrals(const aerodynamics::Panel &panel, double x, double y, double &mx, double &my);
+
+        /// @brief the natural logarithm used by the kernels, within 1 ulp of the correctly rounded result for positive normal inputs and exact to the library for any other input
+        /// @param x inputs
+        /// @param result receives log(x[k]) at result[k], may alias x
+        /// @param count input count
+        static void log(const double *x, double *result, int count);
+
+        /// @brief the two argument arctangent used by the kernels, within 2 ulp of the correctly rounded result for finite inputs that are not both zero and exact to the library for any other input
+        /// @param y numerators
+        /// @param x denominators
+        /// @param result receives atan2(y[k], x[k]) at result[k], may alias y or x
+        /// @param count input count
+        static void atan2(const double *y, const double *x, double *result, int count);
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "geometric_integral_kernels.h"
+
+// compiled with -mavx2 -mfma, the kernels only run once the CPU reports both
+#if defined(__GNUC__) && defined(__AVX2__) && defined(__FMA__)
+#define GEOMETRIC_INTEGRAL_LANES 4
+#include "geometric_integral_lanes.h"
+
+const aerodynamics::GeometricIntegralKernels *aerodynamics::getAvx2GeometricIntegralKernels()
+{
+    return &laneKernels;
+}
+#else
+const aerodynamics::GeometricIntegralKernels *aerodynamics::getAvx2GeometricIntegralKernels()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
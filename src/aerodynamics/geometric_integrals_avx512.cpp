@@ -0,0 +1,17 @@
+#include "geometric_integral_kernels.h"
+
+// compiled with -mavx512f, the kernels only run once the CPU reports it
+#if defined(__GNUC__) && defined(__AVX512F__)
+#define GEOMETRIC_INTEGRAL_LANES 8
+#include "geometric_integral_lanes.h"
+
+const aerodynamics::GeometricIntegralKernels *aerodynamics::getAvx512GeometricIntegralKernels()
+{
+    return &laneKernels;
+}
+#else
+const aerodynamics::GeometricIntegralKernels *aerodynamics::getAvx512GeometricIntegralKernels()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
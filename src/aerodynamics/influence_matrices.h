@@ -0,0 +1,38 @@
+#ifndef AIRFOILS_AERODYNAMICS_INFLUENCEMATRICES_H_
+#define AIRFOILS_AERODYNAMICS_INFLUENCEMATRICES_H_
+
+#include <vector>
+
+#include "hierarchical_matrix.h"
+#include "matrix.h"
+
+namespace aerodynamics
+{
+    /// @brief the source-vortex influence coefficients of an airfoil, which only depend on its geometry and not the angle of attack
+    struct InfluenceMatrices
+    {
+        /// @brief the (count + 1)x(count + 1) system matrix, where entry (i, j) of the panel block is the normal integral I_ij for i != j
+        linear_algebra::Matrix system;
+
+        /// @brief the countxcount tangential integrals J_ij of the sources, the vortex integrals L_ij are -I_ij so they are read from system
+        linear_algebra::Matrix tangential;
+
+        /// @brief the row sums of the vortex tangential integrals L_ij over j != i, one per panel
+        std::vector<double> vortexTangential;
+    };
+
+    /// @brief the source-vortex influence coefficients compressed into hierarchical matrices, for airfoils whose dense matrices do not fit in memory
+    struct HierarchicalInfluenceMatrices
+    {
+        /// @brief the (count + 1)x(count + 1) system matrix, the Kutta condition is clustered at the trailing edge
+        linear_algebra::HierarchicalMatrix system;
+
+        /// @brief the countxcount tangential integrals J_ij of the sources
+        linear_algebra::HierarchicalMatrix tangential;
+
+        /// @brief the row sums of the vortex tangential integrals L_ij over j != i, one per panel
+        std::vector<double> vortexTangential;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
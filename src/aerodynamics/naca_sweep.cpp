@@ -0,0 +1,77 @@
+#include "naca_sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "airfoil.h"
+#include "panel_methods.h"
+#include "polar.h"
+#include "thread_pool.h"
+
+using aerodynamics::NACASweep;
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using aerodynamics::SweepCase;
+using aerodynamics::SweepRange;
+using aerodynamics::SweepSettings;
+using concurrency::ThreadPool;
+
+double NACASweep::getValue(const SweepRange &range, int k)
+{
+    return range.count == 1 ? range.first : range.first + (range.last - range.first) * k / (range.count - 1);
+}
+
+int NACASweep::countCases(const SweepSettings &settings)
+{
+    if (settings.maxCamberPercent.count < 1 || settings.maxCamberPositionPercent.count < 1 || settings.thicknessPercent.count < 1)
+        throw std::invalid_argument("The range counts must be at least one");
+    if (settings.pointCounts.empty())
+        throw std::invalid_argument("The point counts must not be empty");
+
+    return settings.maxCamberPercent.count * settings.maxCamberPositionPercent.count * settings.thicknessPercent.count * static_cast<int>(settings.pointCounts.size());
+}
+
+SweepCase NACASweep::getCase(const SweepSettings &settings, int index)
+{
+    if (index < 0 || index >= countCases(settings))
+        throw std::invalid_argument("The case index must be inside the sweep");
+
+    int remainder = index;
+    int pointCount = settings.pointCounts[remainder % settings.pointCounts.size()];
+    remainder /= settings.pointCounts.size();
+    int thickness = remainder % settings.thicknessPercent.count;
+    remainder /= settings.thicknessPercent.count;
+    int position = remainder % settings.maxCamberPositionPercent.count;
+    int camber = remainder / settings.maxCamberPositionPercent.count;
+    return SweepCase{index, getValue(settings.maxCamberPercent, camber), getValue(settings.maxCamberPositionPercent, position), getValue(settings.thicknessPercent, thickness), pointCount, aerodynamics::Polar()};
+}
+
+void NACASweep::run(const SweepSettings &settings, const std::function<void(const SweepCase &)> &onCase)
+{
+    // the solve cost grows with the square of the point count, so the largest cases start first and the small ones fill the gaps
+    int count = countCases(settings);
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    int pointCountSize = settings.pointCounts.size();
+    std::stable_sort(order.begin(), order.end(), [&settings, pointCountSize](int a, int b)
+                     { return settings.pointCounts[a % pointCountSize] > settings.pointCounts[b % pointCountSize]; });
+
+    // cases are claimed one at a time while the loops inside each solve are split across the deques of the pool
+    std::mutex outputMutex;
+    ThreadPool::shared().parallelFor(0, count, 1, [&](int caseBegin, int caseEnd)
+                                     {
+        for (int k = caseBegin; k < caseEnd; ++k)
+        {
+            SweepCase sweepCase = getCase(settings, order[k]);
+            Airfoil airfoil = Airfoil::getNACA4Airfoil(sweepCase.pointCount, sweepCase.maxCamberPercent, sweepCase.maxCamberPositionPercent, sweepCase.thicknessPercent, settings.closedTrailingEdge, 0.0);
+            sweepCase.polar = PanelMethods::computePolar(airfoil, settings.angles, settings.includePressure);
+            std::lock_guard<std::mutex> lock(outputMutex);
+            onCase(sweepCase);
+        } });
+}
\ No newline at end of file
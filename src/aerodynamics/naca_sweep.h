@@ -0,0 +1,96 @@
+#ifndef AIRFOILS_AERODYNAMICS_NACASWEEP_H_
+#define AIRFOILS_AERODYNAMICS_NACASWEEP_H_
+
+#include <functional>
+#include <vector>
+
+#include "polar.h"
+
+namespace aerodynamics
+{
+    /// @brief count evenly spaced values from first to last inclusive, a count of one takes first
+    struct SweepRange
+    {
+        /// @brief first value
+        double first = 0.0;
+
+        /// @brief last value
+        double last = 0.0;
+
+        /// @brief value count, at least one
+        int count = 1;
+    };
+
+    /// @brief the NACA 4-digit design space of a sweep, every combination of the parameter values is a case
+    struct SweepSettings
+    {
+        /// @brief maximum camber as a percentage of the chord
+        aerodynamics::SweepRange maxCamberPercent;
+
+        /// @brief the distance of maximum camber from the leading edge in tenths of the chord
+        aerodynamics::SweepRange maxCamberPositionPercent;
+
+        /// @brief maximum thickness as a percentage of the chord
+        aerodynamics::SweepRange thicknessPercent{12.0, 12.0, 1};
+
+        /// @brief point counts of the airfoils, each even
+        std::vector<int> pointCounts{100};
+
+        /// @brief indicates if the trailing edges are closed
+        bool closedTrailingEdge = false;
+
+        /// @brief angles of attack of every polar in degrees
+        std::vector<double> angles{0.0};
+
+        /// @brief indicates if the polars keep the pressure coefficients
+        bool includePressure = false;
+    };
+
+    /// @brief the parameters and polar of one airfoil of a sweep
+    struct SweepCase
+    {
+        /// @brief position in the enumeration order, where the point count varies fastest followed by thickness, camber position, and camber
+        int index;
+
+        /// @brief maximum camber as a percentage of the chord
+        double maxCamberPercent;
+
+        /// @brief the distance of maximum camber from the leading edge in tenths of the chord
+        double maxCamberPositionPercent;
+
+        /// @brief maximum thickness as a percentage of the chord
+        double thicknessPercent;
+
+        /// @brief point count of the airfoil
+        int pointCount;
+
+        /// @brief the polar, empty until the case is solved
+        aerodynamics::Polar polar;
+    };
+
+    /// @brief solves the polars of a NACA 4-digit design space on the shared thread pool
+    class NACASweep
+    {
+    private:
+        static double getValue(const aerodynamics::SweepRange &range, int k);
+
+    public:
+        /// @brief gets the number of cases of a sweep
+        /// @param settings the design space
+        /// @return the product of the parameter value counts
+        static int countCases(const aerodynamics::SweepSettings &settings);
+
+        /// @brief gets the parameters of one case without solving it
+        /// @param settings the design space
+        /// @param index case index in [0, countCases(settings))
+        /// @return the case with an empty polar
+        static aerodynamics::SweepCase getCase(const aerodynamics::SweepSettings &settings, int index);
+
+        /// @brief generates and solves every case, the largest point counts first, and streams each case as it completes
+        /// @param settings the design space
+        /// @param onCase receives every solved case in completion order, one call at a time
+        static void run(const aerodynamics::SweepSettings &settings, const std::function<void(const aerodynamics::SweepCase &)> &onCase);
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
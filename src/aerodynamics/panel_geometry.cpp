@@ -0,0 +1,48 @@
+#include "panel_geometry.h"
+
+#include <cmath>
+#include <initializer_list>
+#include <vector>
+
+#include "panel.h"
+#include "point.h"
+#include "profiler.h"
+
+using aerodynamics::PanelGeometry;
+
+using aerodynamics::Panel;
+using geometry::Point;
+
+PanelGeometry::PanelGeometry(const std::vector<Panel> &panels)
+{
+    assign(panels);
+}
+
+void PanelGeometry::assign(const std::vector<Panel> &panels)
+{
+    AIRFOILS_PROFILE_SCOPE("geometry");
+    for (std::vector<double> *values : {&mStartX, &mStartY, &mMidX, &mMidY, &mLength, &mPhi, &mSinPhi, &mCosPhi, &mBeta})
+        values->resize(panels.size());
+    for (int i = 0; i < panels.size(); ++i)
+    {
+        const Panel &panel = panels[i];
+        Point start = panel.getStart();
+        Point end = panel.getEnd();
+        double dx = end.x - start.x;
+        double dy = end.y - start.y;
+        mStartX[i] = start.x;
+        mStartY[i] = start.y;
+        Point mid = panel.getMid();
+        mMidX[i] = mid.x;
+        mMidY[i] = mid.y;
+        mLength[i] = panel.getLength();
+        // Same conventions as Panel::getPhiAngle and Panel::getBetaAngle, evaluated once
+        double phi = std::atan2(dy, dx);
+        if (phi < 0)
+            phi += 2.0 * M_PI;
+        mPhi[i] = phi;
+        mSinPhi[i] = std::sin(phi);
+        mCosPhi[i] = std::cos(phi);
+        mBeta[i] = std::fmod(phi + M_PI_2, 2.0 * M_PI) - panel.alphaAngle;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef AIRFOILS_AERODYNAMICS_PANELGEOMETRY_H_
+#define AIRFOILS_AERODYNAMICS_PANELGEOMETRY_H_
+
+#include <vector>
+
+#include "panel.h"
+
+namespace aerodynamics
+{
+    /// @brief per-panel geometry in structure-of-arrays layout, computed once per airfoil so influence kernels read contiguous doubles
+    class PanelGeometry
+    {
+    private:
+        std::vector<double> mStartX, mStartY, mMidX, mMidY, mLength, mPhi, mSinPhi, mCosPhi, mBeta;
+
+    public:
+        /// @brief extracts the geometry of the panels
+        /// @param panels panels of an airfoil in clock-wise order
+        PanelGeometry(const std::vector<aerodynamics::Panel> &panels);
+
+        /// @brief replaces the geometry with that of other panels, reusing the storage so nothing is allocated up to the largest panel count seen
+        /// @param panels panels of an airfoil in clock-wise order
+        void assign(const std::vector<aerodynamics::Panel> &panels);
+
+        /// @brief gets the panel count
+        /// @return panel count
+        inline int size() const { return mLength.size(); };
+
+        /// @brief gets the x positions of the panel starting points
+        /// @return x of each panel start
+        inline const std::vector<double> &getStartX() const { return mStartX; };
+
+        /// @brief gets the y positions of the panel starting points
+        /// @return y of each panel start
+        inline const std::vector<double> &getStartY() const { return mStartY; };
+
+        /// @brief gets the x positions of the panel mid points
+        /// @return x of each panel mid point
+        inline const std::vector<double> &getMidX() const { return mMidX; };
+
+        /// @brief gets the y positions of the panel mid points
+        /// @return y of each panel mid point
+        inline const std::vector<double> &getMidY() const { return mMidY; };
+
+        /// @brief gets the panel lengths
+        /// @return length of each panel
+        inline const std::vector<double> &getLength() const { return mLength; };
+
+        /// @brief gets the angles from the x axis to the panels
+        /// @return phi of each panel in radians
+        inline const std::vector<double> &getPhi() const { return mPhi; };
+
+        /// @brief gets the sines of the panel angles
+        /// @return sin phi of each panel
+        inline const std::vector<double> &getSinPhi() const { return mSinPhi; };
+
+        /// @brief gets the cosines of the panel angles
+        /// @return cos phi of each panel
+        inline const std::vector<double> &getCosPhi() const { return mCosPhi; };
+
+        /// @brief gets the angles from the angle of attack to the panel normals
+        /// @return beta of each panel in radians
+        inline const std::vector<double> &getBeta() const { return mBeta; };
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
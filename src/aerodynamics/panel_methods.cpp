@@ -1,222 +1,784 @@
 #include "panel_methods.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "airfoil.h"
+#include "block_jacobi_preconditioner.h"
+#include "geometric_integrals.h"
+#include "gmres.h"
+#include "hierarchical_matrix.h"
+#include "influence_matrices.h"
+#include "linear_operator.h"
+#include "lu_factorization.h"
 #include "panel.h"
+#include "panel_geometry.h"
+#include "panel_treecode.h"
+#include "polar.h"
 #include "point.h"
+#include "profiler.h"
 #include "vector.h"
 #include "matrix.h"
+#include "solution_cache.h"
+#include "solver_options.h"
+#include "solver_workspace.h"
+#include "source_vortex_basis.h"
+#include "source_vortex_operator.h"
+#include "thread_pool.h"
+#include "velocity_field.h"
 
 using aerodynamics::PanelMethods;
 
 using aerodynamics::Airfoil;
+using aerodynamics::CachedSolution;
+using aerodynamics::FieldGrid;
+using aerodynamics::GeometricIntegrals;
+using aerodynamics::HierarchicalInfluenceMatrices;
+using aerodynamics::InfluenceMatrices;
 using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
+using aerodynamics::PanelTreecode;
+using aerodynamics::Polar;
+using aerodynamics::SolutionCache;
+using aerodynamics::SolverMethod;
+using aerodynamics::SolverOptions;
+using aerodynamics::SolverWorkspace;
+using aerodynamics::SourceVortexBasis;
+using aerodynamics::SourceVortexOperator;
+using aerodynamics::TreecodeOptions;
+using aerodynamics::VelocityField;
+using concurrency::ThreadPool;
 using geometry::Point;
 using geometry::Vector;
+using linear_algebra::BlockJacobiPreconditioner;
+using linear_algebra::GMRES;
+using linear_algebra::HierarchicalMatrix;
+using linear_algebra::HierarchicalOptions;
+using linear_algebra::LinearOperator;
+using linear_algebra::LUFactorization;
 using linear_algebra::Matrix;
+using linear_algebra::MatrixOperator;
+using linear_algebra::SolverReport;
 
-double PanelMethods::findA(const Point &point1, const Point &point2, double phi)
+namespace
 {
-    return -(point1.x - point2.x) * std::cos(phi) - (point1.y - point2.y) * std::sin(phi);
+    // Influence matrix rows per parallel chunk, small enough to balance the uneven cost of near panels
+    const int assemblyRowGrain = 8;
+
+    // Polar angles per parallel chunk
+    const int polarAngleGrain = 4;
+
+    // Field points per parallel chunk
+    const int fieldPointGrain = 64;
+
+    // Source panels integrated together at a field point, sized for integrals kept on the stack
+    const int fieldPanelBlock = 256;
+
+    // Cache of solved airfoils shared by every thread, accessed atomically
+    std::shared_ptr<SolutionCache> solutionCache;
+
+    /// @brief sums the velocity every panel induces at a point, integrating a block of panels at a time into stack buffers
+    /// @tparam Strengths callable as strengths(j, lambda, gamma) that sets the source and vortex strengths of panel j over 2 pi
+    /// @param geometry panel geometry
+    /// @param x point x
+    /// @param y point y
+    /// @param strengths the strengths of each panel
+    /// @param sumX receives the x velocity of the panels
+    /// @param sumY receives the y velocity of the panels
+    template <typename Strengths>
+    void sumPanelVelocity(const PanelGeometry &geometry, double x, double y, const Strengths &strengths, double &sumX, double &sumY)
+    {
+        double mx[fieldPanelBlock], my[fieldPanelBlock];
+        int panelCount = geometry.size();
+        sumX = 0.0;
+        sumY = 0.0;
+        for (int begin = 0; begin < panelCount; begin += fieldPanelBlock)
+        {
+            int end = std::min(begin + fieldPanelBlock, panelCount);
+            GeometricIntegrals::computePointIntegrals(geometry, x, y, begin, end, mx, my);
+            // the vortex integrals are Nx = -My and Ny = Mx
+            for (int j = begin; j < end; j++)
+            {
+                double lambda, gamma;
+                strengths(j, lambda, gamma);
+                sumX += lambda * mx[j - begin] + gamma * my[j - begin];
+                sumY += lambda * my[j - begin] - gamma * mx[j - begin];
+            }
+        }
+    }
+} // namespace
+
+void PanelMethods::setSolutionCache(std::shared_ptr<SolutionCache> cache)
+{
+    std::atomic_store(&solutionCache, cache);
 }
 
-double PanelMethods::findB(const Point &point1, const Point &point2)
+std::shared_ptr<SolutionCache> PanelMethods::getSolutionCache()
 {
-    return (point1.x - point2.x) * (point1.x - point2.x) + (point1.y - point2.y) * (point1.y - point2.y);
+    return std::atomic_load(&solutionCache);
 }
 
-double PanelMethods::findC(double angle1, double angle2, bool reverse)
+double PanelMethods::findCp(double velocity)
 {
-    return reverse ? -std::cos(angle1 - angle2) : std::sin(angle1 - angle2);
+    return 1 - velocity * velocity;
 }
 
-double PanelMethods::findD(const Point &point1, const Point &point2, double phi, bool reverse)
+Matrix PanelMethods::computeSourceVortexMatrix(const Airfoil &airfoil)
 {
-    return reverse ? -(point1.x - point2.x) * std::sin(phi) + (point1.y - point2.y) * std::cos(phi) : (point1.x - point2.x) * std::cos(phi) + (point1.y - point2.y) * std::sin(phi);
+    return computeSourceVortexMatrix(PanelGeometry(airfoil));
 }
 
-double PanelMethods::findE(double a, double b)
+Matrix PanelMethods::computeSourceVortexMatrix(const PanelGeometry &geometry)
 {
-    if (b - a * a > 0)
-        return std::sqrt(b - a * a);
-    else
-        return 0;
+    AIRFOILS_PROFILE_SCOPE("assembly");
+    int count = geometry.size();
+    Matrix a(count + 1, count + 1);
+    assembleSourceVortex(geometry, a, nullptr, nullptr);
+    return a;
 }
 
-double PanelMethods::findGeometricIntegral(double a, double b, double c, double d, double e, double s)
+InfluenceMatrices PanelMethods::computeInfluenceMatrices(const PanelGeometry &geometry)
 {
-    return (c / 2.0) * std::log((s * s + 2.0 * a * s + b) / b) + ((d - a * c) / e) * (std::atan((s + a) / e) - std::atan(a / e));
+    AIRFOILS_PROFILE_SCOPE("assembly");
+    int count = geometry.size();
+    InfluenceMatrices matrices{Matrix(count + 1, count + 1), Matrix(count, count), std::vector<double>(count)};
+    assembleSourceVortex(geometry, matrices.system, &matrices.tangential, &matrices.vortexTangential);
+    return matrices;
 }
 
-/// @brief normal velocity geometric integral of panel i relative to panel j
-double PanelMethods::findIij(const Panel &i, const Panel &j)
+HierarchicalInfluenceMatrices PanelMethods::computeHierarchicalInfluenceMatrices(const PanelGeometry &geometry, const HierarchicalOptions &options)
 {
-    double a = findA(i.getMid(), j.getStart(), j.getPhiAngle());
-    double b = findB(i.getMid(), j.getStart());
-    double c = findC(i.getPhiAngle(), j.getPhiAngle(), false);
-    double d = findD(i.getMid(), j.getStart(), i.getPhiAngle(), true);
-    double e = findE(a, b);
-    double i_ij = findGeometricIntegral(a, b, c, d, e, j.getLength());
-    return i_ij;
+    AIRFOILS_PROFILE_SCOPE("assembly");
+    int count = geometry.size();
+    std::vector<double> x(geometry.getMidX()), y(geometry.getMidY());
+    HierarchicalMatrix tangential(x, y, [&geometry](int i, int columnBegin, int columnEnd, double *values)
+                                  { GeometricIntegrals::computePanelIntegrals(geometry, i, columnBegin, columnEnd, nullptr, values); },
+                                  options);
+
+    // the vortex column holds the row sums of J, which has a zero diagonal
+    std::vector<double> sumK(count);
+    tangential.apply(std::vector<double>(count, 1.0).data(), sumK.data());
+    // the Kutta condition row sums the exact tangential integrals of the first and last panels
+    std::vector<double> firstNormal(count), firstTangential(count), lastNormal(count), lastTangential(count);
+    GeometricIntegrals::computePanelIntegrals(geometry, 0, 0, count, firstNormal.data(), firstTangential.data());
+    GeometricIntegrals::computePanelIntegrals(geometry, count - 1, 0, count, lastNormal.data(), lastTangential.data());
+    double kuttaDiagonal = 2.0 * M_PI;
+    for (int j = 0; j < count; ++j)
+        kuttaDiagonal += firstNormal[j] + lastNormal[j];
+
+    x.push_back(geometry.getStartX().front());
+    y.push_back(geometry.getStartY().front());
+    HierarchicalMatrix system(x, y, [&](int i, int columnBegin, int columnEnd, double *values)
+                              {
+        if (i == count)
+        {
+            for (int j = columnBegin; j < columnEnd; j++)
+                values[j - columnBegin] = j == count ? kuttaDiagonal : firstTangential[j] + lastTangential[j];
+            return;
+        }
+        int panelEnd = std::min(columnEnd, count);
+        if (columnBegin < panelEnd)
+        {
+            GeometricIntegrals::computePanelIntegrals(geometry, i, columnBegin, panelEnd, values, nullptr);
+            if (i >= columnBegin && i < panelEnd)
+                values[i - columnBegin] = M_PI;
+        }
+        if (columnEnd > count)
+            values[count - columnBegin] = -sumK[i]; },
+                              options);
+
+    // the panel block row sums are pi plus the sums of I, and L = -I
+    std::vector<double> panels(count + 1, 1.0), sumA(count + 1);
+    panels[count] = 0.0;
+    system.apply(panels.data(), sumA.data());
+    std::vector<double> vortexTangential(count);
+    for (int i = 0; i < count; ++i)
+        vortexTangential[i] = M_PI - sumA[i];
+    return HierarchicalInfluenceMatrices{std::move(system), std::move(tangential), vortexTangential};
 }
 
-/// @brief tangential velocity geometric integral of panel i relative to panel j
-double PanelMethods::findJij(const Panel &i, const Panel &j)
+void PanelMethods::assembleSourceVortex(const PanelGeometry &geometry, Matrix &a, Matrix *tangential, std::vector<double> *vortexTangential, bool parallel)
 {
-    double a = findA(i.getMid(), j.getStart(), j.getPhiAngle());
-    double b = findB(i.getMid(), j.getStart());
-    double c = findC(i.getPhiAngle(), j.getPhiAngle(), true);
-    double d = findD(i.getMid(), j.getStart(), i.getPhiAngle(), false);
-    double e = findE(a, b);
-    double j_ij = findGeometricIntegral(a, b, c, d, e, j.getLength());
-    return j_ij;
+    int count = geometry.size();
+    // the Kutta condition row sums the tangential integrals of the first and last panels, which are kept when J is not stored
+    std::vector<double> firstTangential(tangential == nullptr ? count : 0), lastTangential(tangential == nullptr ? count : 0);
+    auto assembleRows = [&](int rowBegin, int rowEnd)
+    {
+        std::vector<double> tangentialBuffer(tangential == nullptr ? count : 0);
+        for (int i = rowBegin; i < rowEnd; ++i)
+        {
+            double *row = a[i];
+            double *tangentialRow = tangential != nullptr ? (*tangential)[i] : tangentialBuffer.data();
+            GeometricIntegrals::computePanelIntegrals(geometry, i, 0, count, row, tangentialRow);
+            double sumK = 0.0;
+            double sumI = 0.0;
+            for (int j = 0; j < count; j++)
+            {
+                sumK += tangentialRow[j];
+                sumI += row[j];
+            }
+            row[i] = M_PI;
+            row[count] = -sumK;
+            if (vortexTangential != nullptr)
+                (*vortexTangential)[i] = -sumI;
+            if (tangential == nullptr && i == 0)
+                std::copy(tangentialRow, tangentialRow + count, firstTangential.begin());
+            if (tangential == nullptr && i == count - 1)
+                std::copy(tangentialRow, tangentialRow + count, lastTangential.begin());
+        }
+    };
+    // every row is written by exactly one chunk in a fixed order, so the result does not depend on the thread count
+    if (parallel)
+        ThreadPool::shared().parallelFor(0, count, assemblyRowGrain, assembleRows);
+    else
+        assembleRows(0, count);
+
+    const double *first = tangential != nullptr ? (*tangential)[0] : firstTangential.data();
+    const double *last = tangential != nullptr ? (*tangential)[count - 1] : lastTangential.data();
+    double sumL = 0.0;
+    for (int j = 0; j < count; j++)
+    {
+        a(count, j) = first[j] + last[j];
+        if (j != 0)
+            sumL -= a(0, j);
+        if (j != count - 1)
+            sumL -= a(count - 1, j);
+    }
+    a(count, count) = -sumL + 2.0 * M_PI;
 }
 
-/// @brief tangential velocity geometric integral of panel i relative to panel j
-double PanelMethods::findLij(const Panel &i, const Panel &j)
+Matrix PanelMethods::computeSourceVortexRightHandSide(const PanelGeometry &geometry)
 {
-    double a = findA(i.getMid(), j.getStart(), j.getPhiAngle());
-    double b = findB(i.getMid(), j.getStart());
-    double c = findC(j.getPhiAngle(), i.getPhiAngle(), false);
-    double d = -findD(i.getMid(), j.getStart(), i.getPhiAngle(), true);
-    double e = findE(a, b);
-    double l_ij = findGeometricIntegral(a, b, c, d, e, j.getLength());
-    return l_ij;
+    Matrix b(geometry.size() + 1, 1);
+    computeSourceVortexRightHandSide(geometry, b.data());
+    return b;
 }
 
-double PanelMethods::findMx(const Panel &panel, const Point &point)
+void PanelMethods::computeSourceVortexRightHandSide(const PanelGeometry &geometry, double *b)
 {
-    double a = findA(point, panel.getMid(), panel.getPhiAngle());
-    double b = findB(point, panel.getMid());
-    double c = findC(panel.getPhiAngle(), 0, true);
-    double d = point.x - panel.getMid().x;
-    double e = findE(a, b);
-    return findGeometricIntegral(a, b, c, d, e, panel.getLength());
+    int count = geometry.size();
+    const std::vector<double> &beta = geometry.getBeta();
+    for (int i = 0; i < count; ++i)
+        b[i] = -2.0 * M_PI * std::cos(beta[i]);
+    b[count] = -2.0 * M_PI * (std::sin(beta.front()) + std::sin(beta.back()));
 }
 
-double PanelMethods::findNx(const Panel &panel, const Point &point)
+void PanelMethods::setSourceVortexStrengths(Airfoil &solved, const double *lambdasAndGamma)
 {
-    double a = findA(point, panel.getMid(), panel.getPhiAngle());
-    double b = findB(point, panel.getMid());
-    double c = findC(panel.getPhiAngle(), 0, false);
-    double d = -(point.y - panel.getMid().y);
-    double e = findE(a, b);
-    return findGeometricIntegral(a, b, c, d, e, panel.getLength());
+    int count = solved.size();
+    std::vector<double> lambdas(lambdasAndGamma, lambdasAndGamma + count);
+    std::vector<double> gammas(count, lambdasAndGamma[count]);
+    solved.setLambdas(lambdas);
+    solved.setGammas(gammas);
 }
 
-double PanelMethods::findMy(const Panel &panel, const Point &point)
+void PanelMethods::setSurfaceVelocity(Airfoil &solved, const PanelGeometry &geometry, const std::vector<double> &vortexTangential, std::vector<double> &velocities)
 {
-    double a = findA(point, panel.getMid(), panel.getPhiAngle());
-    double b = findB(point, panel.getMid());
-    double c = -findC(panel.getPhiAngle(), 0, false);
-    double d = point.y - panel.getMid().y;
-    double e = findE(a, b);
-    return findGeometricIntegral(a, b, c, d, e, panel.getLength());
+    int count = solved.size();
+    const std::vector<double> &beta = geometry.getBeta();
+    for (int i = 0; i < count; ++i)
+    {
+        double gamma = solved[i].gamma;
+        velocities[i] = std::sin(beta[i]) + (1.0 / (2.0 * M_PI)) * velocities[i] + gamma / 2.0 - (gamma / (2.0 * M_PI)) * vortexTangential[i];
+        solved[i].coefficientOfPressure = findCp(velocities[i]);
+    }
 }
 
-double PanelMethods::findNy(const Panel &panel, const Point &point)
+std::vector<double> PanelMethods::computeSurfaceVelocity(Airfoil &solved, const PanelGeometry &geometry, const InfluenceMatrices &matrices)
 {
-    double a = findA(point, panel.getMid(), panel.getPhiAngle());
-    double b = findB(point, panel.getMid());
-    double c = findC(panel.getPhiAngle(), 0, true);
-    double d = point.x - panel.getMid().x;
-    double e = findE(a, b);
-    return findGeometricIntegral(a, b, c, d, e, panel.getLength());
+    AIRFOILS_PROFILE_SCOPE("pressure");
+    int count = solved.size();
+    if (geometry.size() != count || matrices.tangential.rowCount() != count || matrices.vortexTangential.size() != count)
+        throw std::invalid_argument("The geometry and influence matrices must match the panel count");
+
+    std::vector<double> lambdas(count);
+    for (int i = 0; i < count; ++i)
+        lambdas[i] = solved[i].lambda;
+    // the source contribution is one matrix-vector product with J, which has a zero diagonal
+    std::vector<double> velocities(count);
+    matrices.tangential.multiply(lambdas.data(), velocities.data());
+    setSurfaceVelocity(solved, geometry, matrices.vortexTangential, velocities);
+    return velocities;
 }
 
-double PanelMethods::findCp(double velocity)
+std::vector<double> PanelMethods::computeSurfaceVelocity(Airfoil &solved, const PanelGeometry &geometry, const HierarchicalInfluenceMatrices &matrices)
 {
-    return 1 - velocity * velocity;
+    AIRFOILS_PROFILE_SCOPE("pressure");
+    int count = solved.size();
+    if (geometry.size() != count || matrices.tangential.size() != count || matrices.vortexTangential.size() != count)
+        throw std::invalid_argument("The geometry and influence matrices must match the panel count");
+
+    std::vector<double> lambdas(count);
+    for (int i = 0; i < count; ++i)
+        lambdas[i] = solved[i].lambda;
+    std::vector<double> velocities(count);
+    matrices.tangential.apply(lambdas.data(), velocities.data());
+    setSurfaceVelocity(solved, geometry, matrices.vortexTangential, velocities);
+    return velocities;
+}
+
+std::vector<double> PanelMethods::computeSurfaceVelocity(Airfoil &solved, const PanelGeometry &geometry, const SourceVortexOperator &sourceVortex)
+{
+    AIRFOILS_PROFILE_SCOPE("pressure");
+    int count = solved.size();
+    if (geometry.size() != count || sourceVortex.size() != count + 1)
+        throw std::invalid_argument("The geometry and operator must match the panel count");
+
+    std::vector<double> lambdas(count);
+    for (int i = 0; i < count; ++i)
+        lambdas[i] = solved[i].lambda;
+    std::vector<double> velocities(count);
+    sourceVortex.multiplyTangential(lambdas.data(), velocities.data());
+    setSurfaceVelocity(solved, geometry, sourceVortex.getVortexTangential(), velocities);
+    return velocities;
 }
 
 Airfoil PanelMethods::computeSourceVortex(const Airfoil &airfoil, double angleOfAttackDegrees)
 {
+    return computeSourceVortex(airfoil, angleOfAttackDegrees, SolverOptions());
+}
+
+std::vector<double> PanelMethods::solveSourceVortex(const LinearOperator &a, const std::function<double(int, int)> &entry, const PanelGeometry &geometry, const SolverOptions &options, SolverReport *report)
+{
+    Matrix b = computeSourceVortexRightHandSide(geometry);
+    std::vector<double> rightHandSide(b.data(), b.data() + b.rowCount());
+    std::vector<double> x;
+    SolverReport result;
+    GMRES gmres(options.tolerance, options.restart, options.maxIterations);
+    if (options.preconditionerBlockSize > 0)
+    {
+        BlockJacobiPreconditioner preconditioner(a.size(), options.preconditionerBlockSize, entry);
+        result = gmres.solve(a, rightHandSide, x, &preconditioner);
+    }
+    else
+        result = gmres.solve(a, rightHandSide, x);
+    if (report != nullptr)
+        *report = result;
+    return x;
+}
+
+Airfoil PanelMethods::computeSourceVortex(const Airfoil &airfoil, double angleOfAttackDegrees, const SolverOptions &options, SolverReport *report)
+{
+    AIRFOILS_PROFILE_SCOPE("computeSourceVortex");
+    std::shared_ptr<SolutionCache> cache = getSolutionCache();
+    if (cache == nullptr)
+        return computeSourceVortexUncached(airfoil, angleOfAttackDegrees, options, report);
+
+    std::string key = SolutionCache::createKey(airfoil, angleOfAttackDegrees, options);
+    CachedSolution cached;
+    if (cache->find(key, cached) && cached.pressures.size() == airfoil.size())
+    {
+        Airfoil solved{airfoil};
+        solved.setAngleOfAttack(angleOfAttackDegrees * M_PI / 180.0);
+        solved.setLambdas(cached.lambdas);
+        solved.setGammas(cached.gammas);
+        for (int i = 0; i < solved.size(); ++i)
+            solved[i].coefficientOfPressure = cached.pressures[i];
+        if (report != nullptr)
+            *report = cached.report;
+        return solved;
+    }
+
+    SolverReport result;
+    Airfoil solved = computeSourceVortexUncached(airfoil, angleOfAttackDegrees, options, &result);
+    CachedSolution solution{std::vector<double>(solved.size()), std::vector<double>(solved.size()), std::vector<double>(solved.size()), result};
+    for (int i = 0; i < solved.size(); ++i)
+    {
+        solution.lambdas[i] = solved[i].lambda;
+        solution.gammas[i] = solved[i].gamma;
+        solution.pressures[i] = solved[i].coefficientOfPressure;
+    }
+    cache->insert(key, solution);
+    if (report != nullptr)
+        *report = result;
+    return solved;
+}
+
+Airfoil PanelMethods::computeSourceVortexUncached(const Airfoil &airfoil, double angleOfAttackDegrees, const SolverOptions &options, SolverReport *report)
+{
+    // the influence matrices do not depend on the angle of attack, so one geometry serves the assembly and the solve
+    Airfoil solved{airfoil};
+    solved.setAngleOfAttack(angleOfAttackDegrees * M_PI / 180.0);
+    PanelGeometry geometry(solved);
+    if (options.method == SolverMethod::LowerUpperDecomposition)
+    {
+        InfluenceMatrices matrices = computeInfluenceMatrices(geometry);
+        computeSourceVortex(solved, geometry, matrices, LUFactorization(matrices.system));
+    }
+    else if (options.method == SolverMethod::HierarchicalGMRES)
+        computeSourceVortex(solved, geometry, computeHierarchicalInfluenceMatrices(geometry, options.hierarchical), options, report);
+    else if (options.method == SolverMethod::MatrixFreeGMRES)
+    {
+        SourceVortexOperator a(solved, options.treecode);
+        std::vector<double> x = solveSourceVortex(a, [&a](int i, int j)
+                                                  { return a.entry(i, j); },
+                                                  geometry, options, report);
+        setSourceVortexStrengths(solved, x.data());
+        computeSurfaceVelocity(solved, geometry, a);
+    }
+    else
+    {
+        InfluenceMatrices matrices = computeInfluenceMatrices(geometry);
+        const Matrix &a = matrices.system;
+        std::vector<double> x = solveSourceVortex(MatrixOperator(a), [&a](int i, int j)
+                                                  { return a(i, j); },
+                                                  geometry, options, report);
+        setSourceVortexStrengths(solved, x.data());
+        computeSurfaceVelocity(solved, geometry, matrices);
+    }
+    return solved;
+}
+
+Airfoil PanelMethods::computeSourceVortex(const Airfoil &airfoil, const HierarchicalInfluenceMatrices &matrices, double angleOfAttackDegrees, const SolverOptions &options, SolverReport *report)
+{
+    if (matrices.system.size() != airfoil.size() + 1 || matrices.tangential.size() != airfoil.size())
+        throw std::invalid_argument("The influence matrices must match the panel count");
+
     Airfoil solved{airfoil};
     solved.setAngleOfAttack(angleOfAttackDegrees * M_PI / 180.0);
+    computeSourceVortex(solved, PanelGeometry(solved), matrices, options, report);
+    return solved;
+}
 
-    int count = solved.size();
-    Matrix a(count + 1, count + 1);
-    Matrix b(count + 1, 1);
+void PanelMethods::computeSourceVortex(Airfoil &solved, const PanelGeometry &geometry, const HierarchicalInfluenceMatrices &matrices, const SolverOptions &options, SolverReport *report)
+{
+    const HierarchicalMatrix &a = matrices.system;
+    std::vector<double> x = solveSourceVortex(a, [&a](int i, int j)
+                                              { return a.entry(i, j); },
+                                              geometry, options, report);
+    setSourceVortexStrengths(solved, x.data());
+    computeSurfaceVelocity(solved, geometry, matrices);
+}
+
+Airfoil PanelMethods::computeSourceVortex(const Airfoil &airfoil, const InfluenceMatrices &matrices, const LUFactorization &factorization, double angleOfAttackDegrees)
+{
+    if (matrices.system.rowCount() != airfoil.size() + 1 || matrices.tangential.rowCount() != airfoil.size())
+        throw std::invalid_argument("The influence matrices must match the panel count");
+    if (factorization.order() != airfoil.size() + 1)
+        throw std::invalid_argument("The factorization order must be one more than the panel count");
+
+    Airfoil solved{airfoil};
+    solved.setAngleOfAttack(angleOfAttackDegrees * M_PI / 180.0);
+    computeSourceVortex(solved, PanelGeometry(solved), matrices, factorization);
+    return solved;
+}
+
+void PanelMethods::computeSourceVortex(Airfoil &solved, const PanelGeometry &geometry, const InfluenceMatrices &matrices, const LUFactorization &factorization)
+{
+    setSourceVortexStrengths(solved, factorization.solve(computeSourceVortexRightHandSide(geometry)).data());
+    computeSurfaceVelocity(solved, geometry, matrices);
+}
+
+const Airfoil &PanelMethods::computeSourceVortex(const Airfoil &airfoil, double angleOfAttackDegrees, SolverWorkspace &workspace)
+{
+    AIRFOILS_PROFILE_SCOPE("computeSourceVortex");
+    if (airfoil.empty())
+        throw std::invalid_argument("The airfoil must have at least one panel");
+
+    int count = airfoil.size();
+    // the returned airfoil of an earlier solve can be solved again at another angle
+    Airfoil &solved = workspace.solved;
+    if (&airfoil != &solved)
+        solved.assign(airfoil.begin(), airfoil.end());
+    solved.setAngleOfAttack(angleOfAttackDegrees * M_PI / 180.0);
+    PanelGeometry &geometry = workspace.geometry;
+    geometry.assign(solved);
+
+    InfluenceMatrices &matrices = workspace.matrices;
+    {
+        AIRFOILS_PROFILE_SCOPE("assembly");
+        matrices.system.resize(count + 1, count + 1);
+        matrices.tangential.resize(count, count);
+        matrices.vortexTangential.resize(count);
+        assembleSourceVortex(geometry, matrices.system, &matrices.tangential, &matrices.vortexTangential, false);
+    }
+    workspace.factorization.factor(matrices.system);
+    std::vector<double> &strengths = workspace.strengths;
+    workspace.rightHandSide.resize(count + 1);
+    strengths.resize(count + 1);
+    computeSourceVortexRightHandSide(geometry, workspace.rightHandSide.data());
+    workspace.factorization.solve(workspace.rightHandSide.data(), strengths.data());
     for (int i = 0; i < count; ++i)
     {
-        double sumK = 0.0;
-        for (int j = 0; j < count; j++)
-            if (i == j)
-                a.at(i).at(j) = M_PI;
-            else
-            {
-                a.at(i).at(j) = findIij(solved.at(i), solved.at(j));
-                sumK += findJij(solved.at(i), solved.at(j));
-            }
-        a.at(i).at(count) = -sumK;
-        b.at(i).at(0) = -2.0 * M_PI * std::cos(solved.at(i).getBetaAngle());
+        solved[i].lambda = strengths[i];
+        solved[i].gamma = strengths[count];
     }
-    double sumL = 0.0;
+
+    // the source strengths lead the solution vector, so the surface velocity is one product with J
+    AIRFOILS_PROFILE_SCOPE("pressure");
+    workspace.velocities.resize(count);
+    matrices.tangential.multiply(strengths.data(), workspace.velocities.data());
+    setSurfaceVelocity(solved, geometry, matrices.vortexTangential, workspace.velocities);
+    return solved;
+}
+
+SourceVortexBasis PanelMethods::computeSourceVortexBasis(const Airfoil &airfoil)
+{
+    AIRFOILS_PROFILE_SCOPE("computeSourceVortexBasis");
+    InfluenceMatrices matrices = computeInfluenceMatrices(PanelGeometry(airfoil));
+    return computeSourceVortexBasis(airfoil, matrices, LUFactorization(matrices.system));
+}
+
+SourceVortexBasis PanelMethods::computeSourceVortexBasis(const Airfoil &airfoil, const InfluenceMatrices &matrices, const LUFactorization &factorization)
+{
+    int count = airfoil.size();
+    if (matrices.system.rowCount() != count + 1 || matrices.tangential.rowCount() != count)
+        throw std::invalid_argument("The influence matrices must match the panel count");
+    if (factorization.order() != count + 1)
+        throw std::invalid_argument("The factorization order must be one more than the panel count");
+
+    // at zero angle of attack beta is the panel normal angle delta, and cos(delta - alpha) = cos(delta) cos(alpha) + sin(delta) sin(alpha)
+    SourceVortexBasis basis{airfoil, std::vector<double>(count), std::vector<double>(count), 0.0, 0.0, std::vector<double>(count), std::vector<double>(count)};
+    basis.airfoil.setAngleOfAttack(0.0);
+    PanelGeometry geometry(basis.airfoil);
+    const std::vector<double> &delta = geometry.getBeta();
+    Matrix b(count + 1, 2);
     for (int i = 0; i < count; ++i)
     {
-        double sum = 0.0;
-        if (i != 0)
-        {
-            sum += findJij(solved.front(), solved.at(i));
-            sumL += findLij(solved.front(), solved.at(i));
-        }
-        if (i != count - 1)
-        {
-            sum += findJij(solved.back(), solved.at(i));
-            sumL += findLij(solved.back(), solved.at(i));
-        }
-        a.at(count).at(i) = sum;
+        b(i, 0) = -2.0 * M_PI * std::cos(delta[i]);
+        b(i, 1) = -2.0 * M_PI * std::sin(delta[i]);
     }
-    a.at(count).at(count) = -sumL + 2.0 * M_PI;
-    b.at(count).front() = -2.0 * M_PI * (std::sin(solved.front().getBetaAngle()) + std::sin(solved.back().getBetaAngle()));
-    Matrix lambdasAndGamma = Matrix::lowerUpperDecomposition(a, b);
-    std::vector<double> lambdas(count);
-    std::vector<double> gammas(count);
+    b(count, 0) = -2.0 * M_PI * (std::sin(delta.front()) + std::sin(delta.back()));
+    b(count, 1) = 2.0 * M_PI * (std::cos(delta.front()) + std::cos(delta.back()));
+    Matrix x = factorization.solve(b);
     for (int i = 0; i < count; ++i)
     {
-        lambdas[i] = lambdasAndGamma.at(i).front();
-        gammas[i] = lambdasAndGamma.back().front();
+        basis.cosineLambdas[i] = x(i, 0);
+        basis.sineLambdas[i] = x(i, 1);
     }
-    solved.setLambdas(lambdas);
-    solved.setGammas(gammas);
+    basis.cosineGamma = x(count, 0);
+    basis.sineGamma = x(count, 1);
+
+    // the surface velocity is linear in the strengths and sin(beta) = sin(delta) cos(alpha) - cos(delta) sin(alpha)
+    matrices.tangential.multiply(basis.cosineLambdas.data(), basis.cosineVelocities.data());
+    matrices.tangential.multiply(basis.sineLambdas.data(), basis.sineVelocities.data());
+    const std::vector<double> &sumL = matrices.vortexTangential;
     for (int i = 0; i < count; ++i)
     {
-        double sumJ = 0.0;
-        double sumL = 0.0;
-        for (int j = 0; j < count; j++)
-        {
-            if (i != j)
-            {
-                sumJ += solved[j].lambda * findJij(solved[i], solved[j]);
-                sumL += findLij(solved[i], solved[j]);
-            }
-            double v = std::sin(solved[i].getBetaAngle()) + (1.0 / (2.0 * M_PI)) * sumJ + solved[i].gamma / 2.0 - (solved[i].gamma / (2.0 * M_PI)) * sumL;
-            double cp = findCp(v);
-            solved[i].coefficientOfPressure = cp;
-        }
+        basis.cosineVelocities[i] = std::sin(delta[i]) + (1.0 / (2.0 * M_PI)) * basis.cosineVelocities[i] + basis.cosineGamma / 2.0 - (basis.cosineGamma / (2.0 * M_PI)) * sumL[i];
+        basis.sineVelocities[i] = -std::cos(delta[i]) + (1.0 / (2.0 * M_PI)) * basis.sineVelocities[i] + basis.sineGamma / 2.0 - (basis.sineGamma / (2.0 * M_PI)) * sumL[i];
+    }
+    return basis;
+}
+
+Airfoil PanelMethods::computeSourceVortex(const SourceVortexBasis &basis, double angleOfAttackDegrees)
+{
+    int count = basis.airfoil.size();
+    double alpha = angleOfAttackDegrees * M_PI / 180.0;
+    double cosAlpha = std::cos(alpha);
+    double sinAlpha = std::sin(alpha);
+    Airfoil solved{basis.airfoil};
+    solved.setAngleOfAttack(alpha);
+    double gamma = cosAlpha * basis.cosineGamma + sinAlpha * basis.sineGamma;
+    for (int i = 0; i < count; ++i)
+    {
+        Panel &panel = solved[i];
+        panel.lambda = cosAlpha * basis.cosineLambdas[i] + sinAlpha * basis.sineLambdas[i];
+        panel.gamma = gamma;
+        panel.coefficientOfPressure = findCp(cosAlpha * basis.cosineVelocities[i] + sinAlpha * basis.sineVelocities[i]);
     }
     return solved;
 }
 
+void PanelMethods::computeCoefficients(const SourceVortexBasis &basis, double angleOfAttackDegrees, double &lift, double &drag, double &moment, double *pressures)
+{
+    // the sums of Airfoil::getCoefficientOfLift, getCoefficientOfDrag, and getCoefficientOfMoment on panels that are not copied into an airfoil
+    int count = basis.airfoil.size();
+    double alpha = angleOfAttackDegrees * M_PI / 180.0;
+    double cosAlpha = std::cos(alpha);
+    double sinAlpha = std::sin(alpha);
+    double liftNormal = 0.0, liftAxial = 0.0;
+    double dragNormal = 0.0, dragAxial = 0.0;
+    moment = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        Panel panel = basis.airfoil[i];
+        panel.alphaAngle = alpha;
+        panel.coefficientOfPressure = findCp(cosAlpha * basis.cosineVelocities[i] + sinAlpha * basis.sineVelocities[i]);
+        double normal = panel.getCoefficientOfNormalForce();
+        double axial = panel.getCoefficientOfAxialForce();
+        liftNormal += normal * cosAlpha;
+        liftAxial += axial * sinAlpha;
+        dragNormal += normal * sinAlpha;
+        dragAxial += axial * cosAlpha;
+        moment += panel.coefficientOfPressure * (panel.getMid().x - 0.25) * panel.getLength() * std::cos(panel.getPhiAngle());
+        if (pressures != nullptr)
+            pressures[i] = panel.coefficientOfPressure;
+    }
+    lift = liftNormal - liftAxial;
+    drag = dragNormal - dragAxial;
+}
+
+double PanelMethods::computeLiftSlope(const SourceVortexBasis &basis, double angleOfAttackDegrees)
+{
+    // Cl sums Cn cos(alpha) - Ca sin(alpha) with Cn = -Cp S sin(beta), Ca = -Cp S cos(beta), and beta = delta - alpha,
+    // where Cp = 1 - V^2 and V = V_x cos(alpha) + V_y sin(alpha) are differentiated exactly
+    int count = basis.airfoil.size();
+    double alpha = angleOfAttackDegrees * M_PI / 180.0;
+    double cosAlpha = std::cos(alpha);
+    double sinAlpha = std::sin(alpha);
+    double slope = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        const Panel &panel = basis.airfoil[i];
+        double velocity = cosAlpha * basis.cosineVelocities[i] + sinAlpha * basis.sineVelocities[i];
+        double velocitySlope = -sinAlpha * basis.cosineVelocities[i] + cosAlpha * basis.sineVelocities[i];
+        double cp = findCp(velocity);
+        double cpSlope = -2.0 * velocity * velocitySlope;
+        double length = panel.getLength();
+        double beta = panel.getDeltaAngle() - alpha;
+        double normal = -cp * length * std::sin(beta);
+        double axial = -cp * length * std::cos(beta);
+        double normalSlope = -cpSlope * length * std::sin(beta) + cp * length * std::cos(beta);
+        double axialSlope = -cpSlope * length * std::cos(beta) - cp * length * std::sin(beta);
+        slope += normalSlope * cosAlpha - normal * sinAlpha - axialSlope * sinAlpha - axial * cosAlpha;
+    }
+    return slope;
+}
+
+Polar PanelMethods::computePolar(const Airfoil &airfoil, const std::vector<double> &angleOfAttackDegrees, bool includePressure)
+{
+    // every right-hand side is a combination of the two basis columns, so the block solve of all angles is one two-column solve
+    return computePolar(computeSourceVortexBasis(airfoil), angleOfAttackDegrees, includePressure);
+}
+
+Polar PanelMethods::computePolar(const SourceVortexBasis &basis, const std::vector<double> &angleOfAttackDegrees, bool includePressure)
+{
+    int count = angleOfAttackDegrees.size();
+    int panelCount = includePressure ? basis.airfoil.size() : 0;
+    Polar polar{angleOfAttackDegrees, std::vector<double>(count), std::vector<double>(count), std::vector<double>(count), panelCount, std::vector<double>(static_cast<std::size_t>(count) * panelCount)};
+    ThreadPool::shared().parallelFor(0, count, polarAngleGrain, [&](int angleBegin, int angleEnd)
+                                     {
+        for (int k = angleBegin; k < angleEnd; ++k)
+            computeCoefficients(basis, angleOfAttackDegrees[k], polar.lift[k], polar.drag[k], polar.moment[k], panelCount > 0 ? polar.pressure.data() + static_cast<std::size_t>(k) * panelCount : nullptr); });
+    return polar;
+}
+
+void PanelMethods::computeVelocityField(const std::vector<Panel> &panels, const FieldGrid *grid, const double *x, const double *y, int count, double *vx, double *vy, double *cp)
+{
+    AIRFOILS_PROFILE_SCOPE("computeVelocityField");
+    if (panels.empty())
+        throw std::invalid_argument("The panels must not be empty");
+
+    PanelGeometry geometry(panels);
+    int panelCount = panels.size();
+    std::vector<double> lambdas(panelCount), gammas(panelCount);
+    for (int j = 0; j < panelCount; ++j)
+    {
+        lambdas[j] = panels[j].lambda / (2.0 * M_PI);
+        gammas[j] = panels[j].gamma / (2.0 * M_PI);
+    }
+    double freestreamX = std::cos(panels.front().alphaAngle);
+    double freestreamY = std::sin(panels.front().alphaAngle);
+    ThreadPool::shared().parallelFor(0, count, fieldPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        for (int k = pointBegin; k < pointEnd; ++k)
+        {
+            double pointX = grid != nullptr ? grid->originX + (k % grid->columns) * grid->spacingX : x[k];
+            double pointY = grid != nullptr ? grid->originY + (k / grid->columns) * grid->spacingY : y[k];
+            double sumX, sumY;
+            sumPanelVelocity(geometry, pointX, pointY, [&](int j, double &lambda, double &gamma)
+                             {
+                lambda = lambdas[j];
+                gamma = gammas[j]; }, sumX, sumY);
+            vx[k] = freestreamX + sumX;
+            vy[k] = freestreamY + sumY;
+            cp[k] = findCp(std::sqrt(vx[k] * vx[k] + vy[k] * vy[k]));
+        } });
+}
+
+void PanelMethods::computeVelocityField(const std::vector<Panel> &panels, const double *x, const double *y, int count, double *vx, double *vy, double *cp)
+{
+    computeVelocityField(panels, nullptr, x, y, count, vx, vy, cp);
+}
+
+void PanelMethods::computeVelocityField(const SourceVortexBasis &basis, const PanelGeometry &geometry, double angleOfAttackDegrees, const double *x, const double *y, int count, double *vx, double *vy, double *cp)
+{
+    AIRFOILS_PROFILE_SCOPE("computeVelocityField");
+    if (geometry.size() == 0 || geometry.size() != static_cast<int>(basis.airfoil.size()))
+        throw std::invalid_argument("The geometry must be that of the basis airfoil");
+
+    // the strengths at the angle of attack combine the basis strengths panel by panel as they are summed
+    double alpha = angleOfAttackDegrees * M_PI / 180.0;
+    double cosAlpha = std::cos(alpha);
+    double sinAlpha = std::sin(alpha);
+    double cosineScale = cosAlpha / (2.0 * M_PI);
+    double sineScale = sinAlpha / (2.0 * M_PI);
+    double gamma = cosineScale * basis.cosineGamma + sineScale * basis.sineGamma;
+    ThreadPool::shared().parallelFor(0, count, fieldPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        for (int k = pointBegin; k < pointEnd; ++k)
+        {
+            double sumX, sumY;
+            sumPanelVelocity(geometry, x[k], y[k], [&](int j, double &lambdaJ, double &gammaJ)
+                             {
+                lambdaJ = cosineScale * basis.cosineLambdas[j] + sineScale * basis.sineLambdas[j];
+                gammaJ = gamma; }, sumX, sumY);
+            vx[k] = cosAlpha + sumX;
+            vy[k] = sinAlpha + sumY;
+            cp[k] = findCp(std::sqrt(vx[k] * vx[k] + vy[k] * vy[k]));
+        } });
+}
+
+VelocityField PanelMethods::computeVelocityField(const std::vector<Panel> &panels, const FieldGrid &grid)
+{
+    if (grid.columns < 0 || grid.rows < 0)
+        throw std::invalid_argument("The grid dimensions must not be negative");
+
+    int count = grid.columns * grid.rows;
+    VelocityField field{std::vector<double>(count), std::vector<double>(count), std::vector<double>(count)};
+    computeVelocityField(panels, &grid, nullptr, nullptr, count, field.vx.data(), field.vy.data(), field.cp.data());
+    return field;
+}
+
+void PanelMethods::computeVelocityField(const std::vector<Panel> &panels, const double *x, const double *y, int count, double *vx, double *vy, double *cp, const TreecodeOptions &options)
+{
+    AIRFOILS_PROFILE_SCOPE("computeVelocityField");
+    PanelTreecode(panels, options).computeVelocityField(x, y, count, vx, vy, cp);
+}
+
+VelocityField PanelMethods::computeVelocityField(const std::vector<Panel> &panels, const FieldGrid &grid, const TreecodeOptions &options)
+{
+    if (grid.columns < 0 || grid.rows < 0)
+        throw std::invalid_argument("The grid dimensions must not be negative");
+
+    int count = grid.columns * grid.rows;
+    std::vector<double> x(count), y(count);
+    for (int k = 0; k < count; ++k)
+    {
+        x[k] = grid.originX + (k % grid.columns) * grid.spacingX;
+        y[k] = grid.originY + (k / grid.columns) * grid.spacingY;
+    }
+    VelocityField field{std::vector<double>(count), std::vector<double>(count), std::vector<double>(count)};
+    computeVelocityField(panels, x.data(), y.data(), count, field.vx.data(), field.vy.data(), field.cp.data(), options);
+    return field;
+}
+
 Vector PanelMethods::computeStreamline(const std::vector<Panel> &panels, const Point &point)
 {
-    double lambdaMxSum = 0.0;
-    double gammaNxSum = 0.0;
-    double lambdaMySum = 0.0;
-    double gammaNySum = 0.0;
-    for (int i = 0; i < panels.size(); ++i)
-    {
-        lambdaMxSum += panels.at(i).lambda * findMx(panels.at(i), point) / (2.0 * M_PI);
-        gammaNxSum += -panels.at(i).gamma * findNx(panels.at(i), point) / (2.0 * M_PI);
-        lambdaMySum += panels.at(i).lambda * findMy(panels.at(i), point) / (2.0 * M_PI);
-        gammaNySum += -panels.at(i).gamma * findNy(panels.at(i), point) / (2.0 * M_PI);
-    }
-    double vx = std::cos(panels.front().alphaAngle) + lambdaMxSum + gammaNxSum;
-    double vy = std::sin(panels.front().alphaAngle) + lambdaMySum + gammaNySum;
-    Vector v{Point::zero(), Point{vx, vy, 0.0}};
-    double magnitude = v.getMagnitude();
-    double cp = 1 - magnitude * magnitude;
-    return Vector{Point::zero(), Point{vx, vy, cp}};
+    AIRFOILS_PROFILE_SCOPE("computeStreamline");
+    if (panels.empty())
+        throw std::invalid_argument("The panels must not be empty");
+
+    // the vortex integrals are Nx = -My and Ny = Mx
+    double sumX = 0.0;
+    double sumY = 0.0;
+    for (const Panel &panel : panels)
+    {
+        double mx, my;
+        GeometricIntegrals::computePointIntegrals(panel, point.x, point.y, mx, my);
+        double lambda = panel.lambda / (2.0 * M_PI);
+        double gamma = panel.gamma / (2.0 * M_PI);
+        sumX += lambda * mx + gamma * my;
+        sumY += lambda * my - gamma * mx;
+    }
+    double vx = std::cos(panels.front().alphaAngle) + sumX;
+    double vy = std::sin(panels.front().alphaAngle) + sumY;
+    return Vector{Point::zero(), Point{vx, vy, findCp(std::sqrt(vx * vx + vy * vy))}};
 }
\ No newline at end of file
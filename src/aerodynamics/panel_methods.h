@@ -1,10 +1,27 @@
 #ifndef AIRFOILS_AERODYNAMICS_PANELMETHODS_H_
 #define AIRFOILS_AERODYNAMICS_PANELMETHODS_H_
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "airfoil.h"
+#include "gmres.h"
+#include "hierarchical_matrix.h"
+#include "influence_matrices.h"
+#include "linear_operator.h"
+#include "lu_factorization.h"
+#include "matrix.h"
+#include "panel_geometry.h"
+#include "panel_treecode.h"
+#include "polar.h"
+#include "solution_cache.h"
+#include "solver_options.h"
+#include "solver_workspace.h"
+#include "source_vortex_basis.h"
+#include "source_vortex_operator.h"
 #include "vector.h"
+#include "velocity_field.h"
 #include "point.h"
 
 namespace aerodynamics
@@ -13,22 +30,27 @@ namespace aerodynamics
     class PanelMethods
     {
     private:
-        static double findA(const geometry::Point &point1, const geometry::Point &point2, double phi);
-        static double findB(const geometry::Point &point1, const geometry::Point &point2);
-        static double findC(double angle1, double angle2, bool reverse);
-        static double findD(const geometry::Point &point1, const geometry::Point &point2, double phi, bool reverse);
-        static double findE(double a, double b);
-        static double findGeometricIntegral(double a, double b, double c, double d, double e, double s);
-        static double findIij(const aerodynamics::Panel &i, const aerodynamics::Panel &j);
-        static double findJij(const aerodynamics::Panel &i, const aerodynamics::Panel &j);
-        static double findLij(const aerodynamics::Panel &i, const aerodynamics::Panel &j);
-        static double findMx(const aerodynamics::Panel &panel, const geometry::Point &point);
-        static double findNx(const aerodynamics::Panel &panel, const geometry::Point &point);
-        static double findMy(const aerodynamics::Panel &panel, const geometry::Point &point);
-        static double findNy(const aerodynamics::Panel &panel, const geometry::Point &point);
         static double findCp(double velocity);
+        static void assembleSourceVortex(const aerodynamics::PanelGeometry &geometry, linear_algebra::Matrix &a, linear_algebra::Matrix *tangential, std::vector<double> *vortexTangential, bool parallel = true);
+        static linear_algebra::Matrix computeSourceVortexRightHandSide(const aerodynamics::PanelGeometry &geometry);
+        static void computeSourceVortexRightHandSide(const aerodynamics::PanelGeometry &geometry, double *b);
+        static void computeVelocityField(const std::vector<aerodynamics::Panel> &panels, const aerodynamics::FieldGrid *grid, const double *x, const double *y, int count, double *vx, double *vy, double *cp);
+        static std::vector<double> solveSourceVortex(const linear_algebra::LinearOperator &a, const std::function<double(int, int)> &entry, const aerodynamics::PanelGeometry &geometry, const aerodynamics::SolverOptions &options, linear_algebra::SolverReport *report);
+        static void setSourceVortexStrengths(aerodynamics::Airfoil &solved, const double *lambdasAndGamma);
+        static void setSurfaceVelocity(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const std::vector<double> &vortexTangential, std::vector<double> &velocities);
+        static void computeSourceVortex(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const aerodynamics::InfluenceMatrices &matrices, const linear_algebra::LUFactorization &factorization);
+        static void computeSourceVortex(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const aerodynamics::HierarchicalInfluenceMatrices &matrices, const aerodynamics::SolverOptions &options, linear_algebra::SolverReport *report);
+        static aerodynamics::Airfoil computeSourceVortexUncached(const aerodynamics::Airfoil &airfoil, double angleOfAttackDegrees, const aerodynamics::SolverOptions &options, linear_algebra::SolverReport *report);
 
     public:
+        /// @brief sets the cache computeSourceVortex consults before solving and fills after solving
+        /// @param cache the shared cache, null disables caching
+        static void setSolutionCache(std::shared_ptr<aerodynamics::SolutionCache> cache);
+
+        /// @brief gets the cache computeSourceVortex consults
+        /// @return the shared cache, null when caching is disabled
+        static std::shared_ptr<aerodynamics::SolutionCache> getSolutionCache();
+
         /// @brief uses a combination of source and vortex flows to solve for the flow around the airfoil
         /// @tparam count panel count
         /// @param airfoil airfoil geometry to solve for
@@ -36,6 +58,173 @@ namespace aerodynamics
         /// @return an airfoil with source strengths, vortex strengths, and pressure coefficients set
         static aerodynamics::Airfoil computeSourceVortex(const aerodynamics::Airfoil &airfoil, double angleOfAttackDegrees);
 
+        /// @brief uses a combination of source and vortex flows to solve for the flow around the airfoil with the chosen linear solver
+        /// @param airfoil airfoil geometry to solve for
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @param options linear solver settings
+        /// @param report receives the iteration count and residual of an iterative solve when not null, the stored ones on a cache hit
+        /// @return an airfoil with source strengths, vortex strengths, and pressure coefficients set
+        static aerodynamics::Airfoil computeSourceVortex(const aerodynamics::Airfoil &airfoil, double angleOfAttackDegrees, const aerodynamics::SolverOptions &options, linear_algebra::SolverReport *report = nullptr);
+
+        /// @brief assembles the source-vortex influence matrix, which only depends on the airfoil geometry and not the angle of attack
+        /// @param airfoil airfoil geometry to solve for
+        /// @return the (count + 1)x(count + 1) influence matrix
+        static linear_algebra::Matrix computeSourceVortexMatrix(const aerodynamics::Airfoil &airfoil);
+
+        /// @brief assembles the source-vortex influence matrix from precomputed panel geometry
+        /// @param geometry panel geometry of the airfoil
+        /// @return the (count + 1)x(count + 1) influence matrix
+        static linear_algebra::Matrix computeSourceVortexMatrix(const aerodynamics::PanelGeometry &geometry);
+
+        /// @brief assembles the source-vortex system matrix and the tangential integrals in one pass over the panel pairs
+        /// @param geometry panel geometry of the airfoil
+        /// @return the influence matrices, reused by the pressure stage of every angle of attack
+        static aerodynamics::InfluenceMatrices computeInfluenceMatrices(const aerodynamics::PanelGeometry &geometry);
+
+        /// @brief compresses the source-vortex system matrix and the tangential integrals into hierarchical matrices
+        /// @param geometry panel geometry of the airfoil
+        /// @param options compression settings
+        /// @return the compressed influence matrices, reused by every angle of attack
+        static aerodynamics::HierarchicalInfluenceMatrices computeHierarchicalInfluenceMatrices(const aerodynamics::PanelGeometry &geometry, const linear_algebra::HierarchicalOptions &options = linear_algebra::HierarchicalOptions());
+
+        /// @brief solves the source-vortex flow with GMRES on compressed influence matrices so repeated angles skip the compression
+        /// @param airfoil airfoil geometry to solve for
+        /// @param matrices compressed influence matrices of the same airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @param options iterative solver settings, the method is ignored
+        /// @param report receives the iteration count and residual when not null
+        /// @return an airfoil with source strengths, vortex strengths, and pressure coefficients set
+        static aerodynamics::Airfoil computeSourceVortex(const aerodynamics::Airfoil &airfoil, const aerodynamics::HierarchicalInfluenceMatrices &matrices, double angleOfAttackDegrees, const aerodynamics::SolverOptions &options, linear_algebra::SolverReport *report = nullptr);
+
+        /// @brief solves the source-vortex flow with a factorization of the system matrix so repeated angles skip the assembly and factoring
+        /// @param airfoil airfoil geometry to solve for
+        /// @param matrices influence matrices of the same airfoil
+        /// @param factorization factored system matrix of the same airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @return an airfoil with source strengths, vortex strengths, and pressure coefficients set
+        static aerodynamics::Airfoil computeSourceVortex(const aerodynamics::Airfoil &airfoil, const aerodynamics::InfluenceMatrices &matrices, const linear_algebra::LUFactorization &factorization, double angleOfAttackDegrees);
+
+        /// @brief solves the source-vortex flow on the calling thread inside the buffers of a workspace, which allocates nothing once the workspace holds the panel count, for optimizers that solve many airfoils
+        /// @param airfoil airfoil geometry to solve for, which may be the solved airfoil of the workspace
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @param workspace scratch buffers reused by every solve, one per thread
+        /// @return the solved airfoil of the workspace, valid until its next solve
+        static const aerodynamics::Airfoil &computeSourceVortex(const aerodynamics::Airfoil &airfoil, double angleOfAttackDegrees, aerodynamics::SolverWorkspace &workspace);
+
+        /// @brief solves the source-vortex flow for unit freestreams along x and y, which combine into the solution at any angle of attack
+        /// @param airfoil airfoil geometry to solve for
+        /// @return the two basis solutions
+        static aerodynamics::SourceVortexBasis computeSourceVortexBasis(const aerodynamics::Airfoil &airfoil);
+
+        /// @brief solves the source-vortex basis with a factorization of the system matrix of the same airfoil
+        /// @param airfoil airfoil geometry to solve for
+        /// @param matrices influence matrices of the same airfoil
+        /// @param factorization factored system matrix of the same airfoil
+        /// @return the two basis solutions
+        static aerodynamics::SourceVortexBasis computeSourceVortexBasis(const aerodynamics::Airfoil &airfoil, const aerodynamics::InfluenceMatrices &matrices, const linear_algebra::LUFactorization &factorization);
+
+        /// @brief combines the basis solutions at an angle of attack in O(count) without solving
+        /// @param basis basis solutions of the airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @return an airfoil with source strengths, vortex strengths, and pressure coefficients set
+        static aerodynamics::Airfoil computeSourceVortex(const aerodynamics::SourceVortexBasis &basis, double angleOfAttackDegrees);
+
+        /// @brief combines the basis solutions at an angle of attack into the force and moment coefficients without allocating
+        /// @param basis basis solutions of the airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @param lift receives the lift coefficient
+        /// @param drag receives the drag coefficient
+        /// @param moment receives the moment coefficient about the quarter chord
+        /// @param pressures receives the pressure coefficient of each panel, or nullptr
+        static void computeCoefficients(const aerodynamics::SourceVortexBasis &basis, double angleOfAttackDegrees, double &lift, double &drag, double &moment, double *pressures = nullptr);
+
+        /// @brief differentiates the lift coefficient of the combined solution with respect to the angle of attack
+        /// @param basis basis solutions of the airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @return dCl/dalpha per radian
+        static double computeLiftSlope(const aerodynamics::SourceVortexBasis &basis, double angleOfAttackDegrees);
+
+        /// @brief solves the airfoil at many angles of attack from one assembly and factorization, with the angles integrated in parallel on the shared thread pool
+        /// @param airfoil airfoil geometry to solve for
+        /// @param angleOfAttackDegrees angles of attack in degrees
+        /// @param includePressure indicates if the pressure coefficients of every angle are kept
+        /// @return the polar in the order of the angles
+        static aerodynamics::Polar computePolar(const aerodynamics::Airfoil &airfoil, const std::vector<double> &angleOfAttackDegrees, bool includePressure = false);
+
+        /// @brief combines the basis solutions at many angles of attack in parallel on the shared thread pool
+        /// @param basis basis solutions of the airfoil
+        /// @param angleOfAttackDegrees angles of attack in degrees
+        /// @param includePressure indicates if the pressure coefficients of every angle are kept
+        /// @return the polar in the order of the angles
+        static aerodynamics::Polar computePolar(const aerodynamics::SourceVortexBasis &basis, const std::vector<double> &angleOfAttackDegrees, bool includePressure = false);
+
+        /// @brief computes the surface tangential velocities of a solved airfoil and sets its pressure coefficients from them
+        /// @param solved airfoil with source and vortex strengths set
+        /// @param geometry panel geometry of the solved airfoil
+        /// @param matrices influence matrices of the same airfoil
+        /// @return the tangential velocity at each panel control point relative to the freestream
+        static std::vector<double> computeSurfaceVelocity(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const aerodynamics::InfluenceMatrices &matrices);
+
+        /// @brief computes the surface tangential velocities of a solved airfoil with compressed influence matrices and sets its pressure coefficients from them
+        /// @param solved airfoil with source and vortex strengths set
+        /// @param geometry panel geometry of the solved airfoil
+        /// @param matrices compressed influence matrices of the same airfoil
+        /// @return the tangential velocity at each panel control point relative to the freestream
+        static std::vector<double> computeSurfaceVelocity(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const aerodynamics::HierarchicalInfluenceMatrices &matrices);
+
+        /// @brief computes the surface tangential velocities of a solved airfoil with the matrix-free operator and sets its pressure coefficients from them
+        /// @param solved airfoil with source and vortex strengths set
+        /// @param geometry panel geometry of the solved airfoil
+        /// @param sourceVortex matrix-free operator of the same airfoil
+        /// @return the tangential velocity at each panel control point relative to the freestream
+        static std::vector<double> computeSurfaceVelocity(aerodynamics::Airfoil &solved, const aerodynamics::PanelGeometry &geometry, const aerodynamics::SourceVortexOperator &sourceVortex);
+
+        /// @brief computes the velocity and pressure at many field points, split across the shared thread pool
+        /// @param panels solved panels
+        /// @param x x of each point
+        /// @param y y of each point
+        /// @param count point count
+        /// @param vx receives the x velocity of each point
+        /// @param vy receives the y velocity of each point
+        /// @param cp receives the pressure coefficient of each point
+        static void computeVelocityField(const std::vector<aerodynamics::Panel> &panels, const double *x, const double *y, int count, double *vx, double *vy, double *cp);
+
+        /// @brief computes the velocity and pressure at many field points from the basis solutions at an angle of attack, split across the shared thread pool without allocating
+        /// @param basis basis solutions of the airfoil
+        /// @param geometry geometry of the basis airfoil
+        /// @param angleOfAttackDegrees angle of attack of the airfoil in degrees
+        /// @param x x of each point
+        /// @param y y of each point
+        /// @param count point count
+        /// @param vx receives the x velocity of each point
+        /// @param vy receives the y velocity of each point
+        /// @param cp receives the pressure coefficient of each point
+        static void computeVelocityField(const aerodynamics::SourceVortexBasis &basis, const aerodynamics::PanelGeometry &geometry, double angleOfAttackDegrees, const double *x, const double *y, int count, double *vx, double *vy, double *cp);
+
+        /// @brief computes the velocity and pressure at every point of a regular grid, split across the shared thread pool
+        /// @param panels solved panels
+        /// @param grid grid of field points
+        /// @return the field of the grid points in row by row order
+        static aerodynamics::VelocityField computeVelocityField(const std::vector<aerodynamics::Panel> &panels, const aerodynamics::FieldGrid &grid);
+
+        /// @brief computes the velocity and pressure at many field points with the panel treecode, which expands distant panel clusters
+        /// @param panels solved panels
+        /// @param x x of each point
+        /// @param y y of each point
+        /// @param count point count
+        /// @param vx receives the x velocity of each point
+        /// @param vy receives the y velocity of each point
+        /// @param cp receives the pressure coefficient of each point
+        /// @param options treecode accuracy settings
+        static void computeVelocityField(const std::vector<aerodynamics::Panel> &panels, const double *x, const double *y, int count, double *vx, double *vy, double *cp, const aerodynamics::TreecodeOptions &options);
+
+        /// @brief computes the velocity and pressure at every point of a regular grid with the panel treecode
+        /// @param panels solved panels
+        /// @param grid grid of field points
+        /// @param options treecode accuracy settings
+        /// @return the field of the grid points in row by row order
+        static aerodynamics::VelocityField computeVelocityField(const std::vector<aerodynamics::Panel> &panels, const aerodynamics::FieldGrid &grid, const aerodynamics::TreecodeOptions &options);
+
         /// @brief computes the freestream gradient at a point determined by the airfoil body
         /// @tparam count panel count
         /// @param airfoil solved airfoil geometry
@@ -45,4 +234,4 @@ namespace aerodynamics
     };
 } // namespace aerodynamics
 
-#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "panel_treecode.h"
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "geometric_integrals.h"
+#include "panel.h"
+#include "panel_geometry.h"
+#include "point.h"
+#include "segment_tree.h"
+#include "thread_pool.h"
+
+using aerodynamics::PanelTreecode;
+
+using aerodynamics::Panel;
+using aerodynamics::SegmentTree;
+using aerodynamics::TreecodeOptions;
+using concurrency::ThreadPool;
+using geometry::Point;
+
+namespace
+{
+    // Field points per parallel chunk
+    const int fieldPointGrain = 64;
+} // namespace
+
+PanelTreecode::PanelTreecode(const std::vector<Panel> &panels, const TreecodeOptions &options)
+    : mTree(buildTree(panels, options)), mGeometry(mTree.sortItems(panels))
+{
+    const std::vector<int> &order = mTree.getOrder();
+    int count = mGeometry.size();
+    mStrengths.resize(count);
+    for (int j = 0; j < count; ++j)
+    {
+        const Panel &panel = panels[order[j]];
+        mStrengths[j] = std::complex<double>(panel.lambda, panel.gamma) / (2.0 * M_PI);
+    }
+    // u - iv of the freestream
+    mFreestream = std::polar(1.0, -panels.front().alphaAngle);
+    mMoments.resize(static_cast<std::size_t>(mTree.nodeCount()) * mTree.termCount());
+    mTree.computeMoments(mStrengths.data(), mMoments.data());
+}
+
+SegmentTree PanelTreecode::buildTree(const std::vector<Panel> &panels, const TreecodeOptions &options)
+{
+    if (panels.empty())
+        throw std::invalid_argument("The panels must not be empty");
+
+    int count = panels.size();
+    std::vector<std::complex<double>> starts(count), ends(count);
+    for (int j = 0; j < count; ++j)
+    {
+        // the field integrals run along each panel from its midpoint
+        Point start = panels[j].getStart();
+        Point end = panels[j].getEnd();
+        Point mid = panels[j].getMid();
+        starts[j] = std::complex<double>(mid.x, mid.y);
+        ends[j] = starts[j] + std::complex<double>(end.x - start.x, end.y - start.y);
+    }
+    return SegmentTree(starts, ends, options);
+}
+
+std::complex<double> PanelTreecode::evaluate(std::complex<double> z, std::vector<double> &mx, std::vector<double> &my, std::vector<int> &far, std::vector<int> &near, std::vector<int> &stack) const
+{
+    mTree.findInteractions(z, far, near, stack);
+    std::complex<double> sum = 0.0;
+    for (int index : far)
+        sum += mTree.evaluateExpansion(index, mMoments.data(), z);
+    for (int index : near)
+    {
+        // Near leaf: exact integrals, where Mx - i My is the integral of 1 / (z - z(s))
+        const SegmentTree::Node &node = mTree.getNodes()[index];
+        GeometricIntegrals::computePointIntegrals(mGeometry, z.real(), z.imag(), node.begin, node.end, mx.data(), my.data());
+        for (int j = node.begin; j < node.end; j++)
+            sum += mStrengths[j] * std::complex<double>(mx[j - node.begin], -my[j - node.begin]);
+    }
+    return sum;
+}
+
+void PanelTreecode::computeVelocityField(const double *x, const double *y, int count, double *vx, double *vy, double *cp) const
+{
+    ThreadPool::shared().parallelFor(0, count, fieldPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        std::vector<double> mx(mGeometry.size()), my(mGeometry.size());
+        std::vector<int> far, near, stack;
+        for (int k = pointBegin; k < pointEnd; ++k)
+        {
+            // the complex velocity u - iv
+            std::complex<double> velocity = mFreestream + evaluate(std::complex<double>(x[k], y[k]), mx, my, far, near, stack);
+            vx[k] = velocity.real();
+            vy[k] = -velocity.imag();
+            cp[k] = 1 - std::norm(velocity);
+        } });
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef AIRFOILS_AERODYNAMICS_PANELTREECODE_H_
+#define AIRFOILS_AERODYNAMICS_PANELTREECODE_H_
+
+#include <complex>
+#include <vector>
+
+#include "panel.h"
+#include "panel_geometry.h"
+#include "segment_tree.h"
+
+namespace aerodynamics
+{
+    /// @brief a quadtree of solved panels whose clusters are replaced by complex multipole expansions at distant points, so a field of M points costs O(M log N) instead of O(M N)
+    class PanelTreecode
+    {
+    private:
+        aerodynamics::SegmentTree mTree;
+        aerodynamics::PanelGeometry mGeometry;
+        std::vector<std::complex<double>> mStrengths, mMoments;
+        std::complex<double> mFreestream;
+
+        static aerodynamics::SegmentTree buildTree(const std::vector<aerodynamics::Panel> &panels, const TreecodeOptions &options);
+        std::complex<double> evaluate(std::complex<double> z, std::vector<double> &mx, std::vector<double> &my, std::vector<int> &far, std::vector<int> &near, std::vector<int> &stack) const;
+
+    public:
+        /// @brief sorts the panels into clusters and computes the expansion of every cluster
+        /// @param panels solved panels with source and vortex strengths set
+        /// @param options accuracy settings
+        PanelTreecode(const std::vector<aerodynamics::Panel> &panels, const TreecodeOptions &options = TreecodeOptions());
+
+        /// @brief gets the cluster count
+        /// @return node count of the quadtree
+        inline int nodeCount() const { return mTree.nodeCount(); };
+
+        /// @brief computes the velocity and pressure at many field points, split across the shared thread pool
+        /// @param x x of each point
+        /// @param y y of each point
+        /// @param count point count
+        /// @param vx receives the x velocity of each point
+        /// @param vy receives the y velocity of each point
+        /// @param cp receives the pressure coefficient of each point
+        void computeVelocityField(const double *x, const double *y, int count, double *vx, double *vy, double *cp) const;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
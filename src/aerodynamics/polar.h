@@ -0,0 +1,31 @@
+#ifndef AIRFOILS_AERODYNAMICS_POLAR_H_
+#define AIRFOILS_AERODYNAMICS_POLAR_H_
+
+#include <vector>
+
+namespace aerodynamics
+{
+    /// @brief the force and moment coefficients of an airfoil over a set of angles of attack in structure-of-arrays layout, one entry per angle
+    struct Polar
+    {
+        /// @brief angle of attack in degrees
+        std::vector<double> angles;
+
+        /// @brief lift coefficient
+        std::vector<double> lift;
+
+        /// @brief drag coefficient
+        std::vector<double> drag;
+
+        /// @brief moment coefficient
+        std::vector<double> moment;
+
+        /// @brief number of pressure coefficients stored for each angle, the panel count or 0 when they were not requested
+        int panelCount = 0;
+
+        /// @brief pressure coefficient of panel i at angle k at index k panelCount + i
+        std::vector<double> pressure;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "segment_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using aerodynamics::SegmentTree;
+
+using aerodynamics::TreecodeOptions;
+
+namespace
+{
+    // Quadtree levels below which coincident segments stay in one leaf
+    const int maxDepth = 48;
+} // namespace
+
+SegmentTree::SegmentTree(const std::vector<std::complex<double>> &starts, const std::vector<std::complex<double>> &ends, const TreecodeOptions &options)
+    : mOptions(options)
+{
+    if (starts.empty())
+        throw std::invalid_argument("The segments must not be empty");
+    if (starts.size() != ends.size())
+        throw std::invalid_argument("The segment starts and ends must have the same size");
+    if (!(options.theta > 0 && options.theta < 1))
+        throw std::invalid_argument("The opening angle must be between 0 and 1");
+    if (options.order < 0)
+        throw std::invalid_argument("The expansion order must not be negative");
+    if (options.leafSize < 1)
+        throw std::invalid_argument("The leaf size must be at least one");
+
+    int count = starts.size();
+    std::vector<std::complex<double>> centers(count);
+    for (int j = 0; j < count; ++j)
+        centers[j] = 0.5 * (starts[j] + ends[j]);
+    mOrder.resize(count);
+    std::iota(mOrder.begin(), mOrder.end(), 0);
+    mNodes.assign(1, Node{0.0, 0.0, 0, count, 0, 0});
+    split(0, centers, options.leafSize, 0, mOrder, mNodes);
+
+    mStarts.resize(count);
+    mEnds.resize(count);
+    for (int j = 0; j < count; ++j)
+    {
+        mStarts[j] = starts[mOrder[j]];
+        mEnds[j] = ends[mOrder[j]];
+    }
+    for (Node &node : mNodes)
+    {
+        std::complex<double> center = 0.0;
+        for (int j = node.begin; j < node.end; j++)
+            center += 0.5 * (mStarts[j] + mEnds[j]);
+        node.center = center / static_cast<double>(node.end - node.begin);
+        node.radius = 0.0;
+        for (int j = node.begin; j < node.end; j++)
+            node.radius = std::max(node.radius, std::sqrt(std::max(std::norm(mStarts[j] - node.center), std::norm(mEnds[j] - node.center))));
+    }
+}
+
+void SegmentTree::split(int node, const std::vector<std::complex<double>> &centers, int leafSize, int depth, std::vector<int> &order, std::vector<Node> &nodes)
+{
+    int begin = nodes[node].begin;
+    int end = nodes[node].end;
+    if (end - begin <= leafSize || depth >= maxDepth)
+        return;
+
+    double minX = centers[order[begin]].real(), maxX = minX;
+    double minY = centers[order[begin]].imag(), maxY = minY;
+    for (int j = begin + 1; j < end; ++j)
+    {
+        minX = std::min(minX, centers[order[j]].real());
+        maxX = std::max(maxX, centers[order[j]].real());
+        minY = std::min(minY, centers[order[j]].imag());
+        maxY = std::max(maxY, centers[order[j]].imag());
+    }
+    if (minX == maxX && minY == maxY)
+        return;
+
+    // Quadrants of the bounding box, split by y and then each half by x
+    double splitX = 0.5 * (minX + maxX);
+    double splitY = 0.5 * (minY + maxY);
+    auto first = order.begin() + begin;
+    auto last = order.begin() + end;
+    auto middle = std::partition(first, last, [&centers, splitY](int j)
+                                 { return centers[j].imag() < splitY; });
+    auto lowerMiddle = std::partition(first, middle, [&centers, splitX](int j)
+                                      { return centers[j].real() < splitX; });
+    auto upperMiddle = std::partition(middle, last, [&centers, splitX](int j)
+                                      { return centers[j].real() < splitX; });
+    int bounds[] = {begin, static_cast<int>(lowerMiddle - order.begin()), static_cast<int>(middle - order.begin()), static_cast<int>(upperMiddle - order.begin()), end};
+
+    int firstChild = nodes.size();
+    for (int q = 0; q < 4; ++q)
+        if (bounds[q] < bounds[q + 1])
+            nodes.push_back(Node{0.0, 0.0, bounds[q], bounds[q + 1], 0, 0});
+    int childCount = nodes.size() - firstChild;
+    nodes[node].firstChild = firstChild;
+    nodes[node].childCount = childCount;
+    for (int c = 0; c < childCount; ++c)
+        split(firstChild + c, centers, leafSize, depth + 1, order, nodes);
+}
+
+void SegmentTree::computeMoments(const std::complex<double> *strengths, std::complex<double> *moments) const
+{
+    // A segment from z0 to z1 contributes a_k = integral of (z(s) - c)^k ds = S / (k + 1) sum over m of (z1 - c)^m (z0 - c)^(k - m)
+    // to moment k about the cluster center c, which avoids the cancellation of ((z1 - c)^(k + 1) - (z0 - c)^(k + 1)) / (k + 1) t
+    int terms = termCount();
+    std::fill(moments, moments + mNodes.size() * terms, std::complex<double>(0.0));
+    for (int n = 0; n < mNodes.size(); ++n)
+    {
+        const Node &node = mNodes[n];
+        std::complex<double> *nodeMoments = moments + static_cast<std::size_t>(n) * terms;
+        for (int j = node.begin; j < node.end; j++)
+        {
+            std::complex<double> x = mEnds[j] - node.center;
+            std::complex<double> y = mStarts[j] - node.center;
+            double length = std::abs(mEnds[j] - mStarts[j]);
+            std::complex<double> sum = 1.0;
+            std::complex<double> yPower = 1.0;
+            for (int k = 0; k < terms; k++)
+            {
+                if (k > 0)
+                {
+                    yPower *= y;
+                    sum = x * sum + yPower;
+                }
+                nodeMoments[k] += strengths[j] * (length / (k + 1)) * sum;
+            }
+        }
+    }
+}
+
+std::complex<double> SegmentTree::evaluateExpansion(int node, const std::complex<double> *moments, std::complex<double> z) const
+{
+    // Horner's rule in w = 1 / (z - c)
+    int order = mOptions.order;
+    std::complex<double> w = 1.0 / (z - mNodes[node].center);
+    const std::complex<double> *nodeMoments = moments + static_cast<std::size_t>(node) * (order + 1);
+    std::complex<double> series = nodeMoments[order];
+    for (int k = order - 1; k >= 0; k--)
+        series = series * w + nodeMoments[k];
+    return series * w;
+}
+
+void SegmentTree::findInteractions(std::complex<double> z, std::vector<int> &far, std::vector<int> &near, std::vector<int> &stack) const
+{
+    double thetaSquared = mOptions.theta * mOptions.theta;
+    far.clear();
+    near.clear();
+    stack.assign(1, 0);
+    while (!stack.empty())
+    {
+        int index = stack.back();
+        stack.pop_back();
+        const Node &node = mNodes[index];
+        if (node.radius * node.radius < thetaSquared * std::norm(z - node.center))
+            far.push_back(index);
+        else if (node.childCount == 0)
+            near.push_back(index);
+        else
+            for (int c = node.childCount - 1; c >= 0; c--)
+                stack.push_back(node.firstChild + c);
+    }
+}
\ No newline at end of file
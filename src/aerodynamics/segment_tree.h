@@ -0,0 +1,100 @@
+#ifndef AIRFOILS_AERODYNAMICS_SEGMENTTREE_H_
+#define AIRFOILS_AERODYNAMICS_SEGMENTTREE_H_
+
+#include <complex>
+#include <vector>
+
+namespace aerodynamics
+{
+    /// @brief accuracy settings of the panel treecode
+    struct TreecodeOptions
+    {
+        /// @brief opening angle, a cluster of radius R is replaced by its expansion at points farther than R / theta, in (0, 1)
+        double theta = 0.5;
+
+        /// @brief expansion order p, the truncation error of a cluster is below theta^(p + 1) / (1 - theta) times its total strength
+        int order = 20;
+
+        /// @brief maximum panels of a leaf cluster, which is evaluated directly when it is near
+        int leafSize = 32;
+    };
+
+    /// @brief a quadtree of straight segments whose clusters sum strength times the integral of ds / (z - z(s)) as a complex multipole expansion at distant points
+    class SegmentTree
+    {
+    public:
+        /// @brief a cluster of the segments [begin, end) in sorted order
+        struct Node
+        {
+            std::complex<double> center;
+            double radius;
+            int begin, end, firstChild, childCount;
+        };
+
+    private:
+        TreecodeOptions mOptions;
+        std::vector<Node> mNodes;
+        std::vector<int> mOrder;
+        std::vector<std::complex<double>> mStarts, mEnds;
+
+        static void split(int node, const std::vector<std::complex<double>> &centers, int leafSize, int depth, std::vector<int> &order, std::vector<Node> &nodes);
+
+    public:
+        /// @brief sorts the segments into clusters
+        /// @param starts start of each segment
+        /// @param ends end of each segment
+        /// @param options accuracy settings
+        SegmentTree(const std::vector<std::complex<double>> &starts, const std::vector<std::complex<double>> &ends, const TreecodeOptions &options = TreecodeOptions());
+
+        /// @brief gets the cluster count
+        /// @return node count of the quadtree
+        inline int nodeCount() const { return mNodes.size(); };
+
+        /// @brief gets the expansion terms of each cluster
+        /// @return order + 1
+        inline int termCount() const { return mOptions.order + 1; };
+
+        /// @brief gets the clusters, the root first
+        /// @return nodes of the quadtree
+        inline const std::vector<Node> &getNodes() const { return mNodes; };
+
+        /// @brief gets the sorted segment order, every cluster is a contiguous range of it
+        /// @return the original index of each sorted segment
+        inline const std::vector<int> &getOrder() const { return mOrder; };
+
+        /// @brief sorts per-segment items, such as the panels the segments came from, into the segment order
+        /// @tparam Item item type
+        /// @param items item of each segment in its original order
+        /// @return the items in sorted order
+        template <typename Item>
+        std::vector<Item> sortItems(const std::vector<Item> &items) const
+        {
+            std::vector<Item> sorted;
+            sorted.reserve(mOrder.size());
+            for (int j : mOrder)
+                sorted.push_back(items[j]);
+            return sorted;
+        }
+
+        /// @brief computes the moments A_k, the integral of strength times (z(s) - c)^k ds, of every cluster
+        /// @param strengths strength of each segment in sorted order
+        /// @param moments receives termCount() moments of each node
+        void computeMoments(const std::complex<double> *strengths, std::complex<double> *moments) const;
+
+        /// @brief sums the expansion of a cluster, A_k / (z - c)^(k + 1) over k, at a far point
+        /// @param node cluster index
+        /// @param moments moments from computeMoments
+        /// @param z the point
+        /// @return the cluster sum
+        std::complex<double> evaluateExpansion(int node, const std::complex<double> *moments, std::complex<double> z) const;
+
+        /// @brief splits the tree into the far clusters and the near leaves of a point
+        /// @param z the point
+        /// @param far receives the clusters that are expanded
+        /// @param near receives the leaves that are summed directly
+        /// @param stack traversal scratch space
+        void findInteractions(std::complex<double> z, std::vector<int> &far, std::vector<int> &near, std::vector<int> &stack) const;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "solution_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "airfoil.h"
+#include "gmres.h"
+#include "point.h"
+#include "solver_options.h"
+
+using aerodynamics::SolutionCache;
+
+using aerodynamics::Airfoil;
+using aerodynamics::CachedSolution;
+using aerodynamics::SolverMethod;
+using aerodynamics::SolverOptions;
+using geometry::Point;
+
+namespace
+{
+    // File signature, format version, and a byte-order mark that rejects files from machines of another endianness
+    const char fileMagic[4] = {'A', 'F', 'S', 'C'};
+    const std::uint32_t fileVersion = 1;
+    const std::uint32_t byteOrderMark = 0x01020304;
+
+    // Bookkeeping bytes of an entry beyond its key and values
+    const std::size_t entryOverhead = 128;
+
+    template <typename T>
+    void append(std::string &bytes, const T &value)
+    {
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream &file, T &value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+} // namespace
+
+SolutionCache::SolutionCache(std::size_t capacityBytes, const std::string &directory)
+    : mCapacity(capacityBytes), mSize(0), mDirectory(directory), mHits(0), mMisses(0)
+{
+}
+
+std::uint64_t SolutionCache::hash(const std::string &bytes)
+{
+    std::uint64_t result = 14695981039346656037ull;
+    for (unsigned char byte : bytes)
+    {
+        result ^= byte;
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+std::string SolutionCache::createKey(const Airfoil &airfoil, double angleOfAttackDegrees, const SolverOptions &options)
+{
+    std::string key;
+    key.reserve(airfoil.size() * 4 * sizeof(double) + 128);
+    append(key, static_cast<std::uint64_t>(airfoil.size()));
+    for (const auto &panel : airfoil)
+    {
+        Point start = panel.getStart();
+        Point end = panel.getEnd();
+        append(key, start.x);
+        append(key, start.y);
+        append(key, end.x);
+        append(key, end.y);
+    }
+    append(key, angleOfAttackDegrees);
+    append(key, static_cast<std::int32_t>(options.method));
+    if (options.method == SolverMethod::LowerUpperDecomposition)
+        return key;
+
+    append(key, options.tolerance);
+    append(key, static_cast<std::int32_t>(options.restart));
+    append(key, static_cast<std::int32_t>(options.maxIterations));
+    append(key, static_cast<std::int32_t>(options.preconditionerBlockSize));
+    if (options.method == SolverMethod::MatrixFreeGMRES)
+    {
+        append(key, options.treecode.theta);
+        append(key, static_cast<std::int32_t>(options.treecode.order));
+        append(key, static_cast<std::int32_t>(options.treecode.leafSize));
+    }
+    if (options.method == SolverMethod::HierarchicalGMRES)
+    {
+        append(key, options.hierarchical.tolerance);
+        append(key, static_cast<std::int32_t>(options.hierarchical.leafSize));
+        append(key, options.hierarchical.eta);
+    }
+    return key;
+}
+
+std::string SolutionCache::getPath(std::uint64_t keyHash) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.solution", static_cast<unsigned long long>(keyHash));
+    return mDirectory + "/" + name;
+}
+
+bool SolutionCache::find(const std::string &key, CachedSolution &solution)
+{
+    std::uint64_t keyHash = hash(key);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto range = mIndex.equal_range(keyHash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second->key == key)
+            {
+                // move the entry to the most recently used end
+                mEntries.splice(mEntries.end(), mEntries, it->second);
+                solution = it->second->solution;
+                mHits++;
+                return true;
+            }
+    }
+
+    bool found = !mDirectory.empty() && read(key, solution);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!found)
+    {
+        mMisses++;
+        return false;
+    }
+    mHits++;
+    insertEntry(key, solution);
+    return true;
+}
+
+void SolutionCache::insert(const std::string &key, const CachedSolution &solution)
+{
+    if (!mDirectory.empty())
+        write(key, solution);
+    std::lock_guard<std::mutex> lock(mMutex);
+    insertEntry(key, solution);
+}
+
+void SolutionCache::insertEntry(const std::string &key, const CachedSolution &solution)
+{
+    std::uint64_t keyHash = hash(key);
+    auto range = mIndex.equal_range(keyHash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second->key == key)
+        {
+            mSize -= it->second->bytes;
+            mEntries.erase(it->second);
+            mIndex.erase(it);
+            break;
+        }
+
+    std::size_t bytes = key.size() + (solution.lambdas.size() + solution.gammas.size() + solution.pressures.size()) * sizeof(double) + entryOverhead;
+    if (bytes > mCapacity)
+        return;
+    mEntries.push_back(Entry{key, solution, bytes});
+    mIndex.emplace(keyHash, std::prev(mEntries.end()));
+    mSize += bytes;
+    while (mSize > mCapacity)
+    {
+        Entry &oldest = mEntries.front();
+        auto oldestRange = mIndex.equal_range(hash(oldest.key));
+        for (auto it = oldestRange.first; it != oldestRange.second; ++it)
+            if (it->second == mEntries.begin())
+            {
+                mIndex.erase(it);
+                break;
+            }
+        mSize -= oldest.bytes;
+        mEntries.pop_front();
+    }
+}
+
+bool SolutionCache::read(const std::string &key, CachedSolution &solution) const
+{
+    std::ifstream file(getPath(hash(key)), std::ios::binary);
+    if (!file)
+        return false;
+
+    char magic[4];
+    std::uint32_t version, byteOrder;
+    std::uint64_t keyLength, count;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(magic)) != 0)
+        return false;
+    if (!readValue(file, version) || version != fileVersion || !readValue(file, byteOrder) || byteOrder != byteOrderMark)
+        return false;
+    if (!readValue(file, keyLength) || keyLength != key.size())
+        return false;
+    std::string fileKey(keyLength, '\0');
+    if (!file.read(&fileKey[0], keyLength) || fileKey != key)
+        return false;
+    // the key leads with the panel count, which bounds the values so a corrupt file cannot ask for an arbitrary allocation
+    std::uint64_t panelCount;
+    if (key.size() < sizeof(panelCount))
+        return false;
+    std::memcpy(&panelCount, key.data(), sizeof(panelCount));
+    if (!readValue(file, count) || count != panelCount)
+        return false;
+
+    CachedSolution result;
+    for (std::vector<double> *values : {&result.lambdas, &result.gammas, &result.pressures})
+    {
+        values->resize(count);
+        if (!file.read(reinterpret_cast<char *>(values->data()), count * sizeof(double)))
+            return false;
+    }
+    std::int32_t iterations, restarts;
+    std::uint8_t converged;
+    if (!readValue(file, iterations) || !readValue(file, restarts) || !readValue(file, result.report.residual) || !readValue(file, converged))
+        return false;
+    result.report.iterations = iterations;
+    result.report.restarts = restarts;
+    result.report.converged = converged != 0;
+    solution = result;
+    return true;
+}
+
+void SolutionCache::write(const std::string &key, const CachedSolution &solution) const
+{
+    // a uniquely named temporary file renamed into place keeps readers from seeing a partial solution and writers of one key from sharing a file
+    std::string path = getPath(hash(key));
+    std::string temporary = path + ".XXXXXX";
+    int descriptor = mkstemp(&temporary[0]);
+    if (descriptor < 0)
+        return;
+    close(descriptor);
+    bool written;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(fileMagic, sizeof(fileMagic));
+        writeValue(file, fileVersion);
+        writeValue(file, byteOrderMark);
+        writeValue(file, static_cast<std::uint64_t>(key.size()));
+        file.write(key.data(), key.size());
+        writeValue(file, static_cast<std::uint64_t>(solution.lambdas.size()));
+        file.write(reinterpret_cast<const char *>(solution.lambdas.data()), solution.lambdas.size() * sizeof(double));
+        file.write(reinterpret_cast<const char *>(solution.gammas.data()), solution.gammas.size() * sizeof(double));
+        file.write(reinterpret_cast<const char *>(solution.pressures.data()), solution.pressures.size() * sizeof(double));
+        writeValue(file, static_cast<std::int32_t>(solution.report.iterations));
+        writeValue(file, static_cast<std::int32_t>(solution.report.restarts));
+        writeValue(file, solution.report.residual);
+        writeValue(file, static_cast<std::uint8_t>(solution.report.converged));
+        file.close();
+        written = !file.fail();
+    }
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0)
+        std::remove(temporary.c_str());
+}
+
+void SolutionCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+    mSize = 0;
+}
+
+int SolutionCache::entryCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+std::size_t SolutionCache::sizeBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mSize;
+}
+
+std::size_t SolutionCache::hitCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+std::size_t SolutionCache::missCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMisses;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef AIRFOILS_AERODYNAMICS_SOLUTIONCACHE_H_
+#define AIRFOILS_AERODYNAMICS_SOLUTIONCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "airfoil.h"
+#include "gmres.h"
+#include "solver_options.h"
+
+namespace aerodynamics
+{
+    /// @brief the solved strengths and pressures of one airfoil at one angle of attack
+    struct CachedSolution
+    {
+        /// @brief source strength of each panel
+        std::vector<double> lambdas;
+
+        /// @brief vortex strength of each panel
+        std::vector<double> gammas;
+
+        /// @brief pressure coefficient of each panel
+        std::vector<double> pressures;
+
+        /// @brief the iterative solver outcome, default for a direct solve
+        linear_algebra::SolverReport report;
+    };
+
+    /// @brief a least recently used cache of solutions keyed by the bytes of the panel coordinates, angle of attack, and solver options, optionally backed by a directory of one file per solution
+    class SolutionCache
+    {
+    private:
+        struct Entry
+        {
+            std::string key;
+            aerodynamics::CachedSolution solution;
+            std::size_t bytes;
+        };
+
+        std::size_t mCapacity, mSize;
+        std::string mDirectory;
+        std::list<Entry> mEntries;
+        std::unordered_multimap<std::uint64_t, std::list<Entry>::iterator> mIndex;
+        std::size_t mHits, mMisses;
+        mutable std::mutex mMutex;
+
+        std::string getPath(std::uint64_t keyHash) const;
+        bool read(const std::string &key, aerodynamics::CachedSolution &solution) const;
+        void write(const std::string &key, const aerodynamics::CachedSolution &solution) const;
+        void insertEntry(const std::string &key, const aerodynamics::CachedSolution &solution);
+
+    public:
+        /// @brief an empty cache
+        /// @param capacityBytes memory the cached solutions may use before the least recently used are evicted
+        /// @param directory an existing directory that keeps every solution across runs, empty for memory only
+        SolutionCache(std::size_t capacityBytes, const std::string &directory = "");
+
+        /// @brief the 64-bit FNV-1a hash
+        /// @param bytes bytes to hash
+        /// @return the hash
+        static std::uint64_t hash(const std::string &bytes);
+
+        /// @brief serializes everything a solution depends on, the panel endpoints, the angle, and the options the solver method reads
+        /// @param airfoil airfoil geometry
+        /// @param angleOfAttackDegrees angle of attack in degrees
+        /// @param options linear solver settings
+        /// @return the key bytes
+        static std::string createKey(const aerodynamics::Airfoil &airfoil, double angleOfAttackDegrees, const aerodynamics::SolverOptions &options);
+
+        /// @brief looks up a solution in memory and then on disk, comparing the full key so hash collisions miss
+        /// @param key key bytes
+        /// @param solution receives the solution on a hit
+        /// @return indicates a hit
+        bool find(const std::string &key, aerodynamics::CachedSolution &solution);
+
+        /// @brief stores a solution in memory and on disk
+        /// @param key key bytes
+        /// @param solution the solution
+        void insert(const std::string &key, const aerodynamics::CachedSolution &solution);
+
+        /// @brief drops every solution held in memory, the files on disk are kept
+        void clear();
+
+        /// @brief gets the solutions held in memory
+        /// @return entry count
+        int entryCount() const;
+
+        /// @brief gets the memory used by the solutions held
+        /// @return approximate bytes
+        std::size_t sizeBytes() const;
+
+        /// @brief gets the lookups that found a solution
+        /// @return hit count
+        std::size_t hitCount() const;
+
+        /// @brief gets the lookups that did not find a solution
+        /// @return miss count
+        std::size_t missCount() const;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
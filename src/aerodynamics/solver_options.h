@@ -0,0 +1,51 @@
+#ifndef AIRFOILS_AERODYNAMICS_SOLVEROPTIONS_H_
+#define AIRFOILS_AERODYNAMICS_SOLVEROPTIONS_H_
+
+#include "hierarchical_matrix.h"
+#include "segment_tree.h"
+
+namespace aerodynamics
+{
+    /// @brief the linear solver used for the panel system
+    enum class SolverMethod
+    {
+        /// @brief dense LU factorization with partial pivoting
+        LowerUpperDecomposition,
+
+        /// @brief restarted GMRES preconditioned by the near-field diagonal blocks
+        GMRES,
+
+        /// @brief GMRES on the matrix-free treecode operator, which stores O(N log N) near-field integrals instead of the (N + 1)^2 matrix
+        MatrixFreeGMRES,
+
+        /// @brief GMRES on the influence matrix compressed into a hierarchical matrix, with dense near-field and low-rank far-field blocks
+        HierarchicalGMRES
+    };
+
+    /// @brief settings for solving the panel system
+    struct SolverOptions
+    {
+        /// @brief the linear solver
+        SolverMethod method = SolverMethod::LowerUpperDecomposition;
+
+        /// @brief relative residual the iterative solver stops at
+        double tolerance = 1e-10;
+
+        /// @brief Krylov subspace size before the iterative solver restarts
+        int restart = 50;
+
+        /// @brief maximum operator applications of the iterative solver
+        int maxIterations = 500;
+
+        /// @brief consecutive panels per preconditioner block, 0 disables preconditioning
+        int preconditionerBlockSize = 32;
+
+        /// @brief expansion settings of the matrix-free operator
+        aerodynamics::TreecodeOptions treecode;
+
+        /// @brief compression settings of the hierarchical matrices
+        linear_algebra::HierarchicalOptions hierarchical;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
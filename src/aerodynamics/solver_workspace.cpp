@@ -0,0 +1,42 @@
+#include "solver_workspace.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "airfoil.h"
+#include "influence_matrices.h"
+#include "lu_factorization.h"
+#include "matrix.h"
+#include "panel_geometry.h"
+
+using aerodynamics::SolverWorkspace;
+
+using aerodynamics::Airfoil;
+using linear_algebra::Matrix;
+
+namespace
+{
+    /// @brief checks a panel count before any buffer is sized from it
+    int validatePanelCount(int panelCount)
+    {
+        if (panelCount < 0)
+            throw std::invalid_argument("The panel count must not be negative");
+        return panelCount;
+    }
+} // namespace
+
+SolverWorkspace::SolverWorkspace(int maxPanelCount)
+    : solved(validatePanelCount(maxPanelCount)), geometry(solved),
+      matrices{Matrix(maxPanelCount + 1, maxPanelCount + 1), Matrix(maxPanelCount, maxPanelCount), std::vector<double>(maxPanelCount)},
+      factorization(maxPanelCount + 1), rightHandSide(maxPanelCount + 1), strengths(maxPanelCount + 1), velocities(maxPanelCount)
+{
+    // the buffers keep their capacity but hold nothing until the first solve
+    solved.clear();
+    geometry.assign(solved);
+    matrices.system.resize(0, 0);
+    matrices.tangential.resize(0, 0);
+    matrices.vortexTangential.clear();
+    rightHandSide.clear();
+    strengths.clear();
+    velocities.clear();
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef AIRFOILS_AERODYNAMICS_SOLVERWORKSPACE_H_
+#define AIRFOILS_AERODYNAMICS_SOLVERWORKSPACE_H_
+
+#include <vector>
+
+#include "airfoil.h"
+#include "influence_matrices.h"
+#include "lu_factorization.h"
+#include "panel_geometry.h"
+
+namespace aerodynamics
+{
+    /// @brief every buffer of a dense source-vortex solve, kept between solves so an optimizer that evaluates many airfoils does not allocate, one per thread
+    struct SolverWorkspace
+    {
+        /// @brief allocates the buffers for airfoils of up to a panel count, larger airfoils grow them once
+        /// @param maxPanelCount largest panel count solved without allocating
+        explicit SolverWorkspace(int maxPanelCount);
+
+        /// @brief the airfoil of the last solve with its strengths and pressure coefficients set
+        aerodynamics::Airfoil solved;
+
+        /// @brief panel geometry of the last solved airfoil
+        aerodynamics::PanelGeometry geometry;
+
+        /// @brief influence matrices of the last solved airfoil
+        aerodynamics::InfluenceMatrices matrices;
+
+        /// @brief factored system matrix of the last solved airfoil
+        linear_algebra::LUFactorization factorization;
+
+        /// @brief right-hand side of the last solve, the freestream terms of each panel and the Kutta condition
+        std::vector<double> rightHandSide;
+
+        /// @brief solution of the last solve, the source strength of each panel and then the vortex strength
+        std::vector<double> strengths;
+
+        /// @brief surface tangential velocity at each panel control point of the last solve
+        std::vector<double> velocities;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
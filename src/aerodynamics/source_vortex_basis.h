@@ -0,0 +1,36 @@
+#ifndef AIRFOILS_AERODYNAMICS_SOURCEVORTEXBASIS_H_
+#define AIRFOILS_AERODYNAMICS_SOURCEVORTEXBASIS_H_
+
+#include <vector>
+
+#include "airfoil.h"
+
+namespace aerodynamics
+{
+    /// @brief the source-vortex solutions of an airfoil for unit freestreams along x and along y, the solution at angle of attack alpha is cos(alpha) times the first plus sin(alpha) times the second
+    struct SourceVortexBasis
+    {
+        /// @brief the airfoil geometry that was solved
+        aerodynamics::Airfoil airfoil;
+
+        /// @brief source strengths of the freestream along x, one per panel
+        std::vector<double> cosineLambdas;
+
+        /// @brief source strengths of the freestream along y, one per panel
+        std::vector<double> sineLambdas;
+
+        /// @brief vortex strength of the freestream along x
+        double cosineGamma;
+
+        /// @brief vortex strength of the freestream along y
+        double sineGamma;
+
+        /// @brief surface tangential velocities of the freestream along x, one per panel
+        std::vector<double> cosineVelocities;
+
+        /// @brief surface tangential velocities of the freestream along y, one per panel
+        std::vector<double> sineVelocities;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "source_vortex_operator.h"
+
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "geometric_integrals.h"
+#include "panel.h"
+#include "panel_geometry.h"
+#include "point.h"
+#include "profiler.h"
+#include "segment_tree.h"
+#include "thread_pool.h"
+
+using aerodynamics::SourceVortexOperator;
+
+using aerodynamics::GeometricIntegrals;
+using aerodynamics::Panel;
+using aerodynamics::SegmentTree;
+using aerodynamics::TreecodeOptions;
+using concurrency::ThreadPool;
+using geometry::Point;
+
+namespace
+{
+    // Control points per parallel chunk
+    const int controlPointGrain = 16;
+} // namespace
+
+SourceVortexOperator::SourceVortexOperator(const std::vector<Panel> &panels, const TreecodeOptions &options)
+    : mTree(buildTree(panels, options)), mGeometry(mTree.sortItems(panels))
+{
+    AIRFOILS_PROFILE_SCOPE("assembly");
+    const std::vector<int> &order = mTree.getOrder();
+    const std::vector<SegmentTree::Node> &nodes = mTree.getNodes();
+    const std::vector<double> &cosPhi = mGeometry.getCosPhi();
+    const std::vector<double> &sinPhi = mGeometry.getSinPhi();
+    int count = mGeometry.size();
+    mPositions.resize(count);
+    for (int j = 0; j < count; ++j)
+        mPositions[order[j]] = j;
+
+    // the interaction lists are counted first so every control point fills a fixed range of them
+    mFarOffsets.assign(count + 1, 0);
+    mNearOffsets.assign(count + 1, 0);
+    ThreadPool::shared().parallelFor(0, count, controlPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        std::vector<int> far, near, stack;
+        for (int i = pointBegin; i < pointEnd; ++i)
+        {
+            mTree.findInteractions(std::complex<double>(mGeometry.getMidX()[i], mGeometry.getMidY()[i]), far, near, stack);
+            // the panel itself is in one of the near leaves and has no entry
+            int nearCount = -1;
+            for (int index : near)
+                nearCount += nodes[index].end - nodes[index].begin;
+            mFarOffsets[i + 1] = far.size();
+            mNearOffsets[i + 1] = nearCount;
+        } });
+    std::partial_sum(mFarOffsets.begin(), mFarOffsets.end(), mFarOffsets.begin());
+    std::partial_sum(mNearOffsets.begin(), mNearOffsets.end(), mNearOffsets.begin());
+    mFarNodes.resize(mFarOffsets.back());
+    mNearColumns.resize(mNearOffsets.back());
+    mNearNormal.resize(mNearOffsets.back());
+    mNearTangential.resize(mNearOffsets.back());
+
+    // unit strengths give the row sums of the integrals, which fill the vortex column and the pressure stage
+    std::vector<std::complex<double>> moments(static_cast<std::size_t>(mTree.nodeCount()) * mTree.termCount());
+    mTree.computeMoments(std::vector<std::complex<double>>(count, 1.0).data(), moments.data());
+    mTangentialSums.resize(count);
+    mVortexTangential.resize(count);
+    ThreadPool::shared().parallelFor(0, count, controlPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        std::vector<int> far, near, stack;
+        std::vector<double> normal(count), tangential(count);
+        for (int i = pointBegin; i < pointEnd; ++i)
+        {
+            std::complex<double> z(mGeometry.getMidX()[i], mGeometry.getMidY()[i]);
+            mTree.findInteractions(z, far, near, stack);
+            std::copy(far.begin(), far.end(), mFarNodes.begin() + mFarOffsets[i]);
+            std::complex<double> farSum = 0.0;
+            for (int index : far)
+                farSum += mTree.evaluateExpansion(index, moments.data(), z);
+
+            int entry = mNearOffsets[i];
+            double sumI = 0.0;
+            double sumJ = 0.0;
+            for (int index : near)
+            {
+                const SegmentTree::Node &node = nodes[index];
+                GeometricIntegrals::computePanelIntegrals(mGeometry, i, node.begin, node.end, normal.data(), tangential.data());
+                for (int j = node.begin; j < node.end; j++)
+                {
+                    if (j == i)
+                        continue;
+                    mNearColumns[entry] = j;
+                    mNearNormal[entry] = normal[j - node.begin];
+                    mNearTangential[entry] = tangential[j - node.begin];
+                    sumI += normal[j - node.begin];
+                    sumJ += tangential[j - node.begin];
+                    entry++;
+                }
+            }
+            // I_ij = Re(i e^(i phi_i) W_ij) and J_ij = Re(e^(i phi_i) W_ij), where W_ij is the integral of ds / (z_i - z_j(s))
+            sumI -= sinPhi[i] * farSum.real() + cosPhi[i] * farSum.imag();
+            sumJ += cosPhi[i] * farSum.real() - sinPhi[i] * farSum.imag();
+            mTangentialSums[order[i]] = sumJ;
+            mVortexTangential[order[i]] = -sumI;
+        } });
+
+    // the Kutta condition row sums the exact tangential integrals of the first and last panels
+    int first = mPositions.front();
+    int last = mPositions.back();
+    std::vector<double> firstNormal(count), firstTangential(count), lastNormal(count), lastTangential(count);
+    GeometricIntegrals::computePanelIntegrals(mGeometry, first, 0, count, firstNormal.data(), firstTangential.data());
+    GeometricIntegrals::computePanelIntegrals(mGeometry, last, 0, count, lastNormal.data(), lastTangential.data());
+    mKuttaRow.resize(count);
+    mKuttaDiagonal = 2.0 * M_PI;
+    for (int j = 0; j < count; ++j)
+    {
+        mKuttaRow[order[j]] = firstTangential[j] + lastTangential[j];
+        mKuttaDiagonal += firstNormal[j] + lastNormal[j];
+    }
+}
+
+SegmentTree SourceVortexOperator::buildTree(const std::vector<Panel> &panels, const TreecodeOptions &options)
+{
+    if (panels.empty())
+        throw std::invalid_argument("The panels must not be empty");
+
+    int count = panels.size();
+    std::vector<std::complex<double>> starts(count), ends(count);
+    for (int j = 0; j < count; ++j)
+    {
+        // the system integrals run along each panel from its start
+        Point start = panels[j].getStart();
+        Point end = panels[j].getEnd();
+        starts[j] = std::complex<double>(start.x, start.y);
+        ends[j] = std::complex<double>(end.x, end.y);
+    }
+    return SegmentTree(starts, ends, options);
+}
+
+void SourceVortexOperator::sumInteractions(const double *lambdas, double *normal, double *tangential) const
+{
+    const std::vector<int> &order = mTree.getOrder();
+    const std::vector<double> &cosPhi = mGeometry.getCosPhi();
+    const std::vector<double> &sinPhi = mGeometry.getSinPhi();
+    int count = mGeometry.size();
+    std::vector<double> sorted(count);
+    std::vector<std::complex<double>> strengths(count);
+    for (int j = 0; j < count; ++j)
+    {
+        sorted[j] = lambdas[order[j]];
+        strengths[j] = sorted[j];
+    }
+    std::vector<std::complex<double>> moments(static_cast<std::size_t>(mTree.nodeCount()) * mTree.termCount());
+    mTree.computeMoments(strengths.data(), moments.data());
+
+    // every row is written by exactly one chunk in a fixed order, so the result does not depend on the thread count
+    ThreadPool::shared().parallelFor(0, count, controlPointGrain, [&](int pointBegin, int pointEnd)
+                                     {
+        for (int i = pointBegin; i < pointEnd; ++i)
+        {
+            std::complex<double> z(mGeometry.getMidX()[i], mGeometry.getMidY()[i]);
+            std::complex<double> farSum = 0.0;
+            for (int k = mFarOffsets[i]; k < mFarOffsets[i + 1]; k++)
+                farSum += mTree.evaluateExpansion(mFarNodes[k], moments.data(), z);
+            if (normal != nullptr)
+            {
+                double sum = -(sinPhi[i] * farSum.real() + cosPhi[i] * farSum.imag());
+                for (int k = mNearOffsets[i]; k < mNearOffsets[i + 1]; k++)
+                    sum += mNearNormal[k] * sorted[mNearColumns[k]];
+                normal[order[i]] = sum;
+            }
+            if (tangential != nullptr)
+            {
+                double sum = cosPhi[i] * farSum.real() - sinPhi[i] * farSum.imag();
+                for (int k = mNearOffsets[i]; k < mNearOffsets[i + 1]; k++)
+                    sum += mNearTangential[k] * sorted[mNearColumns[k]];
+                tangential[order[i]] = sum;
+            }
+        } });
+}
+
+void SourceVortexOperator::apply(const double *x, double *y) const
+{
+    int count = mGeometry.size();
+    sumInteractions(x, y, nullptr);
+    double gamma = x[count];
+    double kutta = gamma * mKuttaDiagonal;
+    for (int i = 0; i < count; ++i)
+    {
+        y[i] += M_PI * x[i] - gamma * mTangentialSums[i];
+        kutta += mKuttaRow[i] * x[i];
+    }
+    y[count] = kutta;
+}
+
+void SourceVortexOperator::multiplyTangential(const double *lambdas, double *result) const
+{
+    sumInteractions(lambdas, nullptr, result);
+}
+
+double SourceVortexOperator::entry(int i, int j) const
+{
+    int count = mGeometry.size();
+    if (i < 0 || i > count || j < 0 || j > count)
+        throw std::invalid_argument("The row and column must be inside the operator");
+
+    if (i == count)
+        return j == count ? mKuttaDiagonal : mKuttaRow[j];
+    if (j == count)
+        return -mTangentialSums[i];
+    if (i == j)
+        return M_PI;
+    double normal, tangential;
+    GeometricIntegrals::computePanelIntegrals(mGeometry, mPositions[i], mPositions[j], mPositions[j] + 1, &normal, &tangential);
+    return normal;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef AIRFOILS_AERODYNAMICS_SOURCEVORTEXOPERATOR_H_
+#define AIRFOILS_AERODYNAMICS_SOURCEVORTEXOPERATOR_H_
+
+#include <complex>
+#include <vector>
+
+#include "linear_operator.h"
+#include "panel.h"
+#include "panel_geometry.h"
+#include "segment_tree.h"
+
+namespace aerodynamics
+{
+    /// @brief the source-vortex influence matrix applied without assembling it, near panel pairs are stored exactly and distant clusters are multipole expansions, so memory and each product cost O(N log N)
+    class SourceVortexOperator : public linear_algebra::LinearOperator
+    {
+    private:
+        aerodynamics::SegmentTree mTree;
+        aerodynamics::PanelGeometry mGeometry;
+        std::vector<int> mPositions;
+        std::vector<int> mFarOffsets, mFarNodes;
+        std::vector<int> mNearOffsets, mNearColumns;
+        std::vector<double> mNearNormal, mNearTangential;
+        std::vector<double> mTangentialSums, mVortexTangential;
+        std::vector<double> mKuttaRow;
+        double mKuttaDiagonal;
+
+        static aerodynamics::SegmentTree buildTree(const std::vector<aerodynamics::Panel> &panels, const TreecodeOptions &options);
+        void sumInteractions(const double *lambdas, double *normal, double *tangential) const;
+
+    public:
+        /// @brief sorts the panels into clusters and stores the near-field integrals, the Kutta row, and the row sums of the vortex column
+        /// @param panels airfoil panels
+        /// @param options accuracy settings
+        SourceVortexOperator(const std::vector<aerodynamics::Panel> &panels, const TreecodeOptions &options = TreecodeOptions());
+
+        inline int size() const override { return mGeometry.size() + 1; };
+
+        /// @brief computes y = Ax for the source strengths and vortex strength x, matching the product with computeSourceVortexMatrix to the treecode accuracy
+        /// @param x input vector of size() entries
+        /// @param y output vector of size() entries that does not overlap x
+        void apply(const double *x, double *y) const override;
+
+        /// @brief computes the tangential source sums, J times the source strengths, of the surface velocity
+        /// @param lambdas source strength of each panel
+        /// @param result receives the sum at each panel control point
+        void multiplyTangential(const double *lambdas, double *result) const;
+
+        /// @brief computes one entry of the influence matrix exactly, which builds preconditioner blocks
+        /// @param i row
+        /// @param j column
+        /// @return the entry of computeSourceVortexMatrix
+        double entry(int i, int j) const;
+
+        /// @brief gets the sum of the vortex tangential integrals L_ij over j of each row
+        /// @return a value for each panel
+        inline const std::vector<double> &getVortexTangential() const { return mVortexTangential; };
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
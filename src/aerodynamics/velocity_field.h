@@ -0,0 +1,44 @@
+#ifndef AIRFOILS_AERODYNAMICS_VELOCITYFIELD_H_
+#define AIRFOILS_AERODYNAMICS_VELOCITYFIELD_H_
+
+#include <vector>
+
+namespace aerodynamics
+{
+    /// @brief a regular grid of field points stored row by row, where point (row, column) is at (originX + column spacingX, originY + row spacingY)
+    struct FieldGrid
+    {
+        /// @brief x of the first column
+        double originX = 0.0;
+
+        /// @brief y of the first row
+        double originY = 0.0;
+
+        /// @brief distance between columns
+        double spacingX = 1.0;
+
+        /// @brief distance between rows
+        double spacingY = 1.0;
+
+        /// @brief points per row
+        int columns = 0;
+
+        /// @brief row count
+        int rows = 0;
+    };
+
+    /// @brief velocity and pressure at a set of field points in structure-of-arrays layout, relative to the freestream
+    struct VelocityField
+    {
+        /// @brief x velocity of each point
+        std::vector<double> vx;
+
+        /// @brief y velocity of each point
+        std::vector<double> vy;
+
+        /// @brief pressure coefficient of each point
+        std::vector<double> cp;
+    };
+} // namespace aerodynamics
+
+#endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "airfoil_c.h"
+
+#include <cmath>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "airfoil.h"
+#include "panel.h"
+#include "panel_geometry.h"
+#include "panel_methods.h"
+#include "point.h"
+#include "segment_tree.h"
+#include "source_vortex_basis.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
+using aerodynamics::PanelMethods;
+using aerodynamics::SourceVortexBasis;
+using aerodynamics::TreecodeOptions;
+using geometry::Point;
+
+/// @brief the basis solutions behind the opaque handle of the C interface, with the panel geometry the field points are integrated against
+struct airfoil_solver
+{
+    SourceVortexBasis basis;
+    PanelGeometry geometry;
+
+    airfoil_solver(SourceVortexBasis solved) : basis(std::move(solved)), geometry(basis.airfoil) {}
+};
+
+namespace
+{
+    thread_local std::string lastError;
+
+    /// @brief runs a body, turning its exceptions into a status and the message of airfoil_last_error, since none may cross the C interface
+    template <typename Body>
+    airfoil_status guard(const Body &body)
+    {
+        try
+        {
+            body();
+            lastError.clear();
+            return AIRFOIL_OK;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            lastError = e.what();
+            return AIRFOIL_INVALID_ARGUMENT;
+        }
+        catch (const std::bad_alloc &e)
+        {
+            lastError = "Out of memory";
+            return AIRFOIL_OUT_OF_MEMORY;
+        }
+        catch (const std::exception &e)
+        {
+            lastError = e.what();
+            return AIRFOIL_FAILURE;
+        }
+        catch (...)
+        {
+            lastError = "Unknown failure";
+            return AIRFOIL_FAILURE;
+        }
+    }
+
+    void checkPointers(bool present)
+    {
+        if (!present)
+            throw std::invalid_argument("The pointer arguments must not be null");
+    }
+
+    Airfoil getNACA4Airfoil(const airfoil_naca4 *naca)
+    {
+        checkPointers(naca != nullptr);
+        return Airfoil::getNACA4Airfoil(naca->point_count, naca->max_camber, naca->camber_position, naca->thickness, naca->closed_trailing_edge != 0, 0.0);
+    }
+} // namespace
+
+int airfoil_abi_version(void)
+{
+    return AIRFOIL_ABI_VERSION;
+}
+
+const char *airfoil_last_error(void)
+{
+    return lastError.c_str();
+}
+
+airfoil_status airfoil_naca4_points(const airfoil_naca4 *naca, double *x, double *y)
+{
+    return guard([&]
+                 {
+        Airfoil airfoil = getNACA4Airfoil(naca);
+        checkPointers(x != nullptr && y != nullptr);
+        for (int i = 0; i < airfoil.size(); ++i)
+        {
+            x[i] = airfoil[i].getStart().x;
+            y[i] = airfoil[i].getStart().y;
+        }
+        x[airfoil.size()] = airfoil.back().getEnd().x;
+        y[airfoil.size()] = airfoil.back().getEnd().y; });
+}
+
+airfoil_status airfoil_solver_create(const double *x, const double *y, int point_count, airfoil_solver **solver)
+{
+    return guard([&]
+                 {
+        checkPointers(x != nullptr && y != nullptr && solver != nullptr);
+        *solver = nullptr;
+        if (point_count < 4)
+            throw std::invalid_argument("The contour must have at least 4 points");
+        std::vector<Panel> panels;
+        panels.reserve(point_count - 1);
+        for (int i = 0; i + 1 < point_count; ++i)
+        {
+            if (!std::isfinite(x[i]) || !std::isfinite(y[i]) || !std::isfinite(x[i + 1]) || !std::isfinite(y[i + 1]))
+                throw std::invalid_argument("The contour points must be finite");
+            if (x[i] == x[i + 1] && y[i] == y[i + 1])
+                throw std::invalid_argument("Consecutive contour points must differ");
+            panels.push_back(Panel(Point{x[i], y[i], 0}, Point{x[i + 1], y[i + 1], 0}));
+        }
+        *solver = new airfoil_solver(PanelMethods::computeSourceVortexBasis(Airfoil(panels))); });
+}
+
+airfoil_status airfoil_solver_create_naca4(const airfoil_naca4 *naca, airfoil_solver **solver)
+{
+    return guard([&]
+                 {
+        checkPointers(solver != nullptr);
+        *solver = nullptr;
+        *solver = new airfoil_solver(PanelMethods::computeSourceVortexBasis(getNACA4Airfoil(naca))); });
+}
+
+void airfoil_solver_destroy(airfoil_solver *solver)
+{
+    delete solver;
+}
+
+int airfoil_solver_panel_count(const airfoil_solver *solver)
+{
+    return solver != nullptr ? static_cast<int>(solver->basis.airfoil.size()) : 0;
+}
+
+airfoil_status airfoil_solver_solve(const airfoil_solver *solver, double alpha_degrees, double *lift, double *drag, double *moment, double *pressures)
+{
+    return guard([&]
+                 {
+        checkPointers(solver != nullptr && lift != nullptr && drag != nullptr && moment != nullptr);
+        PanelMethods::computeCoefficients(solver->basis, alpha_degrees, *lift, *drag, *moment, pressures); });
+}
+
+airfoil_status airfoil_solver_polar(const airfoil_solver *solver, const double *alpha_degrees, int count, double *lift, double *drag, double *moment, double *pressures)
+{
+    return guard([&]
+                 {
+        checkPointers(solver != nullptr && alpha_degrees != nullptr && lift != nullptr && drag != nullptr && moment != nullptr);
+        if (count < 0)
+            throw std::invalid_argument("The angle count must not be negative");
+        std::size_t panelCount = solver->basis.airfoil.size();
+        for (int k = 0; k < count; ++k)
+            PanelMethods::computeCoefficients(solver->basis, alpha_degrees[k], lift[k], drag[k], moment[k], pressures != nullptr ? pressures + k * panelCount : nullptr); });
+}
+
+airfoil_status airfoil_solver_field(const airfoil_solver *solver, double alpha_degrees, const double *x, const double *y, int count, int use_treecode, double *vx, double *vy, double *cp)
+{
+    return guard([&]
+                 {
+        checkPointers(solver != nullptr && x != nullptr && y != nullptr && vx != nullptr && vy != nullptr && cp != nullptr);
+        if (count < 0)
+            throw std::invalid_argument("The point count must not be negative");
+        if (use_treecode != 0)
+            PanelMethods::computeVelocityField(PanelMethods::computeSourceVortex(solver->basis, alpha_degrees), x, y, count, vx, vy, cp, TreecodeOptions());
+        else
+            PanelMethods::computeVelocityField(solver->basis, solver->geometry, alpha_degrees, x, y, count, vx, vy, cp); });
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef AIRFOILS_CAPI_AIRFOILC_H_
+#define AIRFOILS_CAPI_AIRFOILC_H_
+
+#if defined(_WIN32) && !defined(AIRFOIL_STATIC)
+#if defined(AIRFOIL_BUILDING_LIBRARY)
+#define AIRFOIL_API __declspec(dllexport)
+#else
+#define AIRFOIL_API __declspec(dllimport)
+#endif
+#else
+#define AIRFOIL_API __attribute__((visibility("default")))
+#endif
+
+/// @brief version of the functions and structures of this header, raised on any incompatible change
+#define AIRFOIL_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /// @brief result of the functions that can fail, the message of the last failure of a thread is airfoil_last_error
+    typedef enum airfoil_status
+    {
+        AIRFOIL_OK = 0,
+        AIRFOIL_INVALID_ARGUMENT = 1,
+        AIRFOIL_OUT_OF_MEMORY = 2,
+        AIRFOIL_FAILURE = 3
+    } airfoil_status;
+
+    /// @brief a NACA 4-digit airfoil
+    typedef struct airfoil_naca4
+    {
+        /// @brief maximum camber in percent of the chord, in [0, 9.5]
+        double max_camber;
+
+        /// @brief position of maximum camber in percent of the chord, in [0, 90]
+        double camber_position;
+
+        /// @brief maximum thickness in percent of the chord, in [1, 40]
+        double thickness;
+
+        /// @brief even panel count in [20, 20000], the contour has one more point
+        int point_count;
+
+        /// @brief nonzero to close the trailing edge
+        int closed_trailing_edge;
+    } airfoil_naca4;
+
+    /// @brief an airfoil whose source-vortex solutions for freestreams along x and y are solved once, so every angle of attack
+    /// costs O(panels); its functions take const pointers and may be called from many threads at once
+    typedef struct airfoil_solver airfoil_solver;
+
+    /// @brief gets the version the library was built with, which must equal AIRFOIL_ABI_VERSION
+    /// @return the library ABI version
+    AIRFOIL_API int airfoil_abi_version(void);
+
+    /// @brief gets the message of the last failure on the calling thread
+    /// @return the message, empty after a success, valid until the next call on the thread
+    AIRFOIL_API const char *airfoil_last_error(void);
+
+    /// @brief computes the contour of a NACA 4-digit airfoil from the trailing edge along the lower surface and back along the upper surface
+    /// @param naca airfoil parameters
+    /// @param x receives point_count + 1 x coordinates
+    /// @param y receives point_count + 1 y coordinates
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_naca4_points(const airfoil_naca4 *naca, double *x, double *y);
+
+    /// @brief solves an airfoil given as a contour, panel i runs from point i to point i + 1
+    /// @param x x coordinates of the points, clockwise from the trailing edge
+    /// @param y y coordinates of the points
+    /// @param point_count point count, at least 4
+    /// @param solver receives the solver, released with airfoil_solver_destroy
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_solver_create(const double *x, const double *y, int point_count, airfoil_solver **solver);
+
+    /// @brief solves a NACA 4-digit airfoil
+    /// @param naca airfoil parameters
+    /// @param solver receives the solver, released with airfoil_solver_destroy
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_solver_create_naca4(const airfoil_naca4 *naca, airfoil_solver **solver);
+
+    /// @brief releases a solver
+    /// @param solver the solver, or NULL
+    AIRFOIL_API void airfoil_solver_destroy(airfoil_solver *solver);
+
+    /// @brief gets the panel count, the length of the pressure arrays
+    /// @param solver the solver
+    /// @return the panel count
+    AIRFOIL_API int airfoil_solver_panel_count(const airfoil_solver *solver);
+
+    /// @brief computes the coefficients at an angle of attack without allocating
+    /// @param solver the solver
+    /// @param alpha_degrees angle of attack in degrees
+    /// @param lift receives the lift coefficient
+    /// @param drag receives the drag coefficient
+    /// @param moment receives the moment coefficient about the quarter chord
+    /// @param pressures receives the pressure coefficient of each panel, or NULL
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_solver_solve(const airfoil_solver *solver, double alpha_degrees, double *lift, double *drag, double *moment, double *pressures);
+
+    /// @brief computes the coefficients at many angles of attack on the calling thread without allocating
+    /// @param solver the solver
+    /// @param alpha_degrees angles of attack in degrees
+    /// @param count angle count
+    /// @param lift receives count lift coefficients
+    /// @param drag receives count drag coefficients
+    /// @param moment receives count moment coefficients
+    /// @param pressures receives the pressure coefficient of panel i at angle k at k * panel count + i, or NULL
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_solver_polar(const airfoil_solver *solver, const double *alpha_degrees, int count, double *lift, double *drag, double *moment, double *pressures);
+
+    /// @brief computes the flow at points around the airfoil on the shared thread pool, summing the panels straight from the solver without allocating beyond the tasks queued on the pool
+    /// @param solver the solver
+    /// @param alpha_degrees angle of attack in degrees
+    /// @param x x coordinates of the points
+    /// @param y y coordinates of the points
+    /// @param count point count
+    /// @param use_treecode nonzero to sum distant panels by multipole expansions, which is faster for many points but allocates the solved panels and their expansions on each call
+    /// @param vx receives count x velocities in units of the freestream speed
+    /// @param vy receives count y velocities in units of the freestream speed
+    /// @param cp receives count pressure coefficients
+    /// @return the status
+    AIRFOIL_API airfoil_status airfoil_solver_field(const airfoil_solver *solver, double alpha_degrees, const double *x, const double *y, int count, int use_treecode, double *vx, double *vy, double *cp);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
\ No newline at end of file
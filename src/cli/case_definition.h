@@ -0,0 +1,57 @@
+#ifndef AIRFOILS_CLI_CASEDEFINITION_H_
+#define AIRFOILS_CLI_CASEDEFINITION_H_
+
+#include <string>
+#include <vector>
+
+#include "field_writer.h"
+#include "solver_options.h"
+#include "velocity_field.h"
+
+namespace cli
+{
+    /// @brief one airfoil to solve from the command line or a line of a case file
+    struct CaseDefinition
+    {
+        /// @brief identifier echoed in the result
+        std::string id;
+
+        /// @brief maximum camber as a percentage of the chord
+        double maxCamberPercent = 0.0;
+
+        /// @brief the distance of maximum camber from the leading edge in tenths of the chord
+        double maxCamberPositionPercent = 0.0;
+
+        /// @brief maximum thickness as a percentage of the chord
+        double thicknessPercent = 12.0;
+
+        /// @brief point count of the airfoil, even
+        int pointCount = 100;
+
+        /// @brief indicates if the trailing edge is closed
+        bool closedTrailingEdge = false;
+
+        /// @brief angles of attack in degrees
+        std::vector<double> angles{0.0};
+
+        /// @brief the linear solver
+        aerodynamics::SolverOptions solver;
+
+        /// @brief indicates if the result has the pressure coefficient of every panel at every angle
+        bool includePressure = false;
+
+        /// @brief polar file the result is appended to, empty for none
+        std::string polarPath;
+
+        /// @brief field file written at the first angle, empty for none
+        std::string fieldPath;
+
+        /// @brief grid of the field, by default the chord and half a chord around it
+        aerodynamics::FieldGrid fieldGrid{-0.5, -0.5, 0.01, 0.01, 200, 100};
+
+        /// @brief format and evaluation settings of the field
+        io::FieldWriterOptions field;
+    };
+} // namespace cli
+
+#endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "case_parser.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "case_definition.h"
+#include "field_writer.h"
+#include "json_value.h"
+#include "solver_options.h"
+
+using cli::CaseParser;
+
+using aerodynamics::SolverMethod;
+using cli::CaseDefinition;
+using cli::CommandLine;
+using io::FieldFormat;
+using io::JsonType;
+using io::JsonValue;
+
+namespace
+{
+    // Values of an angle range beyond which a step is treated as a typo
+    const int maxRangeAngles = 100000;
+
+    std::vector<std::string> split(const std::string &text, char separator)
+    {
+        std::vector<std::string> parts;
+        std::size_t start = 0;
+        while (true)
+        {
+            std::size_t end = text.find(separator, start);
+            parts.push_back(text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+            if (end == std::string::npos)
+                return parts;
+            start = end + 1;
+        }
+    }
+} // namespace
+
+double CaseParser::getNumber(const JsonValue &value, const std::string &key)
+{
+    if (value.getType() != JsonType::Number)
+        throw std::invalid_argument("The case key " + key + " must be a number");
+    return value.getNumber();
+}
+
+int CaseParser::getInteger(const JsonValue &value, const std::string &key)
+{
+    double number = getNumber(value, key);
+    if (number != std::floor(number) || std::abs(number) > 1e9)
+        throw std::invalid_argument("The case key " + key + " must be an integer");
+    return static_cast<int>(number);
+}
+
+std::vector<double> CaseParser::getNumbers(const JsonValue &value, const std::string &key)
+{
+    if (value.getType() == JsonType::Number)
+        return std::vector<double>{value.getNumber()};
+    if (value.getType() != JsonType::Array)
+        throw std::invalid_argument("The case key " + key + " must be a number or an array of numbers");
+    std::vector<double> numbers;
+    for (const JsonValue &element : value.getArray())
+        numbers.push_back(getNumber(element, key));
+    return numbers;
+}
+
+std::vector<double> CaseParser::getAngles(const JsonValue &value)
+{
+    if (value.getType() != JsonType::String)
+        return getNumbers(value, "alpha");
+
+    // first:last:step includes last when the steps land on it
+    std::vector<std::string> parts = split(value.getString(), ':');
+    std::vector<double> range;
+    for (const std::string &part : parts)
+    {
+        try
+        {
+            range.push_back(getNumber(JsonValue::parse(part), "alpha"));
+        }
+        catch (const std::invalid_argument &)
+        {
+            throw std::invalid_argument("The case key alpha must be numbers or a first:last:step range");
+        }
+    }
+    if (range.size() != 3 || range[2] == 0 || (range[1] - range[0]) / range[2] < 0)
+        throw std::invalid_argument("The alpha range must be first:last:step with a step toward last");
+    double steps = (range[1] - range[0]) / range[2];
+    if (steps >= maxRangeAngles)
+        throw std::invalid_argument("The alpha range has too many angles");
+    int count = static_cast<int>(std::floor(steps + 1e-9)) + 1;
+    std::vector<double> angles(count);
+    for (int k = 0; k < count; ++k)
+        angles[k] = range[0] + k * range[2];
+    return angles;
+}
+
+CaseDefinition CaseParser::parse(const JsonValue &object)
+{
+    if (object.getType() != JsonType::Object)
+        throw std::invalid_argument("The case must be a JSON object");
+
+    CaseDefinition definition;
+    for (const auto &member : object.getMembers())
+    {
+        const std::string &key = member.first;
+        const JsonValue &value = member.second;
+        if (key == "id")
+            definition.id = value.getType() == JsonType::String ? value.getString() : value.serialize();
+        else if (key == "naca")
+        {
+            std::string digits = value.getType() == JsonType::Number ? std::to_string(getInteger(value, key)) : value.getString();
+            digits.insert(0, digits.size() < 4 ? 4 - digits.size() : 0, '0');
+            if (digits.size() != 4 || digits.find_first_not_of("0123456789") != std::string::npos)
+                throw std::invalid_argument("The NACA designation must have four digits");
+            definition.maxCamberPercent = digits[0] - '0';
+            definition.maxCamberPositionPercent = 10.0 * (digits[1] - '0');
+            definition.thicknessPercent = std::stoi(digits.substr(2));
+        }
+        else if (key == "maxCamber")
+            definition.maxCamberPercent = getNumber(value, key);
+        else if (key == "camberPosition")
+            definition.maxCamberPositionPercent = getNumber(value, key);
+        else if (key == "thickness")
+            definition.thicknessPercent = getNumber(value, key);
+        else if (key == "points")
+            definition.pointCount = getInteger(value, key);
+        else if (key == "closedTrailingEdge")
+            definition.closedTrailingEdge = value.getBoolean();
+        else if (key == "alpha")
+            definition.angles = getAngles(value);
+        else if (key == "solver")
+        {
+            const std::string &name = value.getString();
+            if (name == "lu")
+                definition.solver.method = SolverMethod::LowerUpperDecomposition;
+            else if (name == "gmres")
+                definition.solver.method = SolverMethod::GMRES;
+            else if (name == "matrix-free")
+                definition.solver.method = SolverMethod::MatrixFreeGMRES;
+            else if (name == "hierarchical")
+                definition.solver.method = SolverMethod::HierarchicalGMRES;
+            else
+                throw std::invalid_argument("The solver must be lu, gmres, matrix-free, or hierarchical");
+        }
+        else if (key == "tolerance")
+            definition.solver.tolerance = getNumber(value, key);
+        else if (key == "pressure")
+            definition.includePressure = value.getBoolean();
+        else if (key == "polar")
+            definition.polarPath = value.getString();
+        else if (key == "field")
+            definition.fieldPath = value.getString();
+        else if (key == "fieldFormat")
+        {
+            const std::string &name = value.getString();
+            if (name == "raw")
+                definition.field.format = FieldFormat::Raw;
+            else if (name == "vtk")
+                definition.field.format = FieldFormat::VTK;
+            else
+                throw std::invalid_argument("The field format must be raw or vtk");
+        }
+        else if (key == "fieldGrid")
+        {
+            std::vector<double> grid = getNumbers(value, key);
+            if (grid.size() != 6 || grid[4] != std::floor(grid[4]) || grid[5] != std::floor(grid[5]))
+                throw std::invalid_argument("The field grid must be originX, originY, spacingX, spacingY, columns, and rows");
+            definition.fieldGrid.originX = grid[0];
+            definition.fieldGrid.originY = grid[1];
+            definition.fieldGrid.spacingX = grid[2];
+            definition.fieldGrid.spacingY = grid[3];
+            definition.fieldGrid.columns = grid[4];
+            definition.fieldGrid.rows = grid[5];
+        }
+        else if (key == "fieldTreecode")
+            definition.field.useTreecode = value.getBoolean();
+        else
+            throw std::invalid_argument("The case key " + key + " is not known");
+    }
+
+    if (definition.pointCount < 4 || definition.pointCount % 2 != 0)
+        throw std::invalid_argument("The point count must be even and at least 4");
+    if (definition.angles.empty())
+        throw std::invalid_argument("The case must have at least one angle of attack");
+    if (!(definition.solver.tolerance > 0))
+        throw std::invalid_argument("The tolerance must be positive");
+    return definition;
+}
+
+JsonValue CaseParser::parseFlagValue(const std::string &text)
+{
+    // comma separated numbers are an array, JSON values are parsed, and anything else is a string
+    if (text.find(',') != std::string::npos && text.find('[') == std::string::npos)
+    {
+        JsonValue values = JsonValue::array();
+        try
+        {
+            for (const std::string &part : split(text, ','))
+            {
+                JsonValue value = JsonValue::parse(part);
+                if (value.getType() != JsonType::Number)
+                    return JsonValue(text);
+                values.push(value);
+            }
+        }
+        catch (const std::invalid_argument &)
+        {
+            return JsonValue(text);
+        }
+        return values;
+    }
+    try
+    {
+        return JsonValue::parse(text);
+    }
+    catch (const std::invalid_argument &)
+    {
+        return JsonValue(text);
+    }
+}
+
+CommandLine CaseParser::parseArguments(int argumentCount, const char *const *arguments)
+{
+    CommandLine commandLine;
+    for (int i = 1; i < argumentCount; ++i)
+    {
+        std::string argument = arguments[i];
+        if (argument.size() < 3 || argument.compare(0, 2, "--") != 0)
+            throw std::invalid_argument("The argument " + argument + " is not a --flag");
+
+        std::string key;
+        for (std::size_t k = 2; k < argument.size(); ++k)
+            if (argument[k] == '-' && k + 1 < argument.size())
+                key += static_cast<char>(std::toupper(static_cast<unsigned char>(argument[++k])));
+            else
+                key += argument[k];
+        bool hasValue = i + 1 < argumentCount && std::string(arguments[i + 1]).compare(0, 2, "--") != 0;
+
+        if (key == "help")
+            commandLine.help = true;
+        else if (key == "serve")
+            commandLine.serve = true;
+        else if (key == "cases" || key == "output" || key == "socket" || key == "profile" || key == "trace")
+        {
+            if (!hasValue)
+                throw std::invalid_argument("The flag " + argument + " needs a path");
+            std::string &path = key == "cases" ? commandLine.casesPath : key == "output" ? commandLine.outputPath : key == "socket" ? commandLine.socketPath : key == "profile" ? commandLine.profilePath : commandLine.tracePath;
+            path = arguments[++i];
+            commandLine.serve = commandLine.serve || key == "socket";
+        }
+        else
+            commandLine.flags.set(key, hasValue ? parseFlagValue(arguments[++i]) : JsonValue(true));
+    }
+    return commandLine;
+}
+
+std::string CaseParser::getUsage()
+{
+    return "Usage: airfoil_cli [--cases FILE|-] [--output FILE] [--profile FILE] [--trace FILE] [case flags]\n"
+           "       airfoil_cli --serve [--socket PATH] [--profile FILE] [--trace FILE] [case flags]\n"
+           "\n"
+           "Solves NACA 4-digit airfoils without plotting and writes one JSON result per case.\n"
+           "Without --cases the flags are one case, with --cases every line of the JSON-lines file\n"
+           "is a case object whose keys override the flags. Flags are the case keys in kebab-case.\n"
+           "\n"
+           "With --serve the program keeps running and answers JSON-lines requests on standard input,\n"
+           "or on every connection of the Unix domain socket of --socket, concurrently and in completion\n"
+           "order. A request is a case object with a \"type\" of solve, polar, or field (default solve),\n"
+           "or {\"type\":\"stats\"} or {\"type\":\"shutdown\"}. Responses carry the request id, the type,\n"
+           "and the latency in seconds. The basis solutions of recent airfoils and the iterative\n"
+           "solutions stay cached between requests.\n"
+           "\n"
+           "--profile writes the timings of the solver phases and its counters as JSON on exit, and --trace\n"
+           "writes the phases as a Chrome trace-event file. Both need a build with AIRFOILS_INSTRUMENTATION.\n"
+           "\n"
+           "Case keys:\n"
+           "  id                 identifier echoed in the result\n"
+           "  naca               four-digit designation such as \"2412\"\n"
+           "  maxCamber          maximum camber in percent of the chord (default 0)\n"
+           "  camberPosition     position of maximum camber in percent of the chord (default 0)\n"
+           "  thickness          maximum thickness in percent of the chord (default 12)\n"
+           "  points             even point count (default 100)\n"
+           "  closedTrailingEdge closes the trailing edge (default false)\n"
+           "  alpha              angle, array of angles, or first:last:step range in degrees (default 0)\n"
+           "  solver             lu, gmres, matrix-free, or hierarchical (default lu)\n"
+           "  tolerance          relative residual of the iterative solvers (default 1e-10)\n"
+           "  pressure           adds the panel pressure coefficients to the result (default false)\n"
+           "  polar              binary polar file the result is appended to\n"
+           "  field              field file of the flow at the first angle\n"
+           "  fieldFormat        raw or vtk (default raw)\n"
+           "  fieldGrid          originX,originY,spacingX,spacingY,columns,rows (default -0.5,-0.5,0.01,0.01,200,100)\n"
+           "  fieldTreecode      evaluates the field with the panel treecode (default false)\n";
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef AIRFOILS_CLI_CASEPARSER_H_
+#define AIRFOILS_CLI_CASEPARSER_H_
+
+#include <string>
+#include <vector>
+
+#include "case_definition.h"
+#include "json_value.h"
+
+namespace cli
+{
+    /// @brief the program settings and the case keys of a command line
+    struct CommandLine
+    {
+        /// @brief case keys of the flags, the defaults of every line of a case file
+        io::JsonValue flags = io::JsonValue::object();
+
+        /// @brief JSON-lines case file, - for standard input, empty to solve the flags as one case
+        std::string casesPath;
+
+        /// @brief file the results are written to, empty for standard output
+        std::string outputPath;
+
+        /// @brief indicates if the usage was requested
+        bool help = false;
+
+        /// @brief indicates if requests are answered as a server over standard input and output
+        bool serve = false;
+
+        /// @brief Unix domain socket a server listens on, empty for standard input and output
+        std::string socketPath;
+
+        /// @brief file the profiler report is written to on exit, empty to leave the profiler off
+        std::string profilePath;
+
+        /// @brief Chrome trace-event file of the profiled phases, empty to leave the profiler off
+        std::string tracePath;
+    };
+
+    /// @brief reads case definitions from JSON objects and command-line flags
+    class CaseParser
+    {
+    private:
+        static double getNumber(const io::JsonValue &value, const std::string &key);
+        static int getInteger(const io::JsonValue &value, const std::string &key);
+        static std::vector<double> getNumbers(const io::JsonValue &value, const std::string &key);
+        static std::vector<double> getAngles(const io::JsonValue &value);
+        static io::JsonValue parseFlagValue(const std::string &text);
+
+    public:
+        /// @brief reads a case from an object of case keys, which are listed by getUsage
+        /// @param object the case keys
+        /// @return the case
+        static cli::CaseDefinition parse(const io::JsonValue &object);
+
+        /// @brief reads flags of the form --key value or --key, where kebab-case keys become camelCase case keys and a key without a value is true
+        /// @param argumentCount argc
+        /// @param arguments argv, the program name first
+        /// @return the command line
+        static cli::CommandLine parseArguments(int argumentCount, const char *const *arguments);
+
+        /// @brief gets the help text of the command line and case keys
+        /// @return the usage
+        static std::string getUsage();
+    };
+} // namespace cli
+
+#endif
\ No newline at end of file
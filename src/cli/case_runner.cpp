@@ -0,0 +1,102 @@
+#include "case_runner.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "airfoil.h"
+#include "case_definition.h"
+#include "field_writer.h"
+#include "gmres.h"
+#include "json_value.h"
+#include "naca_sweep.h"
+#include "panel_methods.h"
+#include "polar.h"
+#include "polar_files.h"
+#include "solver_options.h"
+#include "source_vortex_basis.h"
+
+using cli::CaseRunner;
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using aerodynamics::Polar;
+using aerodynamics::SolverMethod;
+using aerodynamics::SourceVortexBasis;
+using aerodynamics::SweepCase;
+using cli::CaseDefinition;
+using cli::PolarFiles;
+using io::FieldWriter;
+using io::JsonValue;
+using linear_algebra::SolverReport;
+
+Polar CaseRunner::computePolar(const CaseDefinition &definition, const SourceVortexBasis *basis, int &iterations)
+{
+    iterations = 0;
+    // the direct solver combines two basis solutions for every angle, the iterative solvers solve each angle
+    if (definition.solver.method == SolverMethod::LowerUpperDecomposition && basis != nullptr)
+        return PanelMethods::computePolar(*basis, definition.angles, definition.includePressure);
+    Airfoil airfoil = Airfoil::getNACA4Airfoil(definition.pointCount, definition.maxCamberPercent, definition.maxCamberPositionPercent, definition.thicknessPercent, definition.closedTrailingEdge, 0.0);
+    if (definition.solver.method == SolverMethod::LowerUpperDecomposition)
+        return PanelMethods::computePolar(airfoil, definition.angles, definition.includePressure);
+
+    int count = definition.angles.size();
+    int panelCount = definition.includePressure ? airfoil.size() : 0;
+    Polar polar{definition.angles, std::vector<double>(count), std::vector<double>(count), std::vector<double>(count), panelCount, std::vector<double>(static_cast<std::size_t>(count) * panelCount)};
+    for (int k = 0; k < count; ++k)
+    {
+        SolverReport report;
+        Airfoil solved = PanelMethods::computeSourceVortex(airfoil, definition.angles[k], definition.solver, &report);
+        iterations += report.iterations;
+        polar.lift[k] = solved.getCoefficientOfLift();
+        polar.drag[k] = solved.getCoefficientOfDrag();
+        polar.moment[k] = solved.getCoefficientOfMoment();
+        for (int i = 0; i < panelCount; i++)
+            polar.pressure[static_cast<std::size_t>(k) * panelCount + i] = solved[i].coefficientOfPressure;
+    }
+    return polar;
+}
+
+JsonValue CaseRunner::run(const CaseDefinition &definition, int index, PolarFiles &polarFiles, const SourceVortexBasis *basis)
+{
+    auto start = std::chrono::steady_clock::now();
+    int iterations;
+    Polar polar = computePolar(definition, basis, iterations);
+
+    if (!definition.polarPath.empty())
+        polarFiles.append(definition.polarPath, SweepCase{index, definition.maxCamberPercent, definition.maxCamberPositionPercent, definition.thicknessPercent, definition.pointCount, polar});
+    if (!definition.fieldPath.empty())
+    {
+        bool combine = definition.solver.method == SolverMethod::LowerUpperDecomposition && basis != nullptr;
+        Airfoil solved = combine ? PanelMethods::computeSourceVortex(*basis, definition.angles.front())
+                                 : PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(definition.pointCount, definition.maxCamberPercent, definition.maxCamberPositionPercent, definition.thicknessPercent, definition.closedTrailingEdge, 0.0), definition.angles.front(), definition.solver);
+        FieldWriter::write(solved.getRotatedPanels(), definition.fieldGrid, definition.fieldPath, definition.field);
+    }
+
+    JsonValue result = JsonValue::object();
+    if (!definition.id.empty())
+        result.set("id", definition.id);
+    result.set("maxCamber", definition.maxCamberPercent);
+    result.set("camberPosition", definition.maxCamberPositionPercent);
+    result.set("thickness", definition.thicknessPercent);
+    result.set("points", definition.pointCount);
+    result.set("alpha", polar.angles);
+    result.set("cl", polar.lift);
+    result.set("cd", polar.drag);
+    result.set("cm", polar.moment);
+    if (polar.panelCount > 0)
+    {
+        JsonValue pressure = JsonValue::array();
+        for (int k = 0; k < polar.angles.size(); ++k)
+        {
+            auto first = polar.pressure.begin() + static_cast<std::size_t>(k) * polar.panelCount;
+            pressure.push(JsonValue(std::vector<double>(first, first + polar.panelCount)));
+        }
+        result.set("cp", pressure);
+    }
+    if (definition.solver.method != SolverMethod::LowerUpperDecomposition)
+        result.set("iterations", iterations);
+    result.set("seconds", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef AIRFOILS_CLI_CASERUNNER_H_
+#define AIRFOILS_CLI_CASERUNNER_H_
+
+#include "case_definition.h"
+#include "json_value.h"
+#include "polar.h"
+#include "polar_files.h"
+#include "source_vortex_basis.h"
+
+namespace cli
+{
+    /// @brief solves case definitions and writes their files
+    class CaseRunner
+    {
+    private:
+        static aerodynamics::Polar computePolar(const cli::CaseDefinition &definition, const aerodynamics::SourceVortexBasis *basis, int &iterations);
+
+    public:
+        /// @brief solves the polar of a case, appends it to the polar file, and writes the field file of its first angle
+        /// @param definition the case
+        /// @param index position of the case in its batch, stored in the polar file
+        /// @param polarFiles open polar files of the batch, the case polar is appended to the one at its polar path
+        /// @param basis basis solutions of the case airfoil that the direct solver combines instead of solving, null to solve them
+        /// @return the result with the id, airfoil, coefficients of every angle, solver iterations, and the wall time in seconds
+        static io::JsonValue run(const cli::CaseDefinition &definition, int index, cli::PolarFiles &polarFiles, const aerodynamics::SourceVortexBasis *basis = nullptr);
+    };
+} // namespace cli
+
+#endif
\ No newline at end of file
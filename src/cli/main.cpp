@@ -0,0 +1,177 @@
+#include <csignal>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+#include "case_parser.h"
+#include "case_runner.h"
+#include "json_value.h"
+#include "polar_files.h"
+#include "profiler.h"
+#include "solver_server.h"
+
+using cli::CaseParser;
+using cli::CaseRunner;
+using cli::CommandLine;
+using cli::PolarFiles;
+using cli::ServerOptions;
+using cli::SolverServer;
+using instrumentation::Profiler;
+using io::JsonValue;
+
+namespace
+{
+    /// @brief answers requests until the input ends or a shutdown request, and on a socket also until SIGINT or SIGTERM
+    int serve(const CommandLine &commandLine)
+    {
+        ServerOptions options;
+        options.defaults = commandLine.flags;
+        try
+        {
+            if (commandLine.socketPath.empty())
+            {
+                SolverServer server(options);
+                server.serve(std::cin, std::cout);
+                return 0;
+            }
+
+            // the signals are taken by a thread that stops the server, so requests in flight still get their responses
+            sigset_t signals;
+            sigemptyset(&signals);
+            sigaddset(&signals, SIGINT);
+            sigaddset(&signals, SIGTERM);
+            pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+            static SolverServer server(options);
+            std::thread([signals]
+                        {
+                int signal;
+                if (sigwait(&signals, &signal) == 0)
+                    server.stop(); })
+                .detach();
+            server.listen(commandLine.socketPath);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+            return 2;
+        }
+        return 0;
+    }
+
+    /// @brief writes the profiler report and trace that were requested
+    int writeProfile(const CommandLine &commandLine, int status)
+    {
+        try
+        {
+            if (!commandLine.profilePath.empty())
+                Profiler::writeReport(commandLine.profilePath);
+            if (!commandLine.tracePath.empty())
+                Profiler::writeChromeTrace(commandLine.tracePath);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+            return 2;
+        }
+        return status;
+    }
+} // namespace
+
+/// @brief Solves airfoil cases from flags or a JSON-lines case file and writes one JSON result line per case, without plotting
+int main(int argc, char **argv)
+{
+    CommandLine commandLine;
+    try
+    {
+        commandLine = CaseParser::parseArguments(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n\n"
+                  << CaseParser::getUsage();
+        return 2;
+    }
+    if (commandLine.help)
+    {
+        std::cout << CaseParser::getUsage();
+        return 0;
+    }
+    if (!commandLine.profilePath.empty() || !commandLine.tracePath.empty())
+    {
+        if (!Profiler::isCompiledIn())
+            std::cerr << "The solver was built without AIRFOILS_INSTRUMENTATION, so the profile only has empty timers\n";
+        Profiler::setEnabled(true);
+    }
+    if (commandLine.serve)
+        return writeProfile(commandLine, serve(commandLine));
+
+    std::ofstream outputFile;
+    if (!commandLine.outputPath.empty())
+    {
+        outputFile.open(commandLine.outputPath);
+        if (!outputFile)
+        {
+            std::cerr << "The output file " << commandLine.outputPath << " could not be opened\n";
+            return 2;
+        }
+    }
+    std::ostream &output = commandLine.outputPath.empty() ? std::cout : outputFile;
+
+    // every case is written as soon as it is solved, so long case files stream their results
+    int index = 0;
+    int failures = 0;
+    PolarFiles polarFiles;
+    auto runCase = [&](const std::string *line)
+    {
+        JsonValue keys = commandLine.flags;
+        JsonValue result;
+        try
+        {
+            if (line != nullptr)
+            {
+                JsonValue lineKeys = JsonValue::parse(*line);
+                for (const auto &member : lineKeys.getMembers())
+                    keys.set(member.first, member.second);
+            }
+            result = CaseRunner::run(CaseParser::parse(keys), index, polarFiles);
+        }
+        catch (const std::exception &e)
+        {
+            result = JsonValue::object();
+            const JsonValue *id = keys.find("id");
+            if (id != nullptr)
+                result.set("id", *id);
+            result.set("error", e.what());
+            failures++;
+        }
+        output << result.serialize() << '\n'
+               << std::flush;
+        index++;
+    };
+
+    if (commandLine.casesPath.empty())
+        runCase(nullptr);
+    else
+    {
+        std::ifstream casesFile;
+        if (commandLine.casesPath != "-")
+        {
+            casesFile.open(commandLine.casesPath);
+            if (!casesFile)
+            {
+                std::cerr << "The case file " << commandLine.casesPath << " could not be opened\n";
+                return 2;
+            }
+        }
+        std::istream &cases = commandLine.casesPath == "-" ? std::cin : casesFile;
+        std::string line;
+        while (std::getline(cases, line))
+            if (line.find_first_not_of(" \t\r") != std::string::npos)
+                runCase(&line);
+    }
+    return writeProfile(commandLine, failures > 0 ? 1 : 0);
+}
\ No newline at end of file
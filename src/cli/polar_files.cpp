@@ -0,0 +1,39 @@
+#include "polar_files.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "naca_sweep.h"
+#include "polar_file.h"
+
+using cli::PolarFiles;
+
+using aerodynamics::SweepCase;
+using io::PolarWriter;
+
+void PolarFiles::append(const std::string &path, const SweepCase &sweepCase)
+{
+    // appends of concurrent cases are serialized, so the blocks of a shared polar file do not interleave
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::unique_ptr<PolarWriter> &writer = mWriters[path];
+    if (!writer)
+    {
+        try
+        {
+            writer.reset(new PolarWriter(path));
+        }
+        catch (...)
+        {
+            mWriters.erase(path);
+            throw;
+        }
+    }
+    writer->append(sweepCase);
+}
+
+int PolarFiles::fileCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mWriters.size();
+}
\ No newline at end of file
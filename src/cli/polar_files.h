@@ -0,0 +1,38 @@
+#ifndef AIRFOILS_CLI_POLARFILES_H_
+#define AIRFOILS_CLI_POLARFILES_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "naca_sweep.h"
+#include "polar_file.h"
+
+namespace cli
+{
+    /// @brief the polar files of a batch or server, each opened and checked once and then appended to by every case that names it
+    class PolarFiles
+    {
+    private:
+        std::mutex mMutex;
+        std::map<std::string, std::unique_ptr<io::PolarWriter>> mWriters;
+
+    public:
+        PolarFiles() = default;
+
+        PolarFiles(const PolarFiles &) = delete;
+        PolarFiles &operator=(const PolarFiles &) = delete;
+
+        /// @brief appends a case to a polar file, opening the file on its first case, safe to call from any thread
+        /// @param path polar file
+        /// @param sweepCase the case and its polar
+        void append(const std::string &path, const aerodynamics::SweepCase &sweepCase);
+
+        /// @brief gets the number of open polar files
+        /// @return distinct paths appended to
+        int fileCount();
+    };
+} // namespace cli
+
+#endif
\ No newline at end of file
@@ -0,0 +1,452 @@
+#include "solver_server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "airfoil.h"
+#include "case_definition.h"
+#include "case_parser.h"
+#include "case_runner.h"
+#include "json_value.h"
+#include "panel_methods.h"
+#include "polar_files.h"
+#include "profiler.h"
+#include "solution_cache.h"
+#include "solver_options.h"
+#include "source_vortex_basis.h"
+#include "thread_pool.h"
+
+using cli::SolverServer;
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using aerodynamics::SolutionCache;
+using aerodynamics::SolverMethod;
+using aerodynamics::SourceVortexBasis;
+using cli::CaseDefinition;
+using cli::CaseParser;
+using cli::CaseRunner;
+using cli::ServerOptions;
+using concurrency::ThreadPool;
+using instrumentation::Profiler;
+using io::JsonType;
+using io::JsonValue;
+
+namespace
+{
+    // Bytes read from a connection at once
+    const std::size_t readChunkBytes = 1 << 16;
+
+    // Longest request line, a connection that exceeds it is closed
+    const std::size_t maxRequestBytes = std::size_t(64) << 20;
+
+    /// @brief a client connection, closed once the reader and every response of its requests are done
+    struct Connection
+    {
+        int descriptor;
+        std::mutex mutex;
+
+        Connection(int descriptor) : descriptor(descriptor){};
+        ~Connection() { ::close(descriptor); };
+
+        /// @brief writes one response line, a client that went away is ignored
+        void send(const std::string &text)
+        {
+            std::string line = text + '\n';
+            std::lock_guard<std::mutex> lock(mutex);
+            std::size_t sent = 0;
+            while (sent < line.size())
+            {
+                ssize_t count = ::send(descriptor, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count <= 0)
+                    return;
+                sent += count;
+            }
+        }
+    };
+
+    bool isBlank(const std::string &line)
+    {
+        return line.find_first_not_of(" \t\r") == std::string::npos;
+    }
+
+    /// @brief parses a request line once, for both dispatching and answering it
+    /// @param line the request JSON
+    /// @param request receives the request, left null when the line is not JSON
+    /// @return the parse error to answer the request with, or null
+    std::exception_ptr parseRequest(const std::string &line, JsonValue &request)
+    {
+        try
+        {
+            request = JsonValue::parse(line);
+        }
+        catch (const std::exception &)
+        {
+            return std::current_exception();
+        }
+        return nullptr;
+    }
+
+    /// @brief gets the type of a parsed request, solve when it has none and empty when it is not an object
+    std::string getRequestType(const JsonValue &request)
+    {
+        if (request.getType() != JsonType::Object)
+            return "";
+        const JsonValue *type = request.find("type");
+        if (type == nullptr)
+            return "solve";
+        if (type->getType() == JsonType::String)
+            return type->getString();
+        return "";
+    }
+} // namespace
+
+SolverServer::SolverServer(const ServerOptions &options)
+    : mOptions(options), mBasisHits(0), mBasisMisses(0), mRequests(0), mErrors(0), mLatencySum(0.0), mLatencyMax(0.0), mPending(0), mConnections(0), mStopping(false), mListener(-1), mNextIndex(0)
+{
+    if (options.basisCapacity < 1)
+        throw std::invalid_argument("The basis capacity must be at least one");
+    if (options.defaults.getType() != JsonType::Object)
+        throw std::invalid_argument("The default case keys must be an object");
+
+    mSolutionCache = std::make_shared<SolutionCache>(options.solutionCacheBytes);
+    mPreviousCache = PanelMethods::getSolutionCache();
+    PanelMethods::setSolutionCache(mSolutionCache);
+}
+
+SolverServer::~SolverServer()
+{
+    stop();
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdle.wait(lock, [this]
+                   { return mPending == 0 && mConnections == 0; });
+    }
+    PanelMethods::setSolutionCache(mPreviousCache);
+}
+
+std::shared_ptr<const SourceVortexBasis> SolverServer::getBasis(const CaseDefinition &definition)
+{
+    // concurrent requests for an airfoil that is not cached wait on the one solving it
+    std::string key = JsonValue(std::vector<double>{definition.maxCamberPercent, definition.maxCamberPositionPercent, definition.thicknessPercent, static_cast<double>(definition.pointCount), definition.closedTrailingEdge ? 1.0 : 0.0}).serialize();
+    std::promise<std::shared_ptr<const SourceVortexBasis>> promise;
+    std::shared_future<std::shared_ptr<const SourceVortexBasis>> basis;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mBasisIndex.find(key);
+        if (found != mBasisIndex.end())
+        {
+            mBasisHits++;
+            mBases.splice(mBases.end(), mBases, found->second);
+            basis = found->second->basis;
+        }
+        else
+        {
+            mBasisMisses++;
+            mBases.push_back(BasisEntry{key, promise.get_future().share()});
+            mBasisIndex[key] = std::prev(mBases.end());
+            while (mBases.size() > static_cast<std::size_t>(mOptions.basisCapacity))
+            {
+                mBasisIndex.erase(mBases.front().key);
+                mBases.pop_front();
+            }
+        }
+    }
+    if (basis.valid())
+        return basis.get();
+
+    try
+    {
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(definition.pointCount, definition.maxCamberPercent, definition.maxCamberPositionPercent, definition.thicknessPercent, definition.closedTrailingEdge, 0.0);
+        std::shared_ptr<const SourceVortexBasis> solved = std::make_shared<const SourceVortexBasis>(PanelMethods::computeSourceVortexBasis(airfoil));
+        promise.set_value(solved);
+        return solved;
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mBasisIndex.find(key);
+        if (found != mBasisIndex.end())
+        {
+            mBases.erase(found->second);
+            mBasisIndex.erase(found);
+        }
+        throw;
+    }
+}
+
+JsonValue SolverServer::getStatistics()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    JsonValue statistics = JsonValue::object();
+    statistics.set("requests", static_cast<double>(mRequests));
+    statistics.set("errors", static_cast<double>(mErrors));
+    statistics.set("pending", mPending);
+    statistics.set("connections", mConnections);
+    statistics.set("basisEntries", static_cast<int>(mBases.size()));
+    statistics.set("basisHits", static_cast<double>(mBasisHits));
+    statistics.set("basisMisses", static_cast<double>(mBasisMisses));
+    statistics.set("solutionHits", static_cast<double>(mSolutionCache->hitCount()));
+    statistics.set("solutionMisses", static_cast<double>(mSolutionCache->missCount()));
+    statistics.set("meanLatency", mRequests > 0 ? mLatencySum / mRequests : 0.0);
+    statistics.set("maxLatency", mLatencyMax);
+    statistics.set("threads", ThreadPool::shared().threadCount());
+    if (Profiler::isEnabled())
+        statistics.set("profile", Profiler::getReport());
+    return statistics;
+}
+
+JsonValue SolverServer::handle(const std::string &line, std::chrono::steady_clock::time_point received)
+{
+    JsonValue request;
+    std::exception_ptr parseFailure = parseRequest(line, request);
+    return handle(request, parseFailure, received, mNextIndex++);
+}
+
+JsonValue SolverServer::handle(const JsonValue &request, std::exception_ptr parseFailure, std::chrono::steady_clock::time_point received, int index)
+{
+    JsonValue response;
+    JsonValue id;
+    std::string type = "solve";
+    bool failed = false;
+    try
+    {
+        if (parseFailure != nullptr)
+            std::rethrow_exception(parseFailure);
+        if (request.getType() != JsonType::Object)
+            throw std::invalid_argument("The request must be a JSON object");
+        JsonValue keys = mOptions.defaults;
+        for (const auto &member : request.getMembers())
+            if (member.first == "type")
+                type = member.second.getString();
+            else
+            {
+                if (member.first == "id")
+                    id = member.second;
+                keys.set(member.first, member.second);
+            }
+
+        if (type == "stats")
+            response = getStatistics();
+        else if (type == "shutdown")
+        {
+            stop();
+            response = JsonValue::object();
+        }
+        else if (type == "solve" || type == "polar" || type == "field")
+        {
+            CaseDefinition definition = CaseParser::parse(keys);
+            if (type == "polar" && definition.polarPath.empty())
+                throw std::invalid_argument("The polar request needs a polar path");
+            if (type == "field" && definition.fieldPath.empty())
+                throw std::invalid_argument("The field request needs a field path");
+            std::shared_ptr<const SourceVortexBasis> basis;
+            if (definition.solver.method == SolverMethod::LowerUpperDecomposition)
+                basis = getBasis(definition);
+            response = CaseRunner::run(definition, index, mPolarFiles, basis.get());
+        }
+        else
+            throw std::invalid_argument("The request type must be solve, polar, field, stats, or shutdown");
+    }
+    catch (const std::exception &e)
+    {
+        response = JsonValue::object();
+        if (id.getType() != JsonType::Null)
+            response.set("id", id);
+        response.set("error", e.what());
+        failed = true;
+    }
+
+    if (id.getType() != JsonType::Null && response.find("id") == nullptr)
+        response.set("id", id);
+    response.set("type", type);
+    double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - received).count();
+    response.set("latency", latency);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRequests++;
+    if (failed)
+        mErrors++;
+    mLatencySum += latency;
+    mLatencyMax = std::max(mLatencyMax, latency);
+    return response;
+}
+
+bool SolverServer::dispatch(const std::string &line, const std::function<void(const std::string &)> &respond)
+{
+    std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now();
+    // the index is reserved in arrival order, and control requests are answered before the next line is read
+    int index = mNextIndex++;
+    JsonValue request;
+    std::exception_ptr parseFailure = parseRequest(line, request);
+    std::string type = getRequestType(request);
+    if (type == "stats" || type == "shutdown")
+    {
+        respond(handle(request, parseFailure, received, index).serialize());
+        return type != "shutdown";
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending++;
+    }
+    ThreadPool::shared().submit([this, request = std::move(request), parseFailure, respond, received, index]
+                                {
+        try
+        {
+            respond(handle(request, parseFailure, received, index).serialize());
+        }
+        catch (...)
+        {
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending--;
+        mIdle.notify_all(); });
+    return true;
+}
+
+void SolverServer::serve(std::istream &input, std::ostream &output)
+{
+    std::mutex outputMutex;
+    auto respond = [&output, &outputMutex](const std::string &text)
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        output << text << '\n'
+               << std::flush;
+    };
+    std::string line;
+    while (!mStopping && std::getline(input, line))
+        if (!isBlank(line) && !dispatch(line, respond))
+            break;
+
+    // the responses reference this frame, so every request finishes before it returns
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this]
+               { return mPending == 0; });
+}
+
+void SolverServer::serveConnection(int descriptor)
+{
+    std::shared_ptr<Connection> connection = std::make_shared<Connection>(descriptor);
+    auto respond = [connection](const std::string &text)
+    { connection->send(text); };
+    std::vector<char> chunk(readChunkBytes);
+    std::string buffer;
+    while (!mStopping)
+    {
+        ssize_t count = ::read(descriptor, chunk.data(), chunk.size());
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            break;
+        buffer.append(chunk.data(), count);
+        std::size_t start = 0;
+        bool reading = true;
+        for (std::size_t end = buffer.find('\n'); reading && end != std::string::npos; end = buffer.find('\n', start))
+        {
+            std::string line = buffer.substr(start, end - start);
+            reading = isBlank(line) || dispatch(line, respond);
+            start = end + 1;
+        }
+        if (!reading)
+            break;
+        buffer.erase(0, start);
+        if (buffer.size() > maxRequestBytes)
+        {
+            respond("{\"error\":\"The request is too long\"}");
+            break;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDescriptors.erase(descriptor);
+}
+
+void SolverServer::listen(const std::string &socketPath)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+        throw std::invalid_argument("The socket path must be between 1 and 107 characters");
+    struct stat status;
+    if (::lstat(socketPath.c_str(), &status) == 0)
+    {
+        if (!S_ISSOCK(status.st_mode))
+            throw std::invalid_argument("The socket path exists and is not a socket");
+        ::unlink(socketPath.c_str());
+    }
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+        throw std::runtime_error("The socket could not be created");
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+        ::close(listener);
+        throw std::runtime_error("The socket could not be bound to " + socketPath);
+    }
+    mListener = listener;
+
+    while (!mStopping)
+    {
+        int descriptor = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (descriptor < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mConnections++;
+            mDescriptors.insert(descriptor);
+        }
+        std::thread([this, descriptor]
+                    {
+            serveConnection(descriptor);
+            std::lock_guard<std::mutex> lock(mMutex);
+            mConnections--;
+            mIdle.notify_all(); })
+            .detach();
+    }
+    mListener = -1;
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+
+    // ending the reads of every connection lets their readers return once the responses are written
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (int descriptor : mDescriptors)
+        ::shutdown(descriptor, SHUT_RD);
+    mIdle.wait(lock, [this]
+               { return mPending == 0 && mConnections == 0; });
+}
+
+void SolverServer::stop()
+{
+    mStopping = true;
+    int listener = mListener.load();
+    if (listener >= 0)
+        ::shutdown(listener, SHUT_RDWR);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef AIRFOILS_CLI_SOLVERSERVER_H_
+#define AIRFOILS_CLI_SOLVERSERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "case_definition.h"
+#include "json_value.h"
+#include "polar_files.h"
+#include "solution_cache.h"
+#include "source_vortex_basis.h"
+
+namespace cli
+{
+    /// @brief settings of a solver server
+    struct ServerOptions
+    {
+        /// @brief case keys every request starts from
+        io::JsonValue defaults = io::JsonValue::object();
+
+        /// @brief airfoils whose basis solutions are kept for the direct solver
+        int basisCapacity = 64;
+
+        /// @brief memory of the solution cache of the iterative solvers
+        std::size_t solutionCacheBytes = std::size_t(256) << 20;
+    };
+
+    /// @brief a long-running solver that answers JSON-lines requests over standard streams or a Unix domain socket,
+    /// running them concurrently on the shared thread pool with the basis solutions of recent airfoils and a solution cache kept warm
+    class SolverServer
+    {
+    private:
+        struct BasisEntry
+        {
+            std::string key;
+            std::shared_future<std::shared_ptr<const aerodynamics::SourceVortexBasis>> basis;
+        };
+
+        ServerOptions mOptions;
+        cli::PolarFiles mPolarFiles;
+        std::shared_ptr<aerodynamics::SolutionCache> mSolutionCache, mPreviousCache;
+        std::list<BasisEntry> mBases;
+        std::unordered_map<std::string, std::list<BasisEntry>::iterator> mBasisIndex;
+        std::size_t mBasisHits, mBasisMisses, mRequests, mErrors;
+        double mLatencySum, mLatencyMax;
+        std::mutex mMutex;
+        std::condition_variable mIdle;
+        int mPending, mConnections;
+        std::set<int> mDescriptors;
+        std::atomic<bool> mStopping;
+        std::atomic<int> mListener;
+        std::atomic<int> mNextIndex;
+
+        std::shared_ptr<const aerodynamics::SourceVortexBasis> getBasis(const cli::CaseDefinition &definition);
+        io::JsonValue getStatistics();
+        io::JsonValue handle(const io::JsonValue &request, std::exception_ptr parseFailure, std::chrono::steady_clock::time_point received, int index);
+        bool dispatch(const std::string &line, const std::function<void(const std::string &)> &respond);
+        void serveConnection(int descriptor);
+
+    public:
+        /// @brief starts with empty caches and installs the solution cache for PanelMethods
+        /// @param options server settings
+        SolverServer(const cli::ServerOptions &options = cli::ServerOptions());
+
+        /// @brief waits for running requests and restores the previous solution cache
+        ~SolverServer();
+
+        SolverServer(const SolverServer &) = delete;
+        SolverServer &operator=(const SolverServer &) = delete;
+
+        /// @brief answers one request, a case object with a type of solve, polar, or field, or a type of stats or shutdown
+        /// @param line the request JSON
+        /// @param received when the request arrived, the start of its latency
+        /// @return the response, the case result or an error with the request id, the type, and the latency in seconds
+        io::JsonValue handle(const std::string &line, std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now());
+
+        /// @brief answers each line of input as it arrives, writing responses in completion order, until the input ends or a shutdown request
+        /// @param input request lines
+        /// @param output response lines
+        void serve(std::istream &input, std::ostream &output);
+
+        /// @brief accepts connections on a Unix domain socket and answers the request lines of each, until stop or a shutdown request
+        /// @param socketPath socket file, a stale socket there is replaced
+        void listen(const std::string &socketPath);
+
+        /// @brief stops serving, safe to call from any thread
+        void stop();
+    };
+} // namespace cli
+
+#endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+using concurrency::ThreadPool;
+
+namespace
+{
+    std::mutex sharedMutex;
+    std::unique_ptr<ThreadPool> sharedPool;
+
+    // The pool and deque of the worker running on this thread
+    thread_local const ThreadPool *currentPool = nullptr;
+    thread_local int currentWorker = 0;
+
+    /// @brief the progress of one parallelFor, shared with helper tasks that may start after the loop has returned
+    struct LoopState
+    {
+        std::atomic<int> next;
+        int end, grain, chunkCount;
+        std::function<void(int, int)> body;
+        std::mutex mutex;
+        std::condition_variable done;
+        int completed = 0;
+        std::exception_ptr error;
+
+        LoopState(int begin, int end, int grain, const std::function<void(int, int)> &body)
+            : next(begin), end(end), grain(grain), chunkCount((end - begin + grain - 1) / grain), body(body){};
+
+        /// @brief claims and runs chunks until none are left
+        void run()
+        {
+            int finished = 0;
+            std::exception_ptr thrown;
+            for (int chunkBegin = next.fetch_add(grain); chunkBegin < end; chunkBegin = next.fetch_add(grain))
+            {
+                try
+                {
+                    body(chunkBegin, std::min(chunkBegin + grain, end));
+                }
+                catch (...)
+                {
+                    if (!thrown)
+                        thrown = std::current_exception();
+                }
+                finished++;
+            }
+            if (finished == 0)
+                return;
+            std::lock_guard<std::mutex> lock(mutex);
+            if (thrown && !error)
+                error = thrown;
+            completed += finished;
+            if (completed == chunkCount)
+                done.notify_all();
+        }
+    };
+} // namespace
+
+ThreadPool::ThreadPool(int threadCount) : mQueuedCount(0), mNextQueue(0), mStopping(false)
+{
+    if (threadCount < 1)
+        throw std::invalid_argument("The thread count must be at least one");
+    mQueues.reserve(threadCount - 1);
+    for (int i = 0; i < threadCount - 1; ++i)
+        mQueues.emplace_back(new TaskQueue());
+    mWorkers.reserve(threadCount - 1);
+    for (int i = 0; i < threadCount - 1; ++i)
+        mWorkers.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mTaskAvailable.notify_all();
+    for (std::thread &worker : mWorkers)
+        worker.join();
+}
+
+bool ThreadPool::runTask(int worker)
+{
+    // the newest task of the own deque keeps nested work hot in cache, the oldest task of a victim is the largest left
+    std::function<void()> task;
+    int queueCount = mQueues.size();
+    for (int k = 0; k < queueCount && !task; ++k)
+    {
+        TaskQueue &queue = *mQueues[(worker + k) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (k == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        mQueuedCount--;
+    }
+    if (!task)
+        return false;
+    task();
+    return true;
+}
+
+void ThreadPool::work(int worker)
+{
+    currentPool = this;
+    currentWorker = worker;
+    while (true)
+    {
+        if (runTask(worker))
+            continue;
+        std::unique_lock<std::mutex> lock(mMutex);
+        mTaskAvailable.wait(lock, [this]
+                            { return mStopping || mQueuedCount > 0; });
+        if (mStopping && mQueuedCount == 0)
+            return;
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    if (mWorkers.empty())
+    {
+        task();
+        return;
+    }
+    int worker = currentPool == this ? currentWorker : mNextQueue++ % mQueues.size();
+    {
+        std::lock_guard<std::mutex> lock(mQueues[worker]->mutex);
+        mQueues[worker]->tasks.push_back(std::move(task));
+        mQueuedCount++;
+    }
+    // taking the mutex orders the count with a worker that is about to wait
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+    }
+    mTaskAvailable.notify_one();
+}
+
+void ThreadPool::parallelFor(int begin, int end, int grain, const std::function<void(int, int)> &body)
+{
+    if (grain < 1)
+        throw std::invalid_argument("The grain must be at least one");
+    if (begin >= end)
+        return;
+    int chunkCount = (end - begin + grain - 1) / grain;
+    if (chunkCount == 1 || mWorkers.empty())
+    {
+        for (int chunkBegin = begin; chunkBegin < end; chunkBegin += grain)
+            body(chunkBegin, std::min(chunkBegin + grain, end));
+        return;
+    }
+
+    // The caller only waits for chunks another thread has already claimed and is running,
+    // so helpers still queued behind busy workers (or nested loops) cannot deadlock it
+    std::shared_ptr<LoopState> state = std::make_shared<LoopState>(begin, end, grain, body);
+    int helperCount = std::min<int>(mWorkers.size(), chunkCount - 1);
+    for (int i = 0; i < helperCount; ++i)
+        submit([state]
+               { state->run(); });
+    state->run();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]
+                     { return state->completed == state->chunkCount; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+int ThreadPool::defaultThreadCount()
+{
+    return std::max<int>(1, std::thread::hardware_concurrency());
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (!sharedPool)
+        sharedPool.reset(new ThreadPool());
+    return *sharedPool;
+}
+
+void ThreadPool::setSharedThreadCount(int threadCount)
+{
+    std::unique_ptr<ThreadPool> pool(new ThreadPool(threadCount));
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedPool.swap(pool);
+}
\ No newline at end of file
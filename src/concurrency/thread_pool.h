@@ -0,0 +1,76 @@
+#ifndef AIRFOILS_CONCURRENCY_THREADPOOL_H_
+#define AIRFOILS_CONCURRENCY_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace concurrency
+{
+    /// @brief a fixed set of worker threads with one task deque each, where a worker runs its newest task first and an idle worker steals the oldest task of another, and the calling thread also takes part in parallelFor
+    class ThreadPool
+    {
+    private:
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::thread> mWorkers;
+        std::vector<std::unique_ptr<TaskQueue>> mQueues;
+        std::atomic<int> mQueuedCount;
+        std::atomic<unsigned> mNextQueue;
+        std::mutex mMutex;
+        std::condition_variable mTaskAvailable;
+        bool mStopping;
+
+        bool runTask(int worker);
+        void work(int worker);
+
+    public:
+        /// @brief starts threadCount - 1 workers so that together with the calling thread threadCount threads run a loop
+        /// @param threadCount total thread count, at least one
+        ThreadPool(int threadCount = defaultThreadCount());
+
+        /// @brief finishes the queued tasks and joins the workers
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /// @brief gets the total thread count including the calling thread
+        /// @return worker count plus one
+        inline int threadCount() const { return mWorkers.size() + 1; };
+
+        /// @brief queues a task on the deque of the calling worker, or of the next worker in turn for other threads, or runs it immediately when the pool has no workers
+        /// @param task task to run
+        void submit(std::function<void()> task);
+
+        /// @brief runs body(chunkBegin, chunkEnd) over consecutive chunks of [begin, end) on the workers and the calling thread, returning when every chunk is done
+        /// @param begin first index
+        /// @param end one past the last index
+        /// @param grain indices per chunk, at least one
+        /// @param body function of a chunk, the first exception thrown by any chunk is rethrown on the calling thread
+        void parallelFor(int begin, int end, int grain, const std::function<void(int, int)> &body);
+
+        /// @brief gets the hardware thread count, or one when it is unknown
+        /// @return default thread count
+        static int defaultThreadCount();
+
+        /// @brief gets the project-wide pool, created with setSharedThreadCount or the default thread count on first use
+        /// @return the shared pool
+        static ThreadPool &shared();
+
+        /// @brief replaces the shared pool with one of threadCount threads, which must not happen while the shared pool is running a loop
+        /// @param threadCount total thread count, at least one
+        static void setSharedThreadCount(int threadCount);
+    };
+} // namespace concurrency
+
+#endif
\ No newline at end of file
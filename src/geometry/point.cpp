@@ -46,12 +46,12 @@ Point Point::rotate(double radians, const Vector &axis) const
 
     // Construct the rotation matrix
     Matrix w(3, 3);
-    w.at(0).at(1) = -unit.z;
-    w.at(0).at(2) = unit.y;
-    w.at(1).at(0) = unit.z;
-    w.at(1).at(2) = -unit.x;
-    w.at(2).at(0) = -unit.y;
-    w.at(2).at(1) = unit.x;
+    w(0, 1) = -unit.z;
+    w(0, 2) = unit.y;
+    w(1, 0) = unit.z;
+    w(1, 2) = -unit.x;
+    w(2, 0) = -unit.y;
+    w(2, 1) = unit.x;
 
     // Rodrigues' rotation formula
     // R = I + sin * W + (1 - cos) * W^2
@@ -0,0 +1,303 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "json_value.h"
+
+using instrumentation::Profiler;
+
+using instrumentation::Counter;
+using instrumentation::ScopedTimer;
+using io::JsonValue;
+
+namespace
+{
+    // Values of the Counter enumeration
+    const int counterCount = 5;
+
+    // Trace events kept per thread unless set otherwise, 24 bytes each
+    const std::size_t defaultEventCapacity = std::size_t(1) << 20;
+
+    std::atomic<bool> recording(false);
+    std::atomic<std::size_t> eventCapacity(defaultEventCapacity);
+    std::mutex recordsMutex;
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    std::int64_t getNanoseconds(std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+    }
+} // namespace
+
+bool Profiler::isCompiledIn()
+{
+#ifdef AIRFOILS_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    recording = enabled;
+}
+
+bool Profiler::isEnabled()
+{
+    return recording.load(std::memory_order_relaxed);
+}
+
+void Profiler::setEventCapacity(std::size_t capacity)
+{
+    eventCapacity = capacity;
+}
+
+std::vector<std::shared_ptr<Profiler::ThreadRecord>> &Profiler::getThreadRecords()
+{
+    // records outlive their threads so the work of finished threads stays in the report
+    static std::vector<std::shared_ptr<ThreadRecord>> records;
+    return records;
+}
+
+Profiler::ThreadRecord &Profiler::getThreadRecord()
+{
+    static thread_local std::shared_ptr<ThreadRecord> record;
+    if (record == nullptr)
+    {
+        std::shared_ptr<ThreadRecord> created = std::make_shared<ThreadRecord>();
+        created->counters.assign(counterCount, Statistic{0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+        created->droppedEvents = 0;
+        std::lock_guard<std::mutex> lock(recordsMutex);
+        created->thread = getThreadRecords().size();
+        getThreadRecords().push_back(created);
+        record = created;
+    }
+    return *record;
+}
+
+void Profiler::add(Statistic &statistic, double value)
+{
+    statistic.count++;
+    statistic.sum += value;
+    statistic.min = std::min(statistic.min, value);
+    statistic.max = std::max(statistic.max, value);
+}
+
+void Profiler::merge(Statistic &statistic, const Statistic &other)
+{
+    statistic.count += other.count;
+    statistic.sum += other.sum;
+    statistic.min = std::min(statistic.min, other.min);
+    statistic.max = std::max(statistic.max, other.max);
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    for (const std::shared_ptr<ThreadRecord> &record : getThreadRecords())
+    {
+        std::lock_guard<std::mutex> recordLock(record->mutex);
+        record->timers.clear();
+        record->counters.assign(counterCount, Statistic{0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+        record->events.clear();
+        record->droppedEvents = 0;
+    }
+}
+
+void Profiler::recordTimer(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    if (!isEnabled())
+        return;
+
+    ThreadRecord &record = getThreadRecord();
+    std::int64_t startNanoseconds = getNanoseconds(start);
+    std::int64_t duration = getNanoseconds(end) - startNanoseconds;
+    std::lock_guard<std::mutex> lock(record.mutex);
+    auto found = record.timers.find(name);
+    if (found == record.timers.end())
+        found = record.timers.emplace(name, Statistic{0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()}).first;
+    add(found->second, duration * 1e-9);
+    if (record.events.size() < eventCapacity.load(std::memory_order_relaxed))
+        record.events.push_back(Event{name, startNanoseconds, duration});
+    else
+        record.droppedEvents++;
+}
+
+void Profiler::count(Counter counter, double value)
+{
+    if (!isEnabled())
+        return;
+
+    ThreadRecord &record = getThreadRecord();
+    std::lock_guard<std::mutex> lock(record.mutex);
+    add(record.counters[static_cast<int>(counter)], value);
+}
+
+const char *Profiler::getCounterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::TranscendentalCalls:
+        return "transcendentalCalls";
+    case Counter::Allocations:
+        return "allocations";
+    case Counter::MatrixBytes:
+        return "matrixBytes";
+    case Counter::SolveIterations:
+        return "solveIterations";
+    case Counter::SolveResidual:
+        return "solveResidual";
+    }
+    return "unknown";
+}
+
+JsonValue Profiler::getReport(const std::map<std::string, Statistic> &timers, const std::vector<Statistic> &counters)
+{
+    JsonValue report = JsonValue::object();
+    JsonValue timerReport = JsonValue::object();
+    for (const auto &timer : timers)
+    {
+        const Statistic &statistic = timer.second;
+        JsonValue entry = JsonValue::object();
+        entry.set("count", static_cast<double>(statistic.count));
+        entry.set("total", statistic.sum);
+        entry.set("mean", statistic.sum / statistic.count);
+        entry.set("min", statistic.min);
+        entry.set("max", statistic.max);
+        timerReport.set(timer.first, entry);
+    }
+    report.set("timers", timerReport);
+
+    JsonValue counterReport = JsonValue::object();
+    for (int c = 0; c < counterCount; ++c)
+    {
+        const Statistic &statistic = counters[c];
+        if (statistic.count == 0)
+            continue;
+        JsonValue entry = JsonValue::object();
+        entry.set("count", static_cast<double>(statistic.count));
+        entry.set("sum", statistic.sum);
+        entry.set("min", statistic.min);
+        entry.set("max", statistic.max);
+        counterReport.set(getCounterName(static_cast<Counter>(c)), entry);
+    }
+    report.set("counters", counterReport);
+    return report;
+}
+
+JsonValue Profiler::getReport()
+{
+    std::map<std::string, Statistic> timers;
+    std::vector<Statistic> counters(counterCount, Statistic{0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+    JsonValue threads = JsonValue::array();
+    std::size_t droppedEvents = 0;
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    for (const std::shared_ptr<ThreadRecord> &record : getThreadRecords())
+    {
+        std::map<std::string, Statistic> threadTimers;
+        std::vector<Statistic> threadCounters;
+        std::size_t threadDroppedEvents;
+        {
+            std::lock_guard<std::mutex> recordLock(record->mutex);
+            for (const auto &timer : record->timers)
+            {
+                // the same name may be separate literals in different translation units
+                auto found = threadTimers.find(timer.first);
+                if (found == threadTimers.end())
+                    threadTimers.emplace(timer.first, timer.second);
+                else
+                    merge(found->second, timer.second);
+            }
+            threadCounters = record->counters;
+            threadDroppedEvents = record->droppedEvents;
+        }
+        if (threadTimers.empty() && std::none_of(threadCounters.begin(), threadCounters.end(), [](const Statistic &statistic)
+                                                 { return statistic.count > 0; }))
+            continue;
+
+        for (const auto &timer : threadTimers)
+        {
+            auto found = timers.find(timer.first);
+            if (found == timers.end())
+                timers.emplace(timer.first, timer.second);
+            else
+                merge(found->second, timer.second);
+        }
+        for (int c = 0; c < counterCount; ++c)
+            merge(counters[c], threadCounters[c]);
+        droppedEvents += threadDroppedEvents;
+
+        JsonValue thread = getReport(threadTimers, threadCounters);
+        thread.set("thread", record->thread);
+        thread.set("droppedEvents", static_cast<double>(threadDroppedEvents));
+        threads.push(thread);
+    }
+
+    JsonValue report = getReport(timers, counters);
+    report.set("droppedEvents", static_cast<double>(droppedEvents));
+    report.set("threads", threads);
+    return report;
+}
+
+void Profiler::writeReport(const std::string &path)
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("The profile report " + path + " could not be opened");
+    file << getReport().serialize() << '\n';
+    if (!file)
+        throw std::runtime_error("The profile report " + path + " could not be written");
+}
+
+void Profiler::writeChromeTrace(const std::string &path)
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("The trace file " + path + " could not be opened");
+
+    // complete events carry microsecond start times and durations, and metadata events name the threads
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char numbers[96];
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    for (const std::shared_ptr<ThreadRecord> &record : getThreadRecords())
+    {
+        std::lock_guard<std::mutex> recordLock(record->mutex);
+        file << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << record->thread << ",\"args\":{\"name\":\"thread " << record->thread << "\"}}";
+        first = false;
+        for (const Event &event : record->events)
+        {
+            std::snprintf(numbers, sizeof(numbers), ",\"ts\":%.3f,\"dur\":%.3f}", event.start * 1e-3, event.duration * 1e-3);
+            file << ",\n{\"name\":" << JsonValue(event.name).serialize() << ",\"cat\":\"airfoils\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record->thread << numbers;
+        }
+    }
+    file << "\n]}\n";
+    if (!file)
+        throw std::runtime_error("The trace file " + path + " could not be written");
+}
+
+ScopedTimer::ScopedTimer(const char *name) : mName(name), mActive(Profiler::isEnabled())
+{
+    if (mActive)
+        mStart = std::chrono::steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    if (mActive)
+        Profiler::recordTimer(mName, mStart, std::chrono::steady_clock::now());
+}
\ No newline at end of file
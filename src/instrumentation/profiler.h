@@ -0,0 +1,150 @@
+#ifndef AIRFOILS_INSTRUMENTATION_PROFILER_H_
+#define AIRFOILS_INSTRUMENTATION_PROFILER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "json_value.h"
+
+namespace instrumentation
+{
+    /// @brief quantities recorded by the instrumented solver
+    enum class Counter
+    {
+        /// @brief logarithm and arctangent evaluations of the panel integrals
+        TranscendentalCalls,
+
+        /// @brief matrix buffers allocated
+        Allocations,
+
+        /// @brief bytes of the allocated matrix buffers
+        MatrixBytes,
+
+        /// @brief operator applications of an iterative solve
+        SolveIterations,
+
+        /// @brief final relative residual of an iterative solve
+        SolveResidual
+    };
+
+    /// @brief collects scoped timings and counters in a record per thread, aggregated into a JSON report or written as a Chrome trace-event file,
+    /// and does nothing until it is enabled
+    class Profiler
+    {
+    private:
+        struct Statistic
+        {
+            std::size_t count;
+            double sum, min, max;
+        };
+
+        struct Event
+        {
+            const char *name;
+            std::int64_t start, duration;
+        };
+
+        struct ThreadRecord
+        {
+            int thread;
+            std::mutex mutex;
+            std::unordered_map<const char *, Statistic> timers;
+            std::vector<Statistic> counters;
+            std::vector<Event> events;
+            std::size_t droppedEvents;
+        };
+
+        static ThreadRecord &getThreadRecord();
+        static std::vector<std::shared_ptr<ThreadRecord>> &getThreadRecords();
+        static void add(Statistic &statistic, double value);
+        static void merge(Statistic &statistic, const Statistic &other);
+        static io::JsonValue getReport(const std::map<std::string, Statistic> &timers, const std::vector<Statistic> &counters);
+
+    public:
+        /// @brief indicates if the instrumentation macros were compiled into the solver, which takes the AIRFOILS_INSTRUMENTATION definition
+        /// @return true when the solver records timings and counters once enabled
+        static bool isCompiledIn();
+
+        /// @brief starts or stops recording, which is off at startup
+        /// @param enabled true to record
+        static void setEnabled(bool enabled);
+
+        /// @brief indicates if recording is on
+        /// @return true when recording
+        static bool isEnabled();
+
+        /// @brief limits the trace events kept per thread, later events still count in the report
+        /// @param capacity events per thread
+        static void setEventCapacity(std::size_t capacity);
+
+        /// @brief discards everything recorded so far
+        static void reset();
+
+        /// @brief records one timed interval of a phase
+        /// @param name phase name, a string literal that outlives the profiler
+        /// @param start start of the interval
+        /// @param end end of the interval
+        static void recordTimer(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+        /// @brief records a value of a counter
+        /// @param counter the counter
+        /// @param value the amount counted, or the measured value such as a residual
+        static void count(instrumentation::Counter counter, double value = 1.0);
+
+        /// @brief gets the name of a counter in reports
+        /// @param counter the counter
+        /// @return the name
+        static const char *getCounterName(instrumentation::Counter counter);
+
+        /// @brief aggregates the records, timers in seconds with count, total, mean, minimum, and maximum, and counters with count, sum, minimum, and maximum
+        /// @return an object of the merged timers and counters and the same for each thread
+        static io::JsonValue getReport();
+
+        /// @brief writes the report
+        /// @param path JSON file
+        static void writeReport(const std::string &path);
+
+        /// @brief writes every kept interval as a complete event of the Chrome trace-event format, which chrome://tracing and Perfetto open
+        /// @param path JSON file
+        static void writeChromeTrace(const std::string &path);
+    };
+
+    /// @brief times the enclosing scope when the profiler is enabled
+    class ScopedTimer
+    {
+    private:
+        const char *mName;
+        bool mActive;
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        /// @brief starts timing
+        /// @param name phase name, a string literal
+        ScopedTimer(const char *name);
+
+        /// @brief records the interval
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+} // namespace instrumentation
+
+#ifdef AIRFOILS_INSTRUMENTATION
+#define AIRFOILS_PROFILE_CONCATENATE_(a, b) a##b
+#define AIRFOILS_PROFILE_CONCATENATE(a, b) AIRFOILS_PROFILE_CONCATENATE_(a, b)
+#define AIRFOILS_PROFILE_SCOPE(name) instrumentation::ScopedTimer AIRFOILS_PROFILE_CONCATENATE(profileScope, __LINE__)(name)
+#define AIRFOILS_PROFILE_COUNT(counter, value) instrumentation::Profiler::count(instrumentation::Counter::counter, value)
+#else
+#define AIRFOILS_PROFILE_SCOPE(name) static_cast<void>(0)
+#define AIRFOILS_PROFILE_COUNT(counter, value) static_cast<void>(0)
+#endif
+
+#endif
\ No newline at end of file
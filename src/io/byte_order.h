@@ -0,0 +1,87 @@
+#ifndef AIRFOILS_IO_BYTEORDER_H_
+#define AIRFOILS_IO_BYTEORDER_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace io
+{
+    /// @brief encodes values in a fixed byte order independent of the machine, for file formats that are read on other machines
+    class ByteOrder
+    {
+    public:
+        /// @brief indicates if the machine stores the least significant byte first
+        /// @return true on a little-endian machine
+        static inline bool isLittleEndian()
+        {
+            std::uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        /// @brief stores the low bytes of a value least significant first
+        /// @param bytes receives byteCount bytes
+        /// @param value the value
+        /// @param byteCount bytes to store, at most 8
+        static inline void storeLittleEndian(unsigned char *bytes, std::uint64_t value, int byteCount)
+        {
+            for (int b = 0; b < byteCount; ++b)
+                bytes[b] = static_cast<unsigned char>(value >> (8 * b));
+        }
+
+        /// @brief stores the low bytes of a value most significant first
+        /// @param bytes receives byteCount bytes
+        /// @param value the value
+        /// @param byteCount bytes to store, at most 8
+        static inline void storeBigEndian(unsigned char *bytes, std::uint64_t value, int byteCount)
+        {
+            for (int b = 0; b < byteCount; ++b)
+                bytes[b] = static_cast<unsigned char>(value >> (8 * (byteCount - 1 - b)));
+        }
+
+        /// @brief loads a value stored least significant first
+        /// @param bytes byteCount bytes
+        /// @param byteCount bytes to load, at most 8
+        /// @return the value
+        static inline std::uint64_t loadLittleEndian(const unsigned char *bytes, int byteCount)
+        {
+            std::uint64_t value = 0;
+            for (int b = 0; b < byteCount; ++b)
+                value |= static_cast<std::uint64_t>(bytes[b]) << (8 * b);
+            return value;
+        }
+
+        /// @brief gets the IEEE 754 bits of a double
+        /// @param value the value
+        /// @return the bits
+        static inline std::uint64_t getBits(double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        /// @brief gets the IEEE 754 bits of a float
+        /// @param value the value
+        /// @return the bits
+        static inline std::uint32_t getBits(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        /// @brief gets the double of IEEE 754 bits
+        /// @param bits the bits
+        /// @return the value
+        static inline double getDouble(std::uint64_t bits)
+        {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+} // namespace io
+
+#endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "field_writer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "byte_order.h"
+#include "panel.h"
+#include "panel_methods.h"
+#include "panel_treecode.h"
+#include "velocity_field.h"
+
+using io::FieldWriter;
+
+using aerodynamics::FieldGrid;
+using aerodynamics::Panel;
+using aerodynamics::PanelMethods;
+using aerodynamics::PanelTreecode;
+using io::ByteOrder;
+using io::FieldFormat;
+using io::FieldWriterOptions;
+
+namespace
+{
+    // Separates the scalars and the vectors of a VTK file
+    const std::string vtkVectorHeader = "\nVECTORS velocity float\n";
+} // namespace
+
+std::string FieldWriter::getVTKHeader(const FieldGrid &grid)
+{
+    std::ostringstream header;
+    header << std::setprecision(17);
+    header << "# vtk DataFile Version 3.0\n"
+           << "airfoil flow field\n"
+           << "BINARY\n"
+           << "DATASET STRUCTURED_POINTS\n"
+           << "DIMENSIONS " << grid.columns << " " << grid.rows << " 1\n"
+           << "ORIGIN " << grid.originX << " " << grid.originY << " 0\n"
+           << "SPACING " << grid.spacingX << " " << grid.spacingY << " 1\n"
+           << "POINT_DATA " << static_cast<std::int64_t>(grid.columns) * grid.rows << "\n"
+           << "SCALARS pressure_coefficient float 1\n"
+           << "LOOKUP_TABLE default\n";
+    return header.str();
+}
+
+void FieldWriter::writeAt(std::ofstream &file, std::int64_t offset, const std::vector<unsigned char> &bytes)
+{
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
+
+void FieldWriter::write(const std::vector<Panel> &panels, const FieldGrid &grid, const std::string &path, const FieldWriterOptions &options)
+{
+    if (panels.empty())
+        throw std::invalid_argument("The panels must not be empty");
+    if (grid.columns < 1 || grid.rows < 1)
+        throw std::invalid_argument("The grid must have at least one row and column");
+    if (options.tilePoints < 1)
+        throw std::invalid_argument("The tile must have at least one point");
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("The field file could not be opened");
+
+    // the VTK scalars and vectors are separate sections, so each tile is written at its offset in both
+    std::int64_t pointCount = static_cast<std::int64_t>(grid.columns) * grid.rows;
+    std::int64_t scalarOffset = 0;
+    std::int64_t vectorOffset = 0;
+    if (options.format == FieldFormat::VTK)
+    {
+        std::string header = getVTKHeader(grid);
+        file.write(header.data(), header.size());
+        scalarOffset = header.size();
+        file.seekp(scalarOffset + 4 * pointCount);
+        file.write(vtkVectorHeader.data(), vtkVectorHeader.size());
+        vectorOffset = scalarOffset + 4 * pointCount + vtkVectorHeader.size();
+    }
+
+    std::unique_ptr<PanelTreecode> treecode;
+    if (options.useTreecode)
+        treecode.reset(new PanelTreecode(panels, options.treecode));
+
+    int tileRows = std::min(grid.rows, std::max(1, options.tilePoints / grid.columns));
+    std::vector<double> x, y, vx, vy, cp;
+    std::future<void> pending;
+    for (int rowBegin = 0; rowBegin < grid.rows; rowBegin += tileRows)
+    {
+        int rowEnd = std::min(grid.rows, rowBegin + tileRows);
+        int count = (rowEnd - rowBegin) * grid.columns;
+        x.resize(count);
+        y.resize(count);
+        vx.resize(count);
+        vy.resize(count);
+        cp.resize(count);
+        for (int k = 0; k < count; ++k)
+        {
+            x[k] = grid.originX + (k % grid.columns) * grid.spacingX;
+            y[k] = grid.originY + (rowBegin + k / grid.columns) * grid.spacingY;
+        }
+        if (treecode != nullptr)
+            treecode->computeVelocityField(x.data(), y.data(), count, vx.data(), vy.data(), cp.data());
+        else
+            PanelMethods::computeVelocityField(panels, x.data(), y.data(), count, vx.data(), vy.data(), cp.data());
+
+        std::int64_t first = static_cast<std::int64_t>(rowBegin) * grid.columns;
+        std::vector<unsigned char> scalars, vectors;
+        if (options.format == FieldFormat::VTK)
+        {
+            scalars.resize(4 * static_cast<std::size_t>(count));
+            vectors.resize(12 * static_cast<std::size_t>(count));
+            for (int k = 0; k < count; ++k)
+            {
+                ByteOrder::storeBigEndian(&scalars[4 * k], ByteOrder::getBits(static_cast<float>(cp[k])), 4);
+                ByteOrder::storeBigEndian(&vectors[12 * k], ByteOrder::getBits(static_cast<float>(vx[k])), 4);
+                ByteOrder::storeBigEndian(&vectors[12 * k + 4], ByteOrder::getBits(static_cast<float>(vy[k])), 4);
+                ByteOrder::storeBigEndian(&vectors[12 * k + 8], ByteOrder::getBits(0.0f), 4);
+            }
+        }
+        else
+        {
+            vectors.resize(12 * static_cast<std::size_t>(count));
+            for (int k = 0; k < count; ++k)
+            {
+                ByteOrder::storeLittleEndian(&vectors[12 * k], ByteOrder::getBits(static_cast<float>(vx[k])), 4);
+                ByteOrder::storeLittleEndian(&vectors[12 * k + 4], ByteOrder::getBits(static_cast<float>(vy[k])), 4);
+                ByteOrder::storeLittleEndian(&vectors[12 * k + 8], ByteOrder::getBits(static_cast<float>(cp[k])), 4);
+            }
+        }
+
+        // the previous tile is written while this one was evaluated, so at most two tiles are held
+        if (pending.valid())
+            pending.get();
+        std::int64_t scalarPosition = scalarOffset + 4 * first;
+        std::int64_t vectorPosition = vectorOffset + 12 * first;
+        pending = std::async(std::launch::async, [&file, scalarPosition, vectorPosition, scalars = std::move(scalars), vectors = std::move(vectors)]()
+                             {
+            if (!scalars.empty())
+                writeAt(file, scalarPosition, scalars);
+            writeAt(file, vectorPosition, vectors); });
+    }
+    if (pending.valid())
+        pending.get();
+
+    file.flush();
+    if (!file)
+        throw std::runtime_error("The field file could not be written");
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef AIRFOILS_IO_FIELDWRITER_H_
+#define AIRFOILS_IO_FIELDWRITER_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "panel.h"
+#include "segment_tree.h"
+#include "velocity_field.h"
+
+namespace io
+{
+    /// @brief the file layout of a written field
+    enum class FieldFormat
+    {
+        /// @brief headerless little-endian floats, vx, vy, and cp of each point in row by row order
+        Raw,
+
+        /// @brief a legacy binary VTK structured points file, big-endian floats of the pressure coefficient scalars followed by the velocity vectors
+        VTK
+    };
+
+    /// @brief settings of a streamed field
+    struct FieldWriterOptions
+    {
+        /// @brief the file layout
+        io::FieldFormat format = io::FieldFormat::Raw;
+
+        /// @brief maximum points evaluated and held at once, rounded down to whole rows of at least one row
+        int tilePoints = 1 << 18;
+
+        /// @brief indicates if the field is evaluated with the panel treecode instead of summing every panel
+        bool useTreecode = false;
+
+        /// @brief treecode accuracy settings
+        aerodynamics::TreecodeOptions treecode;
+    };
+
+    /// @brief evaluates the flow of a regular grid in tiles of rows and writes each tile while the next is evaluated, so memory is bounded by the tile size and not the grid size
+    class FieldWriter
+    {
+    private:
+        static std::string getVTKHeader(const aerodynamics::FieldGrid &grid);
+        static void writeAt(std::ofstream &file, std::int64_t offset, const std::vector<unsigned char> &bytes);
+
+    public:
+        /// @brief computes the velocity and pressure of every grid point and writes them to a file
+        /// @param panels solved panels
+        /// @param grid grid of field points
+        /// @param path file path, replaced when it exists
+        /// @param options format and tile settings
+        static void write(const std::vector<aerodynamics::Panel> &panels, const aerodynamics::FieldGrid &grid, const std::string &path, const io::FieldWriterOptions &options = io::FieldWriterOptions());
+    };
+} // namespace io
+
+#endif
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include "json_value.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using io::JsonValue;
+
+using io::JsonType;
+
+namespace
+{
+    // Nesting limit that keeps malformed input from exhausting the stack
+    const int maxDepth = 64;
+
+    void appendUtf8(std::string &text, unsigned long codePoint)
+    {
+        if (codePoint < 0x80)
+            text += static_cast<char>(codePoint);
+        else if (codePoint < 0x800)
+        {
+            text += static_cast<char>(0xC0 | (codePoint >> 6));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            text += static_cast<char>(0xE0 | (codePoint >> 12));
+            text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            text += static_cast<char>(0xF0 | (codePoint >> 18));
+            text += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    unsigned long parseHex(const std::string &text, std::size_t position)
+    {
+        if (position + 4 > text.size())
+            throw std::invalid_argument("The JSON escape is incomplete");
+        unsigned long value = 0;
+        for (std::size_t k = position; k < position + 4; ++k)
+        {
+            char c = text[k];
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                value |= c - 'A' + 10;
+            else
+                throw std::invalid_argument("The JSON escape is not hexadecimal");
+        }
+        return value;
+    }
+} // namespace
+
+JsonValue::JsonValue(const std::vector<double> &values)
+    : mType(JsonType::Array), mBoolean(false), mNumber(0.0)
+{
+    mArray.reserve(values.size());
+    for (double value : values)
+        mArray.push_back(JsonValue(value));
+}
+
+JsonValue JsonValue::array()
+{
+    JsonValue value;
+    value.mType = JsonType::Array;
+    return value;
+}
+
+JsonValue JsonValue::object()
+{
+    JsonValue value;
+    value.mType = JsonType::Object;
+    return value;
+}
+
+JsonValue JsonValue::parse(const std::string &text)
+{
+    std::size_t position = 0;
+    JsonValue value = parseValue(text, position, 0);
+    skipWhitespace(text, position);
+    if (position != text.size())
+        throw std::invalid_argument("The JSON text has characters after the value");
+    return value;
+}
+
+void JsonValue::skipWhitespace(const std::string &text, std::size_t &position)
+{
+    while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r'))
+        position++;
+}
+
+std::string JsonValue::parseString(const std::string &text, std::size_t &position)
+{
+    // position is at the opening quote
+    std::string result;
+    position++;
+    while (true)
+    {
+        if (position >= text.size())
+            throw std::invalid_argument("The JSON string is not terminated");
+        char c = text[position++];
+        if (c == '"')
+            return result;
+        if (static_cast<unsigned char>(c) < 0x20)
+            throw std::invalid_argument("The JSON string has a control character");
+        if (c != '\\')
+        {
+            result += c;
+            continue;
+        }
+        if (position >= text.size())
+            throw std::invalid_argument("The JSON escape is incomplete");
+        char escape = text[position++];
+        switch (escape)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            result += escape;
+            break;
+        case 'b':
+            result += '\b';
+            break;
+        case 'f':
+            result += '\f';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'u':
+        {
+            unsigned long codePoint = parseHex(text, position);
+            position += 4;
+            // a high surrogate combines with the low surrogate that follows
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && position + 1 < text.size() && text[position] == '\\' && text[position + 1] == 'u')
+            {
+                unsigned long low = parseHex(text, position + 2);
+                if (low >= 0xDC00 && low < 0xE000)
+                {
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    position += 6;
+                }
+            }
+            appendUtf8(result, codePoint);
+            break;
+        }
+        default:
+            throw std::invalid_argument("The JSON escape is not valid");
+        }
+    }
+}
+
+JsonValue JsonValue::parseValue(const std::string &text, std::size_t &position, int depth)
+{
+    if (depth > maxDepth)
+        throw std::invalid_argument("The JSON value is nested too deeply");
+    skipWhitespace(text, position);
+    if (position >= text.size())
+        throw std::invalid_argument("The JSON text ended before a value");
+
+    char c = text[position];
+    if (c == '{')
+    {
+        JsonValue value = object();
+        position++;
+        skipWhitespace(text, position);
+        if (position < text.size() && text[position] == '}')
+        {
+            position++;
+            return value;
+        }
+        while (true)
+        {
+            skipWhitespace(text, position);
+            if (position >= text.size() || text[position] != '"')
+                throw std::invalid_argument("The JSON object member must start with a string");
+            std::string key = parseString(text, position);
+            skipWhitespace(text, position);
+            if (position >= text.size() || text[position] != ':')
+                throw std::invalid_argument("The JSON object member must have a colon");
+            position++;
+            value.set(key, parseValue(text, position, depth + 1));
+            skipWhitespace(text, position);
+            if (position < text.size() && text[position] == ',')
+            {
+                position++;
+                continue;
+            }
+            if (position < text.size() && text[position] == '}')
+            {
+                position++;
+                return value;
+            }
+            throw std::invalid_argument("The JSON object is not terminated");
+        }
+    }
+    if (c == '[')
+    {
+        JsonValue value = array();
+        position++;
+        skipWhitespace(text, position);
+        if (position < text.size() && text[position] == ']')
+        {
+            position++;
+            return value;
+        }
+        while (true)
+        {
+            value.mArray.push_back(parseValue(text, position, depth + 1));
+            skipWhitespace(text, position);
+            if (position < text.size() && text[position] == ',')
+            {
+                position++;
+                continue;
+            }
+            if (position < text.size() && text[position] == ']')
+            {
+                position++;
+                return value;
+            }
+            throw std::invalid_argument("The JSON array is not terminated");
+        }
+    }
+    if (c == '"')
+        return JsonValue(parseString(text, position));
+    if (text.compare(position, 4, "true") == 0)
+    {
+        position += 4;
+        return JsonValue(true);
+    }
+    if (text.compare(position, 5, "false") == 0)
+    {
+        position += 5;
+        return JsonValue(false);
+    }
+    if (text.compare(position, 4, "null") == 0)
+    {
+        position += 4;
+        return JsonValue();
+    }
+
+    // numbers follow the JSON grammar, which strtod alone would loosen to hex, inf, and leading plus signs
+    std::size_t start = position;
+    if (position < text.size() && text[position] == '-')
+        position++;
+    std::size_t digits = position;
+    while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+        position++;
+    if (position == digits || (text[digits] == '0' && position - digits > 1))
+        throw std::invalid_argument("The JSON value is not valid");
+    if (position < text.size() && text[position] == '.')
+    {
+        position++;
+        std::size_t fraction = position;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+            position++;
+        if (position == fraction)
+            throw std::invalid_argument("The JSON number has no fraction digits");
+    }
+    if (position < text.size() && (text[position] == 'e' || text[position] == 'E'))
+    {
+        position++;
+        if (position < text.size() && (text[position] == '+' || text[position] == '-'))
+            position++;
+        std::size_t exponent = position;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+            position++;
+        if (position == exponent)
+            throw std::invalid_argument("The JSON number has no exponent digits");
+    }
+    return JsonValue(std::strtod(text.substr(start, position - start).c_str(), nullptr));
+}
+
+std::string JsonValue::serialize() const
+{
+    std::string text;
+    serialize(text);
+    return text;
+}
+
+void JsonValue::serialize(std::string &text) const
+{
+    switch (mType)
+    {
+    case JsonType::Null:
+        text += "null";
+        break;
+    case JsonType::Boolean:
+        text += mBoolean ? "true" : "false";
+        break;
+    case JsonType::Number:
+    {
+        if (!std::isfinite(mNumber))
+        {
+            text += "null";
+            break;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", mNumber);
+        text += buffer;
+        break;
+    }
+    case JsonType::String:
+        text += '"';
+        for (char c : mString)
+        {
+            if (c == '"' || c == '\\')
+            {
+                text += '\\';
+                text += c;
+            }
+            else if (c == '\n')
+                text += "\\n";
+            else if (c == '\t')
+                text += "\\t";
+            else if (c == '\r')
+                text += "\\r";
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                text += buffer;
+            }
+            else
+                text += c;
+        }
+        text += '"';
+        break;
+    case JsonType::Array:
+        text += '[';
+        for (std::size_t k = 0; k < mArray.size(); ++k)
+        {
+            if (k > 0)
+                text += ',';
+            mArray[k].serialize(text);
+        }
+        text += ']';
+        break;
+    case JsonType::Object:
+        text += '{';
+        for (std::size_t k = 0; k < mObject.size(); ++k)
+        {
+            if (k > 0)
+                text += ',';
+            JsonValue(mObject[k].first).serialize(text);
+            text += ':';
+            mObject[k].second.serialize(text);
+        }
+        text += '}';
+        break;
+    }
+}
+
+bool JsonValue::getBoolean() const
+{
+    if (mType != JsonType::Boolean)
+        throw std::invalid_argument("The JSON value is not a boolean");
+    return mBoolean;
+}
+
+double JsonValue::getNumber() const
+{
+    if (mType != JsonType::Number)
+        throw std::invalid_argument("The JSON value is not a number");
+    return mNumber;
+}
+
+const std::string &JsonValue::getString() const
+{
+    if (mType != JsonType::String)
+        throw std::invalid_argument("The JSON value is not a string");
+    return mString;
+}
+
+const std::vector<JsonValue> &JsonValue::getArray() const
+{
+    if (mType != JsonType::Array)
+        throw std::invalid_argument("The JSON value is not an array");
+    return mArray;
+}
+
+const std::vector<std::pair<std::string, JsonValue>> &JsonValue::getMembers() const
+{
+    if (mType != JsonType::Object)
+        throw std::invalid_argument("The JSON value is not an object");
+    return mObject;
+}
+
+const JsonValue *JsonValue::find(const std::string &key) const
+{
+    for (const auto &member : getMembers())
+        if (member.first == key)
+            return &member.second;
+    return nullptr;
+}
+
+void JsonValue::push(const JsonValue &value)
+{
+    if (mType != JsonType::Array)
+        throw std::invalid_argument("The JSON value is not an array");
+    mArray.push_back(value);
+}
+
+void JsonValue::set(const std::string &key, const JsonValue &value)
+{
+    if (mType != JsonType::Object)
+        throw std::invalid_argument("The JSON value is not an object");
+    for (auto &member : mObject)
+        if (member.first == key)
+        {
+            member.second = value;
+            return;
+        }
+    mObject.emplace_back(key, value);
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef AIRFOILS_IO_JSONVALUE_H_
+#define AIRFOILS_IO_JSONVALUE_H_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace io
+{
+    /// @brief the kind of a JSON value
+    enum class JsonType
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    /// @brief a JSON document of the subset the case files use, numbers are doubles and object members keep their order
+    class JsonValue
+    {
+    private:
+        io::JsonType mType;
+        bool mBoolean;
+        double mNumber;
+        std::string mString;
+        std::vector<io::JsonValue> mArray;
+        std::vector<std::pair<std::string, io::JsonValue>> mObject;
+
+        static io::JsonValue parseValue(const std::string &text, std::size_t &position, int depth);
+        static std::string parseString(const std::string &text, std::size_t &position);
+        static void skipWhitespace(const std::string &text, std::size_t &position);
+        void serialize(std::string &text) const;
+
+    public:
+        /// @brief a null value
+        JsonValue() : mType(io::JsonType::Null), mBoolean(false), mNumber(0.0){};
+
+        /// @brief a boolean value
+        /// @param value the value
+        JsonValue(bool value) : mType(io::JsonType::Boolean), mBoolean(value), mNumber(0.0){};
+
+        /// @brief a number value
+        /// @param value the value
+        JsonValue(double value) : mType(io::JsonType::Number), mBoolean(false), mNumber(value){};
+
+        /// @brief a number value
+        /// @param value the value
+        JsonValue(int value) : mType(io::JsonType::Number), mBoolean(false), mNumber(value){};
+
+        /// @brief a string value
+        /// @param value the value
+        JsonValue(const std::string &value) : mType(io::JsonType::String), mBoolean(false), mNumber(0.0), mString(value){};
+
+        /// @brief a string value
+        /// @param value the value
+        JsonValue(const char *value) : mType(io::JsonType::String), mBoolean(false), mNumber(0.0), mString(value){};
+
+        /// @brief an array of numbers
+        /// @param values the values
+        JsonValue(const std::vector<double> &values);
+
+        /// @brief an empty array
+        /// @return the array
+        static io::JsonValue array();
+
+        /// @brief an empty object
+        /// @return the object
+        static io::JsonValue object();
+
+        /// @brief parses one JSON document
+        /// @param text the document, surrounding whitespace is allowed
+        /// @return the value
+        static io::JsonValue parse(const std::string &text);
+
+        /// @brief writes the value without whitespace, numbers round trip and non-finite numbers are written as null
+        /// @return the JSON text
+        std::string serialize() const;
+
+        /// @brief gets the kind of the value
+        /// @return the type
+        inline io::JsonType getType() const { return mType; };
+
+        /// @brief gets a boolean value
+        /// @return the value
+        bool getBoolean() const;
+
+        /// @brief gets a number value
+        /// @return the value
+        double getNumber() const;
+
+        /// @brief gets a string value
+        /// @return the value
+        const std::string &getString() const;
+
+        /// @brief gets the elements of an array
+        /// @return the elements
+        const std::vector<io::JsonValue> &getArray() const;
+
+        /// @brief gets the members of an object
+        /// @return the members in order
+        const std::vector<std::pair<std::string, io::JsonValue>> &getMembers() const;
+
+        /// @brief finds a member of an object
+        /// @param key member name
+        /// @return the member value or null when it is missing
+        const io::JsonValue *find(const std::string &key) const;
+
+        /// @brief appends an element to an array
+        /// @param value the element
+        void push(const io::JsonValue &value);
+
+        /// @brief sets a member of an object, replacing an existing one
+        /// @param key member name
+        /// @param value member value
+        void set(const std::string &key, const io::JsonValue &value);
+    };
+} // namespace io
+
+#endif
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "polar_file.h"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "byte_order.h"
+#include "naca_sweep.h"
+#include "polar.h"
+
+using io::PolarReader;
+using io::PolarWriter;
+
+using aerodynamics::Polar;
+using aerodynamics::SweepCase;
+using io::ByteOrder;
+using io::PolarRecord;
+
+namespace
+{
+    // File signature and the format version written, readers accept this version and older
+    const char fileMagic[8] = {'A', 'I', 'R', 'F', 'P', 'O', 'L', 'R'};
+    const std::uint32_t fileVersion = 1;
+
+    // Block signature
+    const char blockMagic[4] = {'C', 'A', 'S', 'E'};
+
+    // Header sizes, multiples of 8 so every column of a mapped file is aligned for doubles
+    const std::size_t fileHeaderBytes = 64;
+    const std::size_t blockHeaderBytes = 64;
+
+    // Columns of angleCount values in every block before the pressure coefficients
+    const std::size_t coefficientColumns = 4;
+
+    std::size_t getBlockBytes(std::size_t angleCount, std::size_t panelCount)
+    {
+        return blockHeaderBytes + sizeof(double) * angleCount * (coefficientColumns + panelCount);
+    }
+
+    /// @brief checks a block header read from a file, whose counts are bounded by the bytes left before the block size is computed from them
+    /// @param header the block header
+    /// @param availableBytes the bytes from the start of the block to the end of the file, at least a block header
+    /// @return whether the header starts a complete block
+    bool isCompleteBlock(const unsigned char *header, std::size_t availableBytes)
+    {
+        std::uint64_t blockBytes = ByteOrder::loadLittleEndian(header + 8, 8);
+        if (std::memcmp(header, blockMagic, sizeof(blockMagic)) != 0 || blockBytes > availableBytes)
+            return false;
+
+        // records hand the counts out as int, and their product must fit the file before it is multiplied
+        std::uint64_t angleCount = ByteOrder::loadLittleEndian(header + 24, 4);
+        std::uint64_t panelCount = ByteOrder::loadLittleEndian(header + 28, 4);
+        if (angleCount > INT_MAX || panelCount > INT_MAX)
+            return false;
+        std::uint64_t columnValues = (availableBytes - blockHeaderBytes) / sizeof(double);
+        if (angleCount > 0 && coefficientColumns + panelCount > columnValues / angleCount)
+            return false;
+        return blockBytes == getBlockBytes(angleCount, panelCount);
+    }
+} // namespace
+
+PolarWriter::PolarWriter(const std::string &path)
+{
+    std::size_t existingBytes = 0;
+    {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        if (existing)
+            existingBytes = static_cast<std::size_t>(existing.tellg());
+    }
+    if (existingBytes > 0)
+    {
+        // appending after a torn block would hide every later case from readers
+        std::size_t validBytes = PolarReader(path).validBytes();
+        if (validBytes < existingBytes && ::truncate(path.c_str(), validBytes) != 0)
+            throw std::runtime_error("The partial block of the polar file could not be removed");
+    }
+
+    mFile.open(path, std::ios::binary | std::ios::app);
+    if (!mFile)
+        throw std::runtime_error("The polar file could not be opened");
+    if (existingBytes == 0)
+    {
+        unsigned char header[fileHeaderBytes] = {};
+        std::memcpy(header, fileMagic, sizeof(fileMagic));
+        ByteOrder::storeLittleEndian(header + 8, fileVersion, 4);
+        ByteOrder::storeLittleEndian(header + 12, fileHeaderBytes, 4);
+        ByteOrder::storeLittleEndian(header + 16, blockHeaderBytes, 4);
+        mFile.write(reinterpret_cast<const char *>(header), sizeof(header));
+        mFile.flush();
+        if (!mFile)
+            throw std::runtime_error("The polar file header could not be written");
+    }
+}
+
+void PolarWriter::append(const SweepCase &sweepCase)
+{
+    const Polar &polar = sweepCase.polar;
+    std::size_t angleCount = polar.angles.size();
+    std::size_t panelCount = polar.panelCount;
+    if (polar.lift.size() != angleCount || polar.drag.size() != angleCount || polar.moment.size() != angleCount)
+        throw std::invalid_argument("The polar coefficients must have one value per angle");
+    if (polar.panelCount < 0 || polar.pressure.size() != angleCount * panelCount)
+        throw std::invalid_argument("The polar must have panelCount pressure coefficients per angle");
+
+    // the block is assembled in memory and written at once, so an interrupted append leaves at most one partial block
+    std::vector<unsigned char> block(getBlockBytes(angleCount, panelCount), 0);
+    unsigned char *header = block.data();
+    std::memcpy(header, blockMagic, sizeof(blockMagic));
+    ByteOrder::storeLittleEndian(header + 8, block.size(), 8);
+    ByteOrder::storeLittleEndian(header + 16, static_cast<std::uint32_t>(sweepCase.index), 4);
+    ByteOrder::storeLittleEndian(header + 20, static_cast<std::uint32_t>(sweepCase.pointCount), 4);
+    ByteOrder::storeLittleEndian(header + 24, angleCount, 4);
+    ByteOrder::storeLittleEndian(header + 28, panelCount, 4);
+    ByteOrder::storeLittleEndian(header + 32, ByteOrder::getBits(sweepCase.maxCamberPercent), 8);
+    ByteOrder::storeLittleEndian(header + 40, ByteOrder::getBits(sweepCase.maxCamberPositionPercent), 8);
+    ByteOrder::storeLittleEndian(header + 48, ByteOrder::getBits(sweepCase.thicknessPercent), 8);
+
+    unsigned char *values = block.data() + blockHeaderBytes;
+    for (const std::vector<double> *column : {&polar.angles, &polar.lift, &polar.drag, &polar.moment, &polar.pressure})
+        for (double value : *column)
+        {
+            ByteOrder::storeLittleEndian(values, ByteOrder::getBits(value), 8);
+            values += sizeof(double);
+        }
+
+    mFile.write(reinterpret_cast<const char *>(block.data()), block.size());
+    mFile.flush();
+    if (!mFile)
+        throw std::runtime_error("The polar file block could not be written");
+}
+
+PolarReader::PolarReader(const std::string &path)
+    : mData(nullptr), mMappedBytes(0), mValidBytes(0)
+{
+    // the columns are used in place, which is only the stored little-endian doubles on a little-endian machine
+    if (!ByteOrder::isLittleEndian())
+        throw std::runtime_error("Polar files can only be mapped on a little-endian machine");
+
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("The polar file could not be opened");
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < fileHeaderBytes)
+    {
+        ::close(descriptor);
+        throw std::invalid_argument("The file is not a polar file");
+    }
+    std::size_t fileBytes = status.st_size;
+    void *map = ::mmap(nullptr, fileBytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (map == MAP_FAILED)
+        throw std::runtime_error("The polar file could not be mapped");
+    mData = static_cast<const unsigned char *>(map);
+    mMappedBytes = fileBytes;
+
+    if (std::memcmp(mData, fileMagic, sizeof(fileMagic)) != 0 || ByteOrder::loadLittleEndian(mData + 12, 4) != fileHeaderBytes || ByteOrder::loadLittleEndian(mData + 16, 4) != blockHeaderBytes)
+    {
+        ::munmap(map, mMappedBytes);
+        throw std::invalid_argument("The file is not a polar file");
+    }
+    if (ByteOrder::loadLittleEndian(mData + 8, 4) > fileVersion)
+    {
+        ::munmap(map, mMappedBytes);
+        throw std::invalid_argument("The polar file version is newer than this reader");
+    }
+
+    // walk the block headers, stopping at the first block that is partial or not a block
+    std::size_t offset = fileHeaderBytes;
+    while (mMappedBytes - offset >= blockHeaderBytes)
+    {
+        const unsigned char *header = mData + offset;
+        if (!isCompleteBlock(header, mMappedBytes - offset))
+            break;
+        mOffsets.push_back(offset);
+        offset += ByteOrder::loadLittleEndian(header + 8, 8);
+    }
+    mValidBytes = offset;
+}
+
+PolarReader::~PolarReader()
+{
+    ::munmap(const_cast<unsigned char *>(mData), mMappedBytes);
+}
+
+PolarRecord PolarReader::getCase(int k) const
+{
+    if (k < 0 || k >= caseCount())
+        throw std::invalid_argument("The case must be inside the file");
+
+    const unsigned char *header = mData + mOffsets[k];
+    PolarRecord record;
+    record.index = static_cast<std::int32_t>(ByteOrder::loadLittleEndian(header + 16, 4));
+    record.pointCount = static_cast<std::int32_t>(ByteOrder::loadLittleEndian(header + 20, 4));
+    record.angleCount = ByteOrder::loadLittleEndian(header + 24, 4);
+    record.panelCount = ByteOrder::loadLittleEndian(header + 28, 4);
+    record.maxCamberPercent = ByteOrder::getDouble(ByteOrder::loadLittleEndian(header + 32, 8));
+    record.maxCamberPositionPercent = ByteOrder::getDouble(ByteOrder::loadLittleEndian(header + 40, 8));
+    record.thicknessPercent = ByteOrder::getDouble(ByteOrder::loadLittleEndian(header + 48, 8));
+    const double *columns = reinterpret_cast<const double *>(header + blockHeaderBytes);
+    record.angles = columns;
+    record.lift = columns + record.angleCount;
+    record.drag = columns + 2 * record.angleCount;
+    record.moment = columns + 3 * record.angleCount;
+    record.pressure = record.panelCount > 0 ? columns + coefficientColumns * record.angleCount : nullptr;
+    return record;
+}
\ No newline at end of file
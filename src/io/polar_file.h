@@ -0,0 +1,102 @@
+#ifndef AIRFOILS_IO_POLARFILE_H_
+#define AIRFOILS_IO_POLARFILE_H_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "naca_sweep.h"
+
+namespace io
+{
+    /// @brief one case of a polar file, the arrays point into the mapped file and live as long as its reader
+    struct PolarRecord
+    {
+        /// @brief position of the case in its sweep
+        int index;
+
+        /// @brief point count of the airfoil
+        int pointCount;
+
+        /// @brief angles of attack of the polar
+        int angleCount;
+
+        /// @brief pressure coefficients of each angle, 0 when they were not stored
+        int panelCount;
+
+        /// @brief maximum camber as a percentage of the chord
+        double maxCamberPercent;
+
+        /// @brief the distance of maximum camber from the leading edge in tenths of the chord
+        double maxCamberPositionPercent;
+
+        /// @brief maximum thickness as a percentage of the chord
+        double thicknessPercent;
+
+        /// @brief angleCount angles of attack in degrees
+        const double *angles;
+
+        /// @brief angleCount lift coefficients
+        const double *lift;
+
+        /// @brief angleCount drag coefficients
+        const double *drag;
+
+        /// @brief angleCount moment coefficients
+        const double *moment;
+
+        /// @brief pressure coefficient of panel i at angle k at index k panelCount + i, null when panelCount is 0
+        const double *pressure;
+    };
+
+    /// @brief appends sweep cases to a polar file, a versioned little-endian format of a 64-byte file header followed by one block per case,
+    /// each a 64-byte header of the case parameters and counts and then the columns of angles, lift, drag, moment, and optionally pressure as 8-byte doubles
+    class PolarWriter
+    {
+    private:
+        std::ofstream mFile;
+
+    public:
+        /// @brief opens a polar file for appending, creating it with its header when it is missing or empty and dropping a partial block left by an interrupted append
+        /// @param path file path
+        explicit PolarWriter(const std::string &path);
+
+        /// @brief writes one case as a block and flushes it, so a reader opened afterwards sees it
+        /// @param sweepCase a solved case
+        void append(const aerodynamics::SweepCase &sweepCase);
+    };
+
+    /// @brief reads a polar file through a read-only memory map, only the block headers are visited and the columns are used in place
+    class PolarReader
+    {
+    private:
+        const unsigned char *mData;
+        std::size_t mMappedBytes, mValidBytes;
+        std::vector<std::size_t> mOffsets;
+
+    public:
+        /// @brief maps a polar file and indexes its blocks, a partial block at the end is ignored
+        /// @param path file path
+        explicit PolarReader(const std::string &path);
+
+        ~PolarReader();
+        PolarReader(const PolarReader &) = delete;
+        PolarReader &operator=(const PolarReader &) = delete;
+
+        /// @brief gets the cases in the file
+        /// @return block count
+        inline int caseCount() const { return mOffsets.size(); };
+
+        /// @brief gets the length of the file up to the end of its last complete block
+        /// @return byte count
+        inline std::size_t validBytes() const { return mValidBytes; };
+
+        /// @brief gets one case without copying its columns
+        /// @param k case position in the file, which is the append order
+        /// @return the case
+        io::PolarRecord getCase(int k) const;
+    };
+} // namespace io
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_ALIGNEDALLOCATOR_H_
+#define AIRFOILS_LINEAR_ALGEBRA_ALIGNEDALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace linear_algebra
+{
+    /// @brief an allocator that places the first element on an alignment byte boundary (a cache line by default)
+    /// @tparam T element type
+    /// @tparam alignment byte alignment, a power of two no smaller than the pointer size
+    template <typename T, std::size_t alignment = 64>
+    class AlignedAllocator
+    {
+    public:
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, alignment> other;
+        };
+
+        AlignedAllocator(){};
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, alignment> &){};
+
+        /// @brief allocates uninitialized aligned storage
+        /// @param count number of elements
+        /// @return pointer to the first element
+        T *allocate(std::size_t count)
+        {
+            if (count == 0)
+                return nullptr;
+            if (count > static_cast<std::size_t>(-1) / sizeof(T))
+                throw std::bad_alloc();
+            void *pointer = nullptr;
+#if defined(_WIN32)
+            pointer = _aligned_malloc(count * sizeof(T), alignment);
+#else
+            if (posix_memalign(&pointer, alignment, count * sizeof(T)) != 0)
+                pointer = nullptr;
+#endif
+            if (pointer == nullptr)
+                throw std::bad_alloc();
+            return static_cast<T *>(pointer);
+        }
+
+        /// @brief releases storage from allocate
+        /// @param pointer pointer to the first element
+        void deallocate(T *pointer, std::size_t)
+        {
+#if defined(_WIN32)
+            _aligned_free(pointer);
+#else
+            std::free(pointer);
+#endif
+        }
+    };
+
+    template <typename T, typename U, std::size_t alignment>
+    inline bool operator==(const AlignedAllocator<T, alignment> &, const AlignedAllocator<U, alignment> &) { return true; }
+
+    template <typename T, typename U, std::size_t alignment>
+    inline bool operator!=(const AlignedAllocator<T, alignment> &, const AlignedAllocator<U, alignment> &) { return false; }
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "block_jacobi_preconditioner.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "lu_factorization.h"
+#include "matrix.h"
+
+using linear_algebra::BlockJacobiPreconditioner;
+
+using linear_algebra::LUFactorization;
+using linear_algebra::Matrix;
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(const Matrix &a, int blockSize)
+{
+    if (!a.isSquare())
+        throw std::invalid_argument("The a matrix must be square");
+    if (blockSize < 1)
+        throw std::invalid_argument("The block size must be at least 1");
+
+    factorBlocks(a.rowCount(), blockSize, [&a](int i, int j)
+                 { return a(i, j); });
+}
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(int order, int blockSize, const std::function<double(int, int)> &entry)
+{
+    if (order < 0)
+        throw std::invalid_argument("The order must not be negative");
+    if (blockSize < 1)
+        throw std::invalid_argument("The block size must be at least 1");
+
+    factorBlocks(order, blockSize, entry);
+}
+
+void BlockJacobiPreconditioner::factorBlocks(int order, int blockSize, const std::function<double(int, int)> &entry)
+{
+    for (int start = 0; start < order; start += blockSize)
+    {
+        int size = std::min(blockSize, order - start);
+        Matrix block(size, size);
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; j++)
+                block(i, j) = entry(start + i, start + j);
+        mBlockStarts.push_back(start);
+        mBlocks.emplace_back(block);
+    }
+}
+
+void BlockJacobiPreconditioner::apply(const double *r, double *z) const
+{
+    for (int i = 0; i < mBlocks.size(); ++i)
+        mBlocks[i].solve(r + mBlockStarts[i], z + mBlockStarts[i]);
+}
\ No newline at end of file
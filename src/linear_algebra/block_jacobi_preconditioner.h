@@ -0,0 +1,42 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_BLOCKJACOBIPRECONDITIONER_H_
+#define AIRFOILS_LINEAR_ALGEBRA_BLOCKJACOBIPRECONDITIONER_H_
+
+#include <functional>
+#include <vector>
+
+#include "linear_operator.h"
+#include "lu_factorization.h"
+#include "matrix.h"
+
+namespace linear_algebra
+{
+    /// @brief a preconditioner that exactly inverts contiguous diagonal blocks of a matrix, which for ordered panels are the near-field interactions
+    class BlockJacobiPreconditioner : public Preconditioner
+    {
+    private:
+        std::vector<int> mBlockStarts;
+        std::vector<LUFactorization> mBlocks;
+
+        void factorBlocks(int order, int blockSize, const std::function<double(int, int)> &entry);
+
+    public:
+        /// @brief factors the diagonal blocks of the matrix
+        /// @param a square matrix
+        /// @param blockSize rows per diagonal block, the last block takes the remainder
+        BlockJacobiPreconditioner(const Matrix &a, int blockSize);
+
+        /// @brief factors the diagonal blocks of an operator that is never assembled
+        /// @param order operator order
+        /// @param blockSize rows per diagonal block, the last block takes the remainder
+        /// @param entry gives the entry at a row and column, only called inside the diagonal blocks
+        BlockJacobiPreconditioner(int order, int blockSize, const std::function<double(int, int)> &entry);
+
+        /// @brief gets the number of diagonal blocks
+        /// @return block count
+        inline int blockCount() const { return mBlocks.size(); };
+
+        void apply(const double *r, double *z) const override;
+    };
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "gmres.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "linear_operator.h"
+#include "profiler.h"
+
+using linear_algebra::GMRES;
+
+using linear_algebra::LinearOperator;
+using linear_algebra::Preconditioner;
+using linear_algebra::SolverReport;
+
+namespace
+{
+    double dot(const double *x, const double *y, int size)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < size; ++i)
+            sum += x[i] * y[i];
+        return sum;
+    }
+} // namespace
+
+GMRES::GMRES(double tolerance, int restart, int maxIterations) : mTolerance(tolerance), mRestart(restart), mMaxIterations(maxIterations)
+{
+    if (tolerance <= 0)
+        throw std::invalid_argument("The tolerance must be positive");
+    if (restart < 1)
+        throw std::invalid_argument("The restart must be at least 1");
+    if (maxIterations < 1)
+        throw std::invalid_argument("The maximum iterations must be at least 1");
+}
+
+SolverReport GMRES::solve(const LinearOperator &a, const std::vector<double> &b, std::vector<double> &x, const Preconditioner *preconditioner) const
+{
+    AIRFOILS_PROFILE_SCOPE("solve");
+    int n = a.size();
+    if (b.size() != n)
+        throw std::invalid_argument("The b vector size must match the operator size");
+    if (x.size() != n)
+        x.assign(n, 0.0);
+
+    SolverReport report;
+    double bNorm = std::sqrt(dot(b.data(), b.data(), n));
+    if (bNorm == 0.0)
+    {
+        std::fill(x.begin(), x.end(), 0.0);
+        report.converged = true;
+        return report;
+    }
+
+    int m = std::min(mRestart, n);
+    std::vector<double> basis(static_cast<std::size_t>(m + 1) * n);
+    std::vector<double> hessenberg(static_cast<std::size_t>(m + 1) * m);
+    std::vector<double> cosines(m), sines(m), g(m + 1), y(m);
+    std::vector<double> w(n), z(n);
+    for (;;)
+    {
+        // True residual r = b - Ax starts every cycle so the report never trusts the recurrence alone
+        a.apply(x.data(), w.data());
+        double *v0 = basis.data();
+        for (int i = 0; i < n; ++i)
+            v0[i] = b[i] - w[i];
+        double beta = std::sqrt(dot(v0, v0, n));
+        report.residual = beta / bNorm;
+        if (report.residual <= mTolerance)
+        {
+            report.converged = true;
+            break;
+        }
+        if (report.iterations >= mMaxIterations)
+            break;
+        if (report.iterations > 0)
+            report.restarts++;
+
+        for (int i = 0; i < n; ++i)
+            v0[i] /= beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+        int k = 0;
+        while (k < m && report.iterations < mMaxIterations)
+        {
+            report.iterations++;
+            // w = A M^-1 v_k
+            const double *vk = basis.data() + static_cast<std::size_t>(k) * n;
+            if (preconditioner != nullptr)
+            {
+                preconditioner->apply(vk, z.data());
+                a.apply(z.data(), w.data());
+            }
+            else
+                a.apply(vk, w.data());
+
+            // Modified Gram-Schmidt against the existing basis
+            double *h = hessenberg.data() + static_cast<std::size_t>(k) * (m + 1);
+            for (int j = 0; j <= k; j++)
+            {
+                const double *vj = basis.data() + static_cast<std::size_t>(j) * n;
+                h[j] = dot(w.data(), vj, n);
+                for (int i = 0; i < n; ++i)
+                    w[i] -= h[j] * vj[i];
+            }
+            h[k + 1] = std::sqrt(dot(w.data(), w.data(), n));
+            if (h[k + 1] != 0.0)
+            {
+                double *next = basis.data() + static_cast<std::size_t>(k + 1) * n;
+                for (int i = 0; i < n; ++i)
+                    next[i] = w[i] / h[k + 1];
+            }
+
+            // Reduce the new Hessenberg column to upper triangular form with Givens rotations
+            for (int j = 0; j < k; j++)
+            {
+                double rotated = cosines[j] * h[j] + sines[j] * h[j + 1];
+                h[j + 1] = -sines[j] * h[j] + cosines[j] * h[j + 1];
+                h[j] = rotated;
+            }
+            // A zero subdiagonal means the Krylov space is invariant and cannot grow
+            bool breakdown = h[k + 1] == 0.0;
+            double denominator = std::hypot(h[k], h[k + 1]);
+            cosines[k] = denominator != 0.0 ? h[k] / denominator : 1.0;
+            sines[k] = denominator != 0.0 ? h[k + 1] / denominator : 0.0;
+            h[k] = denominator;
+            h[k + 1] = 0.0;
+            g[k + 1] = -sines[k] * g[k];
+            g[k] = cosines[k] * g[k];
+            k++;
+            if (std::abs(g[k]) / bNorm <= mTolerance || breakdown)
+                break;
+        }
+
+        // Back substitution for the least squares coefficients then x += M^-1 V y
+        for (int i = k - 1; i >= 0; i--)
+        {
+            double sum = g[i];
+            for (int j = i + 1; j < k; j++)
+                sum -= hessenberg[static_cast<std::size_t>(j) * (m + 1) + i] * y[j];
+            double diagonal = hessenberg[static_cast<std::size_t>(i) * (m + 1) + i];
+            y[i] = diagonal != 0.0 ? sum / diagonal : 0.0;
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        for (int j = 0; j < k; j++)
+        {
+            const double *vj = basis.data() + static_cast<std::size_t>(j) * n;
+            for (int i = 0; i < n; ++i)
+                w[i] += y[j] * vj[i];
+        }
+        if (preconditioner != nullptr)
+        {
+            preconditioner->apply(w.data(), z.data());
+            for (int i = 0; i < n; ++i)
+                x[i] += z[i];
+        }
+        else
+            for (int i = 0; i < n; ++i)
+                x[i] += w[i];
+    }
+    AIRFOILS_PROFILE_COUNT(SolveIterations, report.iterations);
+    AIRFOILS_PROFILE_COUNT(SolveResidual, report.residual);
+    return report;
+}
\ No newline at end of file
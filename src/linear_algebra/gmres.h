@@ -0,0 +1,50 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_GMRES_H_
+#define AIRFOILS_LINEAR_ALGEBRA_GMRES_H_
+
+#include <vector>
+
+#include "linear_operator.h"
+
+namespace linear_algebra
+{
+    /// @brief the outcome of an iterative solve
+    struct SolverReport
+    {
+        /// @brief operator applications performed
+        int iterations = 0;
+
+        /// @brief Krylov subspace restarts performed
+        int restarts = 0;
+
+        /// @brief final true residual norm relative to the right-hand side norm
+        double residual = 0.0;
+
+        /// @brief indicates if the residual reached the tolerance
+        bool converged = false;
+    };
+
+    /// @brief restarted generalized minimal residual solver with optional right preconditioning
+    class GMRES
+    {
+    private:
+        double mTolerance;
+        int mRestart, mMaxIterations;
+
+    public:
+        /// @brief a solver that stops once the relative residual is at most the tolerance
+        /// @param tolerance relative residual ||b - Ax|| / ||b|| to reach
+        /// @param restart Krylov subspace size before restarting
+        /// @param maxIterations maximum operator applications
+        GMRES(double tolerance = 1e-10, int restart = 50, int maxIterations = 1000);
+
+        /// @brief solves Ax = b, the residual is measured on the unpreconditioned system
+        /// @param a square operator
+        /// @param b right-hand side
+        /// @param x initial guess if it has a.size() entries, otherwise zero, replaced by the solution
+        /// @param preconditioner optional right preconditioner
+        /// @return iteration count and final residual
+        SolverReport solve(const LinearOperator &a, const std::vector<double> &b, std::vector<double> &x, const Preconditioner *preconditioner = nullptr) const;
+    };
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
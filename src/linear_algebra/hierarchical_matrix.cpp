@@ -0,0 +1,286 @@
+#include "hierarchical_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.h"
+
+using linear_algebra::HierarchicalMatrix;
+
+using concurrency::ThreadPool;
+using linear_algebra::HierarchicalOptions;
+
+HierarchicalMatrix::HierarchicalMatrix(const std::vector<double> &x, const std::vector<double> &y, const RowFunction &row, const HierarchicalOptions &options)
+{
+    if (x.empty())
+        throw std::invalid_argument("The points must not be empty");
+    if (x.size() != y.size())
+        throw std::invalid_argument("The x and y of the points must have the same size");
+    if (!(options.tolerance > 0))
+        throw std::invalid_argument("The tolerance must be positive");
+    if (options.leafSize < 1)
+        throw std::invalid_argument("The leaf size must be at least one");
+    if (!(options.eta > 0))
+        throw std::invalid_argument("The admissibility must be positive");
+
+    mClusters.push_back(Cluster{0, static_cast<int>(x.size()), 0, 0.0, 0.0, 0.0, 0.0});
+    splitCluster(0, x, y, options.leafSize);
+    mBlocks.push_back(Block{0, 0, 0, 0, std::vector<double>()});
+    splitBlock(0, options.eta);
+
+    // every leaf block is computed independently, the far-field ones by cross approximation
+    for (int b = 0; b < mBlocks.size(); ++b)
+        if (mBlocks[b].firstChild == 0)
+            mLeaves.push_back(b);
+    ThreadPool::shared().parallelFor(0, mLeaves.size(), 1, [&](int leafBegin, int leafEnd)
+                                     {
+        for (int k = leafBegin; k < leafEnd; ++k)
+        {
+            Block &block = mBlocks[mLeaves[k]];
+            if (block.rank == 0)
+                approximate(block, row, options.tolerance);
+            else
+                fillDense(block, row);
+        } });
+}
+
+void HierarchicalMatrix::splitCluster(int cluster, const std::vector<double> &x, const std::vector<double> &y, int leafSize)
+{
+    Cluster &node = mClusters[cluster];
+    node.minX = node.maxX = x[node.begin];
+    node.minY = node.maxY = y[node.begin];
+    for (int i = node.begin + 1; i < node.end; ++i)
+    {
+        node.minX = std::min(node.minX, x[i]);
+        node.maxX = std::max(node.maxX, x[i]);
+        node.minY = std::min(node.minY, y[i]);
+        node.maxY = std::max(node.maxY, y[i]);
+    }
+    if (node.end - node.begin <= leafSize)
+        return;
+
+    // halves of the index range, the children are adjacent so the first child index identifies both
+    int begin = node.begin;
+    int middle = node.begin + (node.end - node.begin) / 2;
+    int end = node.end;
+    int firstChild = mClusters.size();
+    mClusters[cluster].firstChild = firstChild;
+    mClusters.push_back(Cluster{begin, middle, 0, 0.0, 0.0, 0.0, 0.0});
+    mClusters.push_back(Cluster{middle, end, 0, 0.0, 0.0, 0.0, 0.0});
+    splitCluster(firstChild, x, y, leafSize);
+    splitCluster(firstChild + 1, x, y, leafSize);
+}
+
+bool HierarchicalMatrix::isAdmissible(const Cluster &row, const Cluster &column, double eta) const
+{
+    double rowDiameter = std::hypot(row.maxX - row.minX, row.maxY - row.minY);
+    double columnDiameter = std::hypot(column.maxX - column.minX, column.maxY - column.minY);
+    double gapX = std::max(0.0, std::max(row.minX - column.maxX, column.minX - row.maxX));
+    double gapY = std::max(0.0, std::max(row.minY - column.maxY, column.minY - row.maxY));
+    double distance = std::hypot(gapX, gapY);
+    return distance > 0 && std::min(rowDiameter, columnDiameter) <= eta * distance;
+}
+
+void HierarchicalMatrix::splitBlock(int block, double eta)
+{
+    // a rank of 0 marks a leaf for cross approximation and -1 a dense leaf
+    int rowCluster = mBlocks[block].rowCluster;
+    int columnCluster = mBlocks[block].columnCluster;
+    const Cluster &row = mClusters[rowCluster];
+    const Cluster &column = mClusters[columnCluster];
+    if (isAdmissible(row, column, eta))
+        return;
+    if (row.firstChild == 0 || column.firstChild == 0)
+    {
+        mBlocks[block].rank = -1;
+        return;
+    }
+
+    int firstChild = mBlocks.size();
+    mBlocks[block].firstChild = firstChild;
+    for (int r = 0; r < 2; ++r)
+        for (int c = 0; c < 2; c++)
+            mBlocks.push_back(Block{mClusters[rowCluster].firstChild + r, mClusters[columnCluster].firstChild + c, 0, 0, std::vector<double>()});
+    for (int k = 0; k < 4; ++k)
+        splitBlock(firstChild + k, eta);
+}
+
+void HierarchicalMatrix::fillDense(Block &block, const RowFunction &row) const
+{
+    const Cluster &rows = mClusters[block.rowCluster];
+    const Cluster &columns = mClusters[block.columnCluster];
+    int columnCount = columns.end - columns.begin;
+    block.rank = -1;
+    block.values.resize(static_cast<std::size_t>(rows.end - rows.begin) * columnCount);
+    for (int i = rows.begin; i < rows.end; ++i)
+        row(i, columns.begin, columns.end, block.values.data() + static_cast<std::size_t>(i - rows.begin) * columnCount);
+}
+
+void HierarchicalMatrix::approximate(Block &block, const RowFunction &row, double tolerance) const
+{
+    // Partially pivoted adaptive cross approximation: each step takes a residual row and column through the largest entry,
+    // the block is u_1 v_1^T + ... + u_k v_k^T with the u stored first, and stops once |u_k| |v_k| is within the tolerance of the running Frobenius norm
+    const Cluster &rows = mClusters[block.rowCluster];
+    const Cluster &columns = mClusters[block.columnCluster];
+    int m = rows.end - rows.begin;
+    int n = columns.end - columns.begin;
+    std::vector<double> us, vs;
+    std::vector<double> u(m), v(n);
+    std::vector<bool> usedRows(m, false);
+    double normSquared = 0.0;
+    int rank = 0;
+    int pivotRow = 0;
+    while (rank < std::min(m, n))
+    {
+        usedRows[pivotRow] = true;
+        row(rows.begin + pivotRow, columns.begin, columns.end, v.data());
+        for (int l = 0; l < rank; ++l)
+            for (int j = 0; j < n; j++)
+                v[j] -= us[static_cast<std::size_t>(l) * m + pivotRow] * vs[static_cast<std::size_t>(l) * n + j];
+        int pivotColumn = 0;
+        for (int j = 1; j < n; j++)
+            if (std::abs(v[j]) > std::abs(v[pivotColumn]))
+                pivotColumn = j;
+
+        if (v[pivotColumn] != 0)
+        {
+            double pivot = v[pivotColumn];
+            for (int j = 0; j < n; j++)
+                v[j] /= pivot;
+            for (int i = 0; i < m; ++i)
+            {
+                row(rows.begin + i, columns.begin + pivotColumn, columns.begin + pivotColumn + 1, &u[i]);
+                for (int l = 0; l < rank; l++)
+                    u[i] -= us[static_cast<std::size_t>(l) * m + i] * vs[static_cast<std::size_t>(l) * n + pivotColumn];
+            }
+
+            // |S_k|^2 = |S_k-1|^2 + 2 sum over l of (u_k . u_l)(v_k . v_l) + |u_k|^2 |v_k|^2
+            double uNorm = 0.0;
+            double vNorm = 0.0;
+            for (int i = 0; i < m; ++i)
+                uNorm += u[i] * u[i];
+            for (int j = 0; j < n; ++j)
+                vNorm += v[j] * v[j];
+            for (int l = 0; l < rank; ++l)
+            {
+                double uDot = 0.0;
+                double vDot = 0.0;
+                for (int i = 0; i < m; i++)
+                    uDot += u[i] * us[static_cast<std::size_t>(l) * m + i];
+                for (int j = 0; j < n; j++)
+                    vDot += v[j] * vs[static_cast<std::size_t>(l) * n + j];
+                normSquared += 2.0 * uDot * vDot;
+            }
+            normSquared += uNorm * vNorm;
+            us.insert(us.end(), u.begin(), u.end());
+            vs.insert(vs.end(), v.begin(), v.end());
+            rank++;
+            if (uNorm * vNorm <= tolerance * tolerance * normSquared)
+                break;
+        }
+
+        // the next pivot row is the unused row of largest residual in the last column
+        int next = -1;
+        for (int i = 0; i < m; ++i)
+            if (!usedRows[i] && (next < 0 || (v[pivotColumn] != 0 && std::abs(u[i]) > std::abs(u[next]))))
+                next = i;
+        if (next < 0)
+            break;
+        pivotRow = next;
+    }
+
+    // a block whose rank does not save storage is kept dense
+    if (static_cast<std::size_t>(rank) * (m + n) >= static_cast<std::size_t>(m) * n)
+    {
+        fillDense(block, row);
+        return;
+    }
+    block.rank = rank;
+    block.values = us;
+    block.values.insert(block.values.end(), vs.begin(), vs.end());
+}
+
+void HierarchicalMatrix::apply(const double *x, double *y) const
+{
+    std::fill(y, y + size(), 0.0);
+    std::vector<double> projections;
+    for (int b : mLeaves)
+    {
+        const Block &block = mBlocks[b];
+        const Cluster &rows = mClusters[block.rowCluster];
+        const Cluster &columns = mClusters[block.columnCluster];
+        int m = rows.end - rows.begin;
+        int n = columns.end - columns.begin;
+        const double *values = block.values.data();
+        if (block.rank < 0)
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                double sum = 0.0;
+                for (int j = 0; j < n; j++)
+                    sum += values[static_cast<std::size_t>(i) * n + j] * x[columns.begin + j];
+                y[rows.begin + i] += sum;
+            }
+            continue;
+        }
+
+        // y += U (V^T x)
+        const double *vs = values + static_cast<std::size_t>(block.rank) * m;
+        projections.assign(block.rank, 0.0);
+        for (int l = 0; l < block.rank; ++l)
+            for (int j = 0; j < n; j++)
+                projections[l] += vs[static_cast<std::size_t>(l) * n + j] * x[columns.begin + j];
+        for (int l = 0; l < block.rank; ++l)
+            for (int i = 0; i < m; i++)
+                y[rows.begin + i] += projections[l] * values[static_cast<std::size_t>(l) * m + i];
+    }
+}
+
+double HierarchicalMatrix::entry(int i, int j) const
+{
+    if (i < 0 || i >= size() || j < 0 || j >= size())
+        throw std::invalid_argument("The row and column must be inside the matrix");
+
+    int b = 0;
+    while (mBlocks[b].firstChild != 0)
+    {
+        int child = mBlocks[b].firstChild;
+        // the children are ordered by the row half and then the column half
+        if (i >= mClusters[mBlocks[child].rowCluster].end)
+            child += 2;
+        if (j >= mClusters[mBlocks[child].columnCluster].end)
+            child += 1;
+        b = child;
+    }
+    const Block &block = mBlocks[b];
+    const Cluster &rows = mClusters[block.rowCluster];
+    const Cluster &columns = mClusters[block.columnCluster];
+    int m = rows.end - rows.begin;
+    int n = columns.end - columns.begin;
+    if (block.rank < 0)
+        return block.values[static_cast<std::size_t>(i - rows.begin) * n + (j - columns.begin)];
+    double sum = 0.0;
+    for (int l = 0; l < block.rank; ++l)
+        sum += block.values[static_cast<std::size_t>(l) * m + (i - rows.begin)] * block.values[static_cast<std::size_t>(block.rank) * m + static_cast<std::size_t>(l) * n + (j - columns.begin)];
+    return sum;
+}
+
+int HierarchicalMatrix::lowRankBlockCount() const
+{
+    int count = 0;
+    for (int b : mLeaves)
+        if (mBlocks[b].rank >= 0)
+            count++;
+    return count;
+}
+
+std::size_t HierarchicalMatrix::storedValueCount() const
+{
+    std::size_t count = 0;
+    for (int b : mLeaves)
+        count += mBlocks[b].values.size();
+    return count;
+}
\ No newline at end of file
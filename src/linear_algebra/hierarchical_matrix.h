@@ -0,0 +1,83 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_HIERARCHICALMATRIX_H_
+#define AIRFOILS_LINEAR_ALGEBRA_HIERARCHICALMATRIX_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "linear_operator.h"
+
+namespace linear_algebra
+{
+    /// @brief compression settings of a hierarchical matrix
+    struct HierarchicalOptions
+    {
+        /// @brief relative Frobenius accuracy of each low-rank block
+        double tolerance = 1e-10;
+
+        /// @brief maximum indices of a leaf cluster, blocks of two leaves are stored dense
+        int leafSize = 32;
+
+        /// @brief admissibility, two clusters form a low-rank block when the smaller diameter is at most eta times their distance
+        double eta = 1.0;
+    };
+
+    /// @brief a square matrix stored as a tree of dense near-field blocks and low-rank far-field blocks from adaptive cross approximation, so memory and products cost O(N log N)
+    class HierarchicalMatrix : public LinearOperator
+    {
+    public:
+        /// @brief computes the entries of row i in the columns [columnBegin, columnEnd) into values[j - columnBegin]
+        typedef std::function<void(int i, int columnBegin, int columnEnd, double *values)> RowFunction;
+
+    private:
+        struct Cluster
+        {
+            int begin, end, firstChild;
+            double minX, maxX, minY, maxY;
+        };
+
+        struct Block
+        {
+            int rowCluster, columnCluster, firstChild, rank;
+            std::vector<double> values;
+        };
+
+        std::vector<Cluster> mClusters;
+        std::vector<Block> mBlocks;
+        std::vector<int> mLeaves;
+
+        void splitCluster(int cluster, const std::vector<double> &x, const std::vector<double> &y, int leafSize);
+        void splitBlock(int block, double eta);
+        bool isAdmissible(const Cluster &row, const Cluster &column, double eta) const;
+        void fillDense(Block &block, const RowFunction &row) const;
+        void approximate(Block &block, const RowFunction &row, double tolerance) const;
+
+    public:
+        /// @brief compresses a matrix whose indices carry points, ordered so that contiguous index ranges are compact like panels along a contour
+        /// @param x x of the point of each index
+        /// @param y y of the point of each index
+        /// @param row computes row entries, called concurrently from the shared thread pool
+        /// @param options compression settings
+        HierarchicalMatrix(const std::vector<double> &x, const std::vector<double> &y, const RowFunction &row, const HierarchicalOptions &options = HierarchicalOptions());
+
+        inline int size() const override { return mClusters.front().end; };
+
+        void apply(const double *x, double *y) const override;
+
+        /// @brief gets one entry, exact in dense blocks and to the tolerance in low-rank blocks
+        /// @param i row
+        /// @param j column
+        /// @return the entry
+        double entry(int i, int j) const;
+
+        /// @brief gets the number of low-rank blocks
+        /// @return low-rank leaf count
+        int lowRankBlockCount() const;
+
+        /// @brief gets the stored values, which is size()^2 for a dense matrix
+        /// @return the value count of all blocks
+        std::size_t storedValueCount() const;
+    };
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_LINEAROPERATOR_H_
+#define AIRFOILS_LINEAR_ALGEBRA_LINEAROPERATOR_H_
+
+#include "matrix.h"
+
+namespace linear_algebra
+{
+    /// @brief a square linear map known only through its products with vectors
+    class LinearOperator
+    {
+    public:
+        virtual ~LinearOperator(){};
+
+        /// @brief gets the row and column count of the operator
+        /// @return operator order
+        virtual int size() const = 0;
+
+        /// @brief computes y = Ax
+        /// @param x input vector of size() entries
+        /// @param y output vector of size() entries that does not overlap x
+        virtual void apply(const double *x, double *y) const = 0;
+    };
+
+    /// @brief an approximate inverse of a linear operator used to accelerate iterative solvers
+    class Preconditioner
+    {
+    public:
+        virtual ~Preconditioner(){};
+
+        /// @brief computes z = M^-1 r
+        /// @param r input vector
+        /// @param z output vector that does not overlap r
+        virtual void apply(const double *r, double *z) const = 0;
+    };
+
+    /// @brief a linear operator backed by a dense square matrix
+    class MatrixOperator : public LinearOperator
+    {
+    private:
+        const Matrix &mMatrix;
+
+    public:
+        /// @brief an operator that multiplies by the matrix, which must outlive the operator
+        /// @param matrix square matrix
+        MatrixOperator(const Matrix &matrix) : mMatrix(matrix){};
+
+        inline int size() const override { return mMatrix.rowCount(); };
+
+        inline void apply(const double *x, double *y) const override { mMatrix.multiply(x, y); };
+    };
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
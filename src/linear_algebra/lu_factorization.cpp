@@ -0,0 +1,371 @@
+#include "lu_factorization.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lu_kernels.h"
+#include "matrix.h"
+#include "profiler.h"
+#include "thread_pool.h"
+
+using linear_algebra::LUFactorization;
+
+using concurrency::ThreadPool;
+using linear_algebra::LUKernels;
+using linear_algebra::Matrix;
+
+namespace
+{
+    // Columns factored together before the trailing matrix is updated
+    const int panelWidth = 64;
+
+    // Trailing columns updated together so the rows of U stay in cache
+    const int columnBlockWidth = 512;
+
+    // Trailing updates with fewer multiply-adds stay on the calling thread
+    const double parallelWorkThreshold = 4.0e6;
+
+    /// @brief runs function(rowBegin, rowEnd) over contiguous slices of [begin, end) on the shared thread pool
+    template <typename Function>
+    void parallelRows(int begin, int end, double work, Function function)
+    {
+        ThreadPool &pool = ThreadPool::shared();
+        int threadCount = std::min(pool.threadCount(), (end - begin) / 4);
+        if (threadCount <= 1 || work < parallelWorkThreshold)
+        {
+            function(begin, end);
+            return;
+        }
+        pool.parallelFor(begin, end, (end - begin + threadCount - 1) / threadCount, function);
+    }
+
+    /// @brief factors columns [k0, k0 + width) of every row from k0 down, applying each row swap to the whole row
+    void factorPanel(Matrix &lu, std::vector<int> &pivots, int k0, int width)
+    {
+        int order = lu.rowCount();
+        for (int k = k0; k < k0 + width; ++k)
+        {
+            // Pick the largest remaining entry of the column as the pivot
+            int pivot = k;
+            double pivotMagnitude = std::abs(lu(k, k));
+            for (int i = k + 1; i < order; i++)
+                if (std::abs(lu(i, k)) > pivotMagnitude)
+                {
+                    pivot = i;
+                    pivotMagnitude = std::abs(lu(i, k));
+                }
+            if (pivotMagnitude == 0.0)
+                throw std::invalid_argument("The a matrix must not be singular");
+            if (pivot != k)
+            {
+                std::swap_ranges(lu[k], lu[k] + order, lu[pivot]);
+                std::swap(pivots[k], pivots[pivot]);
+            }
+
+            // Eliminate below the pivot inside the panel only
+            const double *pivotRow = lu[k];
+            double inversePivot = 1 / pivotRow[k];
+            for (int i = k + 1; i < order; i++)
+            {
+                double *row = lu[i];
+                double multiplier = row[k] * inversePivot;
+                row[k] = multiplier;
+                if (multiplier == 0.0)
+                    continue;
+                for (int j = k + 1; j < k0 + width; j++)
+                    row[j] -= multiplier * pivotRow[j];
+            }
+        }
+    }
+
+    /// @brief solves L11 U12 = A12 in place for the panel rows, where L11 has a unit diagonal
+    void solvePanelRows(Matrix &lu, int k0, int width)
+    {
+        int order = lu.rowCount();
+        for (int i = k0 + 1; i < k0 + width; ++i)
+        {
+            double *__restrict row = lu[i];
+            for (int p = k0; p < i; p++)
+            {
+                double l = row[p];
+                const double *__restrict u = lu[p];
+                for (int j = k0 + width; j < order; j++)
+                    row[j] -= l * u[j];
+            }
+        }
+    }
+
+    /// @brief subtracts the product of four rows of L21 and a packed 8 column strip of U12 from four rows of A22
+    inline void updateTile(int width, const double *l0, const double *l1, const double *l2, const double *l3, const double *strip, double *r0, double *r1, double *r2, double *r3)
+    {
+        double tile[4][8] = {};
+        for (int p = 0; p < width; p++)
+        {
+            const double *u = strip + p * 8;
+            for (int t = 0; t < 8; t++)
+            {
+                tile[0][t] += l0[p] * u[t];
+                tile[1][t] += l1[p] * u[t];
+                tile[2][t] += l2[p] * u[t];
+                tile[3][t] += l3[p] * u[t];
+            }
+        }
+        for (int t = 0; t < 8; t++)
+        {
+            r0[t] -= tile[0][t];
+            r1[t] -= tile[1][t];
+            r2[t] -= tile[2][t];
+            r3[t] -= tile[3][t];
+        }
+    }
+
+    /// @brief updates the tiles of four rows
+    int updateTiles(double *lu, int stride, int k0, int width, int rowBegin, int rowEnd, int columnBegin, int columnEnd, const double *packed)
+    {
+        int i = rowBegin;
+        for (; i + 4 <= rowEnd; i += 4)
+        {
+            double *r0 = lu + (std::size_t)i * stride;
+            double *r1 = r0 + stride;
+            double *r2 = r1 + stride;
+            double *r3 = r2 + stride;
+            for (int j = columnBegin; j < columnEnd; j += 8)
+                updateTile(width, r0 + k0, r1 + k0, r2 + k0, r3 + k0, packed + (std::size_t)(j - columnBegin) * width, r0 + j, r1 + j, r2 + j, r3 + j);
+        }
+        return i;
+    }
+
+    // The portable kernels, compiled for the baseline target like the rest of the solver
+    const linear_algebra::LUKernels scalarKernels = {1, updateTiles};
+
+    /// @brief the kernels the compiler built and the CPU runs, from narrowest to widest
+    std::vector<const LUKernels *> findSupportedKernels()
+    {
+        std::vector<const LUKernels *> supported{linear_algebra::getScalarLUKernels()};
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        const LUKernels *avx2 = linear_algebra::getAvx2LUKernels();
+        if (avx2 != nullptr && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            supported.push_back(avx2);
+        const LUKernels *avx512 = linear_algebra::getAvx512LUKernels();
+        if (avx512 != nullptr && __builtin_cpu_supports("avx512f"))
+            supported.push_back(avx512);
+#endif
+        return supported;
+    }
+
+    /// @brief the kernels every factorization uses, chosen on first use
+    std::atomic<const LUKernels *> &getActiveKernels()
+    {
+        static std::atomic<const LUKernels *> kernels(findSupportedKernels().back());
+        return kernels;
+    }
+
+    /// @brief gets the scratch entries packPanelRows packs U12 into for a matrix order
+    std::size_t packedSize(int order)
+    {
+        return (std::size_t)panelWidth * order;
+    }
+
+    /// @brief packs U12, the panel rows right of the panel, into contiguous 8 column strips so every row slice of the trailing update reads them in order
+    void packPanelRows(const Matrix &lu, int k0, int width, double *packed)
+    {
+        int order = lu.rowCount();
+        int kEnd = k0 + width;
+        int stripEnd = kEnd + (order - kEnd) / 8 * 8;
+        for (int j = kEnd; j < stripEnd; j += 8)
+        {
+            double *strip = packed + (std::size_t)(j - kEnd) * width;
+            for (int p = 0; p < width; p++)
+                std::copy(lu[k0 + p] + j, lu[k0 + p] + j + 8, strip + p * 8);
+        }
+    }
+
+    /// @brief updates A22 -= L21 U12 for rows [rowBegin, rowEnd) a column block at a time, reading U12 packed by packPanelRows
+    void updateTrailingRows(Matrix &lu, int k0, int width, int rowBegin, int rowEnd, const double *packed, const LUKernels &kernels)
+    {
+        int order = lu.rowCount();
+        int kEnd = k0 + width;
+        for (int j0 = kEnd; j0 < order; j0 += columnBlockWidth)
+        {
+            int j1 = std::min(order, j0 + columnBlockWidth);
+            int stripEnd = j0 + (j1 - j0) / 8 * 8;
+            int i = kernels.updateTiles(lu.data(), lu.stride(), k0, width, rowBegin, rowEnd, j0, stripEnd, packed + (std::size_t)(j0 - kEnd) * width);
+            // Leftover rows and columns that do not fill a tile
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                double *r = lu[row];
+                int j = row < i ? stripEnd : j0;
+                for (; j < j1; j++)
+                {
+                    double sum = 0;
+                    for (int p = 0; p < width; p++)
+                        sum += r[k0 + p] * lu(k0 + p, j);
+                    r[j] -= sum;
+                }
+            }
+        }
+    }
+} // namespace
+
+LUFactorization::LUFactorization(const Matrix &a) : mLU(a), mPivots(a.rowCount()), mPacked(packedSize(a.rowCount()))
+{
+    AIRFOILS_PROFILE_SCOPE("factorization");
+    AIRFOILS_PROFILE_COUNT(Allocations, 1);
+    AIRFOILS_PROFILE_COUNT(MatrixBytes, static_cast<double>(a.rowCount()) * a.columnCount() * sizeof(double));
+    if (!a.isSquare())
+        throw std::invalid_argument("The a matrix must be square");
+    factorize(true);
+}
+
+LUFactorization::LUFactorization(int maxOrder) : mLU(maxOrder, maxOrder), mPivots(maxOrder), mPacked(packedSize(maxOrder))
+{
+    mLU.resize(0, 0);
+    mPivots.clear();
+}
+
+void LUFactorization::factor(const Matrix &a)
+{
+    AIRFOILS_PROFILE_SCOPE("factorization");
+    if (!a.isSquare())
+        throw std::invalid_argument("The a matrix must be square");
+
+    int order = a.rowCount();
+    mLU.resize(order, order);
+    std::copy(a.data(), a.data() + (std::size_t)order * order, mLU.data());
+    mPivots.resize(order);
+    mPacked.resize(packedSize(order));
+    factorize(false);
+}
+
+const LUKernels *linear_algebra::getScalarLUKernels()
+{
+    return &scalarKernels;
+}
+
+int LUFactorization::laneCount()
+{
+    return getActiveKernels().load(std::memory_order_relaxed)->laneCount;
+}
+
+std::vector<int> LUFactorization::getSupportedLaneCounts()
+{
+    std::vector<int> laneCounts;
+    for (const LUKernels *kernels : findSupportedKernels())
+        laneCounts.push_back(kernels->laneCount);
+    return laneCounts;
+}
+
+void LUFactorization::setLaneCount(int laneCount)
+{
+    for (const LUKernels *kernels : findSupportedKernels())
+        if (kernels->laneCount == laneCount)
+        {
+            getActiveKernels().store(kernels, std::memory_order_relaxed);
+            return;
+        }
+    throw std::invalid_argument("The lane count must be one of the supported lane counts");
+}
+
+void LUFactorization::factorize(bool parallel)
+{
+    int order = mLU.rowCount();
+    const LUKernels &kernels = *getActiveKernels().load(std::memory_order_relaxed);
+    for (int i = 0; i < order; ++i)
+        mPivots[i] = i;
+    // Right-looking blocked factorization, nearly all of the work is the trailing matrix update
+    for (int k0 = 0; k0 < order; k0 += panelWidth)
+    {
+        int width = std::min(panelWidth, order - k0);
+        factorPanel(mLU, mPivots, k0, width);
+        int trailing = order - k0 - width;
+        if (trailing == 0)
+            continue;
+        solvePanelRows(mLU, k0, width);
+        // U12 is packed once per panel and read by every row slice
+        packPanelRows(mLU, k0, width, mPacked.data());
+        if (!parallel)
+        {
+            updateTrailingRows(mLU, k0, width, k0 + width, order, mPacked.data(), kernels);
+            continue;
+        }
+        Matrix &lu = mLU;
+        const double *packed = mPacked.data();
+        parallelRows(k0 + width, order, (double)trailing * trailing * width, [&lu, k0, width, packed, &kernels](int rowBegin, int rowEnd)
+                     { updateTrailingRows(lu, k0, width, rowBegin, rowEnd, packed, kernels); });
+    }
+}
+
+Matrix LUFactorization::solve(const Matrix &b) const
+{
+    AIRFOILS_PROFILE_SCOPE("solve");
+    if (b.rowCount() != order())
+        throw std::invalid_argument("The a and b matricies must have a matching row count");
+
+    int count = order();
+    int columns = b.columnCount();
+    Matrix x(count, columns);
+    // Apply the row permutation
+    for (int i = 0; i < count; ++i)
+        std::copy(b[mPivots[i]], b[mPivots[i]] + columns, x[i]);
+    // solve Ly = Pb, every right-hand side column is updated together
+    for (int i = 0; i < count; ++i)
+    {
+        const double *luRow = mLU[i];
+        double *xRow = x[i];
+        for (int k = 0; k < i; k++)
+        {
+            double l = luRow[k];
+            if (l == 0.0)
+                continue;
+            const double *yRow = x[k];
+            for (int j = 0; j < columns; j++)
+                xRow[j] -= l * yRow[j];
+        }
+    }
+    // solve Ux = y
+    for (int i = count - 1; i >= 0; i--)
+    {
+        const double *luRow = mLU[i];
+        double *xRow = x[i];
+        for (int k = i + 1; k < count; k++)
+        {
+            double u = luRow[k];
+            const double *solvedRow = x[k];
+            for (int j = 0; j < columns; j++)
+                xRow[j] -= u * solvedRow[j];
+        }
+        double inverseDiagonal = 1 / luRow[i];
+        for (int j = 0; j < columns; j++)
+            xRow[j] *= inverseDiagonal;
+    }
+    return x;
+}
+
+void LUFactorization::solve(const double *b, double *x) const
+{
+    int count = order();
+    // solve Ly = Pb
+    for (int i = 0; i < count; ++i)
+    {
+        const double *luRow = mLU[i];
+        double sum = b[mPivots[i]];
+        for (int k = 0; k < i; k++)
+            sum -= luRow[k] * x[k];
+        x[i] = sum;
+    }
+    // solve Ux = y
+    for (int i = count - 1; i >= 0; i--)
+    {
+        const double *luRow = mLU[i];
+        double sum = x[i];
+        for (int k = i + 1; k < count; k++)
+            sum -= luRow[k] * x[k];
+        x[i] = sum / luRow[i];
+    }
+}
\ No newline at end of file
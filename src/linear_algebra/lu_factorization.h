@@ -0,0 +1,69 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_LUFACTORIZATION_H_
+#define AIRFOILS_LINEAR_ALGEBRA_LUFACTORIZATION_H_
+
+#include <vector>
+
+#include "matrix.h"
+
+namespace linear_algebra
+{
+    /// @brief a reusable PA = LU factorization with partial pivoting of a square matrix
+    class LUFactorization
+    {
+    private:
+        Matrix mLU;
+        std::vector<int> mPivots;
+        std::vector<double> mPacked;
+
+        void factorize(bool parallel);
+
+    public:
+        /// @brief gets the doubles the trailing update kernel holds in a vector register, the widest the CPU supports unless setLaneCount chose another
+        /// @return 8 with AVX-512, 4 with AVX2 and FMA, and 1 for the portable kernel
+        static int laneCount();
+
+        /// @brief gets the lane counts of the kernels built into the library that the CPU can run
+        /// @return the lane counts from narrowest to widest, always starting with 1
+        static std::vector<int> getSupportedLaneCounts();
+
+        /// @brief selects the kernel every later factorization uses, to compare the instruction sets against each other
+        /// @param laneCount one of getSupportedLaneCounts()
+        static void setLaneCount(int laneCount);
+
+        /// @brief factors the matrix once with a cache-blocked, multithreaded right-looking algorithm so any number of right-hand sides can be solved against it
+        /// @param a square A matrix
+        LUFactorization(const Matrix &a);
+
+        /// @brief an empty factorization with storage for matrices up to an order, to be filled by factor
+        /// @param maxOrder largest order factored without allocating
+        explicit LUFactorization(int maxOrder);
+
+        /// @brief replaces the factorization with that of another matrix on the calling thread, reusing the storage so nothing is allocated up to the reserved order
+        /// @param a square A matrix
+        void factor(const Matrix &a);
+
+        /// @brief gets the order of the factored matrix
+        /// @return row and column count of A
+        inline int order() const { return mLU.rowCount(); };
+
+        /// @brief gets the packed factors where L is below the unit diagonal and U is on and above it
+        /// @return packed L and U factors
+        inline const Matrix &getLU() const { return mLU; };
+
+        /// @brief gets the row permutation applied before factoring
+        /// @return row i of PA is row getPivots()[i] of A
+        inline const std::vector<int> &getPivots() const { return mPivots; };
+
+        /// @brief solves the system of linear equations for every column of B in a single pass
+        /// @param b B matrix with any number of columns
+        /// @return the solution x to Ax = B
+        Matrix solve(const Matrix &b) const;
+
+        /// @brief solves the system of linear equations for a single right-hand side without allocating
+        /// @param b right-hand side vector of order() entries
+        /// @param x solution vector of order() entries that does not overlap b
+        void solve(const double *b, double *x) const;
+    };
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "lu_kernels.h"
+
+// compiled with -mavx2 -mfma, the kernels only run once the CPU reports both
+#if defined(__GNUC__) && defined(__AVX2__) && defined(__FMA__)
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace
+{
+    /// @brief subtracts the product of four rows of L21 and a packed 8 column strip of U12 from four rows of A22, holding the tile in eight registers
+    inline void updateTile(int width, const double *l0, const double *l1, const double *l2, const double *l3, const double *strip, double *r0, double *r1, double *r2, double *r3)
+    {
+        __m256d a0 = _mm256_setzero_pd(), b0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd(), b1 = _mm256_setzero_pd();
+        __m256d a2 = _mm256_setzero_pd(), b2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd(), b3 = _mm256_setzero_pd();
+        for (int p = 0; p < width; p++)
+        {
+            __m256d ua = _mm256_loadu_pd(strip + p * 8);
+            __m256d ub = _mm256_loadu_pd(strip + p * 8 + 4);
+            __m256d l = _mm256_broadcast_sd(l0 + p);
+            a0 = _mm256_fmadd_pd(l, ua, a0);
+            b0 = _mm256_fmadd_pd(l, ub, b0);
+            l = _mm256_broadcast_sd(l1 + p);
+            a1 = _mm256_fmadd_pd(l, ua, a1);
+            b1 = _mm256_fmadd_pd(l, ub, b1);
+            l = _mm256_broadcast_sd(l2 + p);
+            a2 = _mm256_fmadd_pd(l, ua, a2);
+            b2 = _mm256_fmadd_pd(l, ub, b2);
+            l = _mm256_broadcast_sd(l3 + p);
+            a3 = _mm256_fmadd_pd(l, ua, a3);
+            b3 = _mm256_fmadd_pd(l, ub, b3);
+        }
+        _mm256_storeu_pd(r0, _mm256_sub_pd(_mm256_loadu_pd(r0), a0));
+        _mm256_storeu_pd(r0 + 4, _mm256_sub_pd(_mm256_loadu_pd(r0 + 4), b0));
+        _mm256_storeu_pd(r1, _mm256_sub_pd(_mm256_loadu_pd(r1), a1));
+        _mm256_storeu_pd(r1 + 4, _mm256_sub_pd(_mm256_loadu_pd(r1 + 4), b1));
+        _mm256_storeu_pd(r2, _mm256_sub_pd(_mm256_loadu_pd(r2), a2));
+        _mm256_storeu_pd(r2 + 4, _mm256_sub_pd(_mm256_loadu_pd(r2 + 4), b2));
+        _mm256_storeu_pd(r3, _mm256_sub_pd(_mm256_loadu_pd(r3), a3));
+        _mm256_storeu_pd(r3 + 4, _mm256_sub_pd(_mm256_loadu_pd(r3 + 4), b3));
+    }
+
+    /// @brief updates the tiles of four rows
+    int updateTiles(double *lu, int stride, int k0, int width, int rowBegin, int rowEnd, int columnBegin, int columnEnd, const double *packed)
+    {
+        int i = rowBegin;
+        for (; i + 4 <= rowEnd; i += 4)
+        {
+            double *r0 = lu + (std::size_t)i * stride;
+            double *r1 = r0 + stride;
+            double *r2 = r1 + stride;
+            double *r3 = r2 + stride;
+            for (int j = columnBegin; j < columnEnd; j += 8)
+                updateTile(width, r0 + k0, r1 + k0, r2 + k0, r3 + k0, packed + (std::size_t)(j - columnBegin) * width, r0 + j, r1 + j, r2 + j, r3 + j);
+        }
+        return i;
+    }
+
+    // The kernels of this translation unit
+    const linear_algebra::LUKernels kernels = {4, updateTiles};
+} // namespace
+
+const linear_algebra::LUKernels *linear_algebra::getAvx2LUKernels()
+{
+    return &kernels;
+}
+#else
+const linear_algebra::LUKernels *linear_algebra::getAvx2LUKernels()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "lu_kernels.h"
+
+// compiled with -mavx512f, the kernels only run once the CPU reports it
+#if defined(__GNUC__) && defined(__AVX512F__)
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace
+{
+    /// @brief subtracts the product of eight rows of L21 and a packed 8 column strip of U12 from eight rows of A22, one register per row of the tile
+    inline void updateTile(int width, double *const *rows, int k0, const double *strip, int j)
+    {
+        __m512d sums[8];
+        for (int t = 0; t < 8; t++)
+            sums[t] = _mm512_setzero_pd();
+        for (int p = 0; p < width; p++)
+        {
+            __m512d u = _mm512_loadu_pd(strip + p * 8);
+            for (int t = 0; t < 8; t++)
+                sums[t] = _mm512_fmadd_pd(_mm512_set1_pd(rows[t][k0 + p]), u, sums[t]);
+        }
+        for (int t = 0; t < 8; t++)
+            _mm512_storeu_pd(rows[t] + j, _mm512_sub_pd(_mm512_loadu_pd(rows[t] + j), sums[t]));
+    }
+
+    /// @brief updates the tiles of eight rows
+    int updateTiles(double *lu, int stride, int k0, int width, int rowBegin, int rowEnd, int columnBegin, int columnEnd, const double *packed)
+    {
+        int i = rowBegin;
+        for (; i + 8 <= rowEnd; i += 8)
+        {
+            double *rows[8];
+            for (int t = 0; t < 8; t++)
+                rows[t] = lu + (std::size_t)(i + t) * stride;
+            for (int j = columnBegin; j < columnEnd; j += 8)
+                updateTile(width, rows, k0, packed + (std::size_t)(j - columnBegin) * width, j);
+        }
+        return i;
+    }
+
+    // The kernels of this translation unit
+    const linear_algebra::LUKernels kernels = {8, updateTiles};
+} // namespace
+
+const linear_algebra::LUKernels *linear_algebra::getAvx512LUKernels()
+{
+    return &kernels;
+}
+#else
+const linear_algebra::LUKernels *linear_algebra::getAvx512LUKernels()
+{
+    return nullptr;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef AIRFOILS_LINEAR_ALGEBRA_LUKERNELS_H_
+#define AIRFOILS_LINEAR_ALGEBRA_LUKERNELS_H_
+
+namespace linear_algebra
+{
+    /// @brief the trailing matrix update of LUFactorization compiled for one instruction set, taking plain arrays so the translation units built for one instruction set compile no inline function the rest of the program shares
+    struct LUKernels
+    {
+        /// @brief doubles held in one vector register
+        int laneCount;
+
+        /// @brief subtracts L21 U12 from every tile of rows [rowBegin, rowEnd) and columns [columnBegin, columnEnd) the kernel fills, where the tiles are 8 columns wide and packed holds U12 as 8 column strips starting at columnBegin
+        /// @return the first row left to the caller, whose columns must all be updated by it
+        int (*updateTiles)(double *lu, int stride, int k0, int width, int rowBegin, int rowEnd, int columnBegin, int columnEnd, const double *packed);
+    };
+
+    /// @brief gets the portable kernels
+    /// @return the scalar kernels
+    const LUKernels *getScalarLUKernels();
+
+    /// @brief gets the kernels for AVX2 with FMA
+    /// @return the AVX2 kernels, or null when the compiler could not build them
+    const LUKernels *getAvx2LUKernels();
+
+    /// @brief gets the kernels for AVX-512
+    /// @return the AVX-512 kernels, or null when the compiler could not build them
+    const LUKernels *getAvx512LUKernels();
+} // namespace linear_algebra
+
+#endif
\ No newline at end of file
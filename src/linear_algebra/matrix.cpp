@@ -1,10 +1,95 @@
 #include "matrix.h"
 
+#include <stdexcept>
+
+#include "lu_factorization.h"
 #include "point.h"
+#include "profiler.h"
 
 using linear_algebra::Matrix;
+using linear_algebra::StridedView;
 
 using geometry::Point;
+using linear_algebra::LUFactorization;
+
+Matrix::Matrix(int m, int n) : m(m), n(n)
+{
+    if (m < 0 || n < 0)
+        throw std::invalid_argument("The matrix dimensions must not be negative");
+    mData.assign(static_cast<std::size_t>(m) * n, 0.0);
+    AIRFOILS_PROFILE_COUNT(Allocations, 1);
+    AIRFOILS_PROFILE_COUNT(MatrixBytes, static_cast<double>(m) * n * sizeof(double));
+}
+
+Matrix::Matrix(const Point &point) : Matrix(3, 1)
+{
+    mData[0] = point.x;
+    mData[1] = point.y;
+    mData[2] = point.z;
+}
+
+void Matrix::resize(int m, int n)
+{
+    if (m < 0 || n < 0)
+        throw std::invalid_argument("The matrix dimensions must not be negative");
+    this->m = m;
+    this->n = n;
+    mData.assign(static_cast<std::size_t>(m) * n, 0.0);
+}
+
+double &Matrix::at(int i, int j)
+{
+    if (i < 0 || i >= m || j < 0 || j >= n)
+        throw std::out_of_range("The matrix index is out of range");
+    return (*this)(i, j);
+}
+
+double Matrix::at(int i, int j) const
+{
+    if (i < 0 || i >= m || j < 0 || j >= n)
+        throw std::out_of_range("The matrix index is out of range");
+    return (*this)(i, j);
+}
+
+StridedView<double> Matrix::row(int i)
+{
+    if (i < 0 || i >= m)
+        throw std::out_of_range("The row index is out of range");
+    return StridedView<double>((*this)[i], n, 1);
+}
+
+StridedView<const double> Matrix::row(int i) const
+{
+    if (i < 0 || i >= m)
+        throw std::out_of_range("The row index is out of range");
+    return StridedView<const double>((*this)[i], n, 1);
+}
+
+StridedView<double> Matrix::column(int j)
+{
+    if (j < 0 || j >= n)
+        throw std::out_of_range("The column index is out of range");
+    return StridedView<double>(data() + j, m, stride());
+}
+
+StridedView<const double> Matrix::column(int j) const
+{
+    if (j < 0 || j >= n)
+        throw std::out_of_range("The column index is out of range");
+    return StridedView<const double>(data() + j, m, stride());
+}
+
+void Matrix::multiply(const double *x, double *y) const
+{
+    for (int i = 0; i < m; ++i)
+    {
+        const double *row = (*this)[i];
+        double sum = 0.0;
+        for (int j = 0; j < n; j++)
+            sum += row[j] * x[j];
+        y[i] = sum;
+    }
+}
 
 Point Matrix::toPoint() const
 {
@@ -12,20 +97,19 @@ Point Matrix::toPoint() const
         throw std::invalid_argument("The matrix must have exactly three rows");
     if (columnCount() != 1)
         throw std::invalid_argument("The matrix must have exactly one column");
-    return Point{(*this)[0][0], (*this)[1][0], (*this)[2][0]};
+    return Point{(*this)(0, 0), (*this)(1, 0), (*this)(2, 0)};
 }
 
 Matrix Matrix::identity(int size)
 {
     Matrix m(size, size);
     for (int i = 0; i < size; ++i)
-        m.at(i).at(i) = 1;
+        m(i, i) = 1;
     return m;
 }
 
 Matrix Matrix::lowerUpperDecomposition(const Matrix &a, const Matrix &b)
 {
-    // TODO: throw an exception if leading principle minors are zero
     if (!a.isSquare())
         throw std::invalid_argument("The a matrix must be square");
     if (b.columnCount() != 1)
@@ -33,46 +117,7 @@ Matrix Matrix::lowerUpperDecomposition(const Matrix &a, const Matrix &b)
     if (a.rowCount() != b.rowCount())
         throw std::invalid_argument("The a and b matricies must have a matching row count");
 
-    int order = a.rowCount();
-    Matrix lu(order, order);
-    double sum = 0.0;
-    // decomposition
-    for (int i = 0; i < order; ++i)
-    {
-        for (int j = i; j < order; j++)
-        {
-            sum = 0;
-            for (int k = 0; k < i; k++)
-                sum += lu.at(i).at(k) * lu.at(k).at(j);
-            lu.at(i).at(j) = a.at(i).at(j) - sum;
-        }
-        for (int j = i + 1; j < order; j++)
-        {
-            sum = 0;
-            for (int k = 0; k < i; k++)
-                sum += lu.at(j).at(k) * lu.at(k).at(i);
-            lu.at(j).at(i) = (1 / lu.at(i).at(i)) * (a.at(j).at(i) - sum);
-        }
-    }
-    // solve Ly = b
-    Matrix y(order, 1);
-    for (int i = 0; i < order; ++i)
-    {
-        sum = 0;
-        for (int k = 0; k < i; k++)
-            sum += lu.at(i).at(k) * y.at(k).at(0);
-        y.at(i).at(0) = b.at(i).at(0) - sum;
-    }
-    // solve Ux = y
-    Matrix x(order, 1);
-    for (int i = order - 1; i >= 0; i--)
-    {
-        sum = 0;
-        for (int k = i + 1; k < order; k++)
-            sum += lu.at(i).at(k) * x.at(k).at(0);
-        x.at(i).at(0) = (1 / lu.at(i).at(i)) * (y.at(i).at(0) - sum);
-    }
-    return x;
+    return LUFactorization(a).solve(b);
 };
 
 Matrix linear_algebra::operator+(const Matrix &lhs, const Matrix &rhs)
@@ -82,23 +127,24 @@ Matrix linear_algebra::operator+(const Matrix &lhs, const Matrix &rhs)
     if (lhs.columnCount() != rhs.columnCount())
         throw std::invalid_argument("The matricies must have a matching column count");
 
-    int m = lhs.rowCount();
-    int n = lhs.columnCount();
-    Matrix matrix(m, n);
-    for (int i = 0; i < m; ++i)
-        for (int j = 0; j < n; j++)
-            matrix.at(i).at(j) = lhs.at(i).at(j) + rhs.at(i).at(j);
+    Matrix matrix(lhs.rowCount(), lhs.columnCount());
+    std::size_t size = static_cast<std::size_t>(lhs.rowCount()) * lhs.columnCount();
+    const double *l = lhs.data();
+    const double *r = rhs.data();
+    double *sum = matrix.data();
+    for (std::size_t i = 0; i < size; ++i)
+        sum[i] = l[i] + r[i];
     return matrix;
 }
 
 Matrix linear_algebra::operator*(double lhs, const Matrix &rhs)
 {
-    int m = rhs.rowCount();
-    int n = rhs.columnCount();
-    Matrix matrix(m, n);
-    for (int i = 0; i < m; ++i)
-        for (int j = 0; j < n; j++)
-            matrix.at(i).at(j) = lhs * rhs.at(i).at(j);
+    Matrix matrix(rhs.rowCount(), rhs.columnCount());
+    std::size_t size = static_cast<std::size_t>(rhs.rowCount()) * rhs.columnCount();
+    const double *r = rhs.data();
+    double *product = matrix.data();
+    for (std::size_t i = 0; i < size; ++i)
+        product[i] = lhs * r[i];
     return matrix;
 }
 
@@ -111,9 +157,18 @@ Matrix linear_algebra::operator*(const Matrix &lhs, const Matrix &rhs)
     int n = lhs.columnCount();
     int p = rhs.columnCount();
     Matrix matrix(m, p);
+    // i-k-j order so the innermost loop streams along rows of rhs and the product
     for (int i = 0; i < m; ++i)
-        for (int j = 0; j < p; j++)
-            for (int k = 0; k < n; k++)
-                matrix.at(i).at(j) += lhs.at(i).at(k) * rhs.at(k).at(j);
+    {
+        double *productRow = matrix[i];
+        const double *lhsRow = lhs[i];
+        for (int k = 0; k < n; k++)
+        {
+            double lhsEntry = lhsRow[k];
+            const double *rhsRow = rhs[k];
+            for (int j = 0; j < p; j++)
+                productRow[j] += lhsEntry * rhsRow[j];
+        }
+    }
     return matrix;
 }
\ No newline at end of file
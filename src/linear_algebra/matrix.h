@@ -1,27 +1,64 @@
 #ifndef AIRFOILS_LINEAR_ALGEBRA_MATRIX_H_
 #define AIRFOILS_LINEAR_ALGEBRA_MATRIX_H_
 
+#include <cstddef>
 #include <vector>
 
+#include "aligned_allocator.h"
 #include "point.h"
 
 namespace linear_algebra
 {
-    /// @brief a fixed size mxn matrix of doubles
-    class Matrix : public std::vector<std::vector<double>>
+    /// @brief a non-owning view of evenly spaced entries, such as a matrix row or column
+    /// @tparam T entry type, const qualified for read-only views
+    template <typename T>
+    class StridedView
+    {
+    private:
+        T *mData;
+        int mSize, mStride;
+
+    public:
+        /// @brief a view of size entries starting at data and spaced stride entries apart
+        /// @param data first entry
+        /// @param size entry count
+        /// @param stride distance between consecutive entries
+        StridedView(T *data, int size, int stride) : mData(data), mSize(size), mStride(stride){};
+
+        /// @brief gets the entry at an index without bounds checking
+        /// @param i index
+        /// @return entry reference
+        inline T &operator[](int i) const { return mData[static_cast<std::ptrdiff_t>(i) * mStride]; };
+
+        /// @brief gets the entry count
+        /// @return entry count
+        inline int size() const { return mSize; };
+
+        /// @brief gets the distance between consecutive entries
+        /// @return stride
+        inline int stride() const { return mStride; };
+
+        /// @brief gets the first entry
+        /// @return pointer to the first entry
+        inline T *data() const { return mData; };
+    };
+
+    /// @brief a fixed size mxn matrix of doubles stored in a single contiguous row-major buffer
+    class Matrix
     {
     private:
         int m, n;
+        std::vector<double, AlignedAllocator<double>> mData;
 
     public:
         /// @brief an mxn matrix filled with zeros
         /// @param m rows
         /// @param n columns
-        Matrix(int m, int n) : std::vector<std::vector<double>>(m, std::vector<double>(n)), m(m), n(n){};
+        Matrix(int m, int n);
 
         /// @brief a matrix with values extracted from the point
         /// @param point initial matrix values
-        Matrix(const geometry::Point &point) : std::vector<std::vector<double>>({{point.x}, {point.y}, {point.z}}), m(3), n(1){};
+        Matrix(const geometry::Point &point);
 
         /// @brief gets the matrix row count
         /// @return m
@@ -31,6 +68,82 @@ namespace linear_algebra
         /// @return n
         inline int columnCount() const { return n; };
 
+        /// @brief gets the distance in entries between the starts of consecutive rows
+        /// @return leading dimension of the row-major buffer
+        inline int stride() const { return n; };
+
+        /// @brief changes the dimensions and fills every entry with zeros, reusing the buffer when it already holds m x n entries
+        /// @param m rows
+        /// @param n columns
+        void resize(int m, int n);
+
+        /// @brief gets the row-major buffer
+        /// @return pointer to the first entry
+        inline double *data() { return mData.data(); };
+
+        /// @brief gets the row-major buffer
+        /// @return pointer to the first entry
+        inline const double *data() const { return mData.data(); };
+
+        /// @brief gets the entry at row i and column j without bounds checking
+        /// @param i row
+        /// @param j column
+        /// @return entry reference
+        inline double &operator()(int i, int j) { return mData[static_cast<std::size_t>(i) * n + j]; };
+
+        /// @brief gets the entry at row i and column j without bounds checking
+        /// @param i row
+        /// @param j column
+        /// @return entry value
+        inline double operator()(int i, int j) const { return mData[static_cast<std::size_t>(i) * n + j]; };
+
+        /// @brief gets the start of row i so entries can be read as m[i][j]
+        /// @param i row
+        /// @return pointer to the first entry of the row
+        inline double *operator[](int i) { return mData.data() + static_cast<std::size_t>(i) * n; };
+
+        /// @brief gets the start of row i so entries can be read as m[i][j]
+        /// @param i row
+        /// @return pointer to the first entry of the row
+        inline const double *operator[](int i) const { return mData.data() + static_cast<std::size_t>(i) * n; };
+
+        /// @brief gets the entry at row i and column j
+        /// @param i row
+        /// @param j column
+        /// @return entry reference
+        double &at(int i, int j);
+
+        /// @brief gets the entry at row i and column j
+        /// @param i row
+        /// @param j column
+        /// @return entry value
+        double at(int i, int j) const;
+
+        /// @brief gets a view of row i
+        /// @param i row
+        /// @return contiguous view of the row
+        StridedView<double> row(int i);
+
+        /// @brief gets a view of row i
+        /// @param i row
+        /// @return contiguous view of the row
+        StridedView<const double> row(int i) const;
+
+        /// @brief gets a view of column j
+        /// @param j column
+        /// @return view of the column strided by the row length
+        StridedView<double> column(int j);
+
+        /// @brief gets a view of column j
+        /// @param j column
+        /// @return view of the column strided by the row length
+        StridedView<const double> column(int j) const;
+
+        /// @brief computes the matrix-vector product y = Mx
+        /// @param x vector of columnCount() entries
+        /// @param y vector of rowCount() entries that does not overlap x
+        void multiply(const double *x, double *y) const;
+
         /// @brief creates a point from a 3x1 matrix
         /// @return point extracted from matrix
         geometry::Point toPoint() const;
@@ -43,8 +156,8 @@ namespace linear_algebra
         /// @return the identity matrix
         static Matrix identity(int size);
 
-        /// @brief factors a matrix solving the system of linear equations
-        /// @param a square A matrix
+        /// @brief factors a matrix with partial pivoting solving the system of linear equations, use LUFactorization to reuse the factors
+        /// @param a square non-singular A matrix
         /// @param b B matrix
         /// @return the solution x to Ax = B
         static Matrix lowerUpperDecomposition(const Matrix &a, const Matrix &b);
@@ -12,6 +12,7 @@
 #include "point.h"
 #include "polygon.h"
 #include "vector.h"
+#include "velocity_field.h"
 
 using std::map;
 using std::string;
@@ -21,8 +22,10 @@ using std::vector;
 namespace plt = matplotlibcpp;
 
 using aerodynamics::Airfoil;
+using aerodynamics::FieldGrid;
 using aerodynamics::Panel;
 using aerodynamics::PanelMethods;
+using aerodynamics::VelocityField;
 using geometry::Point;
 using geometry::Polygon;
 using geometry::Vector;
@@ -30,7 +33,7 @@ using geometry::Vector;
 /// @brief Plots a free-body diagram, velocity vector field, and contour plot
 int main()
 {
-    int pointCount = 100;                 // [20 200] even number
+    int pointCount = 100;                 // [20 20000] even number
     double maxCamberPercent = 2;          // [0 9.5]
     double maxCamberPositionPercent = 40; // [0 90]
     double thicknessPercent = 12;         // [1 40]
@@ -68,29 +71,34 @@ int main()
 
     // Build Velocity Grid
     int vectorGridSize = vectorGridLength * vectorGridHeight;
-    double gridDX = 2.0 / vectorGridLength;
-    double gridDY = 1.0 / vectorGridHeight;
+    FieldGrid grid;
+    grid.originX = -0.5;
+    grid.originY = -0.5;
+    grid.spacingX = 2.0 / vectorGridLength;
+    grid.spacingY = 1.0 / vectorGridHeight;
+    grid.columns = vectorGridLength;
+    grid.rows = vectorGridHeight;
+    VelocityField field = PanelMethods::computeVelocityField(rotatedPanels, grid);
     vector<double> gridX(vectorGridSize), gridY(vectorGridSize), gridU(vectorGridSize), gridW(vectorGridSize);
     vector<float> gridZ(vectorGridSize);
     for (int i = vectorGridHeight - 1; i >= 0; i--)
     {
-        double y = i * gridDY - 0.5;
+        double y = grid.originY + i * grid.spacingY;
         for (int j = 0; j < vectorGridLength; j++)
         {
             int index = i * vectorGridLength + j;
-            double x = j * gridDX - 0.5;
+            double x = grid.originX + j * grid.spacingX;
             // Ignore the point if it is inside of the airfoil
             if (airfoilPolygon.pointIsInside(Point(x, y, 0.0)))
             {
                 gridZ.at(index) = 0;
                 continue;
             }
-            Vector streamLine = PanelMethods::computeStreamline(rotatedPanels, Point(x, y, 0.0));
             gridX.at(index) = x;
             gridY.at(index) = y;
-            gridZ.at(index) = streamLine.z;
-            gridU.at(index) = streamLine.x;
-            gridW.at(index) = streamLine.y;
+            gridZ.at(index) = field.cp.at(index);
+            gridU.at(index) = field.vx.at(index);
+            gridW.at(index) = field.vy.at(index);
         }
     }
 
@@ -0,0 +1,29 @@
+#include "airfoil.h"
+
+#include <benchmark/benchmark.h>
+
+using aerodynamics::Airfoil;
+
+namespace
+{
+    void Airfoil_getNACA4Airfoil(benchmark::State &state)
+    {
+        int pointCount = state.range(0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Airfoil::getNACA4Airfoil(pointCount, 2, 40, 12, false, 0));
+        state.SetComplexityN(pointCount);
+        state.SetItemsProcessed(state.iterations() * pointCount);
+    }
+    BENCHMARK(Airfoil_getNACA4Airfoil)->RangeMultiplier(4)->Range(64, 16384)->Complexity(benchmark::oN);
+
+    void Airfoil_getCoefficientOfLift(benchmark::State &state)
+    {
+        int pointCount = state.range(0);
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(pointCount, 2, 40, 12, false, 0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(airfoil.getCoefficientOfLift());
+        state.SetComplexityN(pointCount);
+        state.SetItemsProcessed(state.iterations() * pointCount);
+    }
+    BENCHMARK(Airfoil_getCoefficientOfLift)->RangeMultiplier(4)->Range(64, 16384)->Complexity(benchmark::oN);
+} // namespace
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "panel_methods.h"
+
+#include <benchmark/benchmark.h>
+
+#include "airfoil.h"
+#include "panel_geometry.h"
+#include "point.h"
+#include "solver_options.h"
+#include "solver_workspace.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelGeometry;
+using aerodynamics::PanelMethods;
+using aerodynamics::SolverMethod;
+using aerodynamics::SolverOptions;
+using aerodynamics::SolverWorkspace;
+using geometry::Point;
+
+namespace
+{
+    void PanelMethods_computeInfluenceMatrices(benchmark::State &state)
+    {
+        int panelCount = state.range(0);
+        PanelGeometry geometry(Airfoil::getNACA4Airfoil(panelCount, 2, 40, 12, false, 0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(PanelMethods::computeInfluenceMatrices(geometry));
+        state.SetComplexityN(panelCount);
+        state.SetItemsProcessed(state.iterations() * panelCount * panelCount);
+    }
+    BENCHMARK(PanelMethods_computeInfluenceMatrices)->RangeMultiplier(2)->Range(64, 2048)->Complexity(benchmark::oNSquared)->Unit(benchmark::kMillisecond);
+
+    void PanelMethods_computeSourceVortexMatrix(benchmark::State &state)
+    {
+        int panelCount = state.range(0);
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(panelCount, 2, 40, 12, false, 0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(PanelMethods::computeSourceVortexMatrix(airfoil));
+        state.SetComplexityN(panelCount);
+        state.SetItemsProcessed(state.iterations() * panelCount * panelCount);
+    }
+    BENCHMARK(PanelMethods_computeSourceVortexMatrix)->RangeMultiplier(2)->Range(64, 2048)->Complexity(benchmark::oNSquared)->Unit(benchmark::kMillisecond);
+
+    /// @brief the full solve from geometry to pressure coefficients with one of the linear solvers
+    void PanelMethods_computeSourceVortex(benchmark::State &state, SolverMethod method)
+    {
+        int panelCount = state.range(0);
+        SolverOptions options;
+        options.method = method;
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(panelCount, 2, 40, 12, false, 0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(PanelMethods::computeSourceVortex(airfoil, 4.0, options));
+        state.SetComplexityN(panelCount);
+        state.SetItemsProcessed(state.iterations() * panelCount);
+    }
+    BENCHMARK_CAPTURE(PanelMethods_computeSourceVortex, lu, SolverMethod::LowerUpperDecomposition)->RangeMultiplier(2)->Range(64, 2048)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+    BENCHMARK_CAPTURE(PanelMethods_computeSourceVortex, gmres, SolverMethod::GMRES)->RangeMultiplier(2)->Range(256, 4096)->Complexity(benchmark::oNSquared)->Unit(benchmark::kMillisecond);
+    BENCHMARK_CAPTURE(PanelMethods_computeSourceVortex, matrix_free, SolverMethod::MatrixFreeGMRES)->RangeMultiplier(2)->Range(256, 4096)->Complexity(benchmark::oNLogN)->Unit(benchmark::kMillisecond);
+    BENCHMARK_CAPTURE(PanelMethods_computeSourceVortex, hierarchical, SolverMethod::HierarchicalGMRES)->RangeMultiplier(2)->Range(256, 4096)->Complexity(benchmark::oNLogN)->Unit(benchmark::kMillisecond);
+
+    /// @brief the LU solve inside a workspace, as an optimizer repeats it for every candidate airfoil
+    void PanelMethods_computeSourceVortexWorkspace(benchmark::State &state)
+    {
+        int panelCount = state.range(0);
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(panelCount, 2, 40, 12, false, 0);
+        SolverWorkspace workspace(airfoil.size());
+        for (auto _ : state)
+            benchmark::DoNotOptimize(PanelMethods::computeSourceVortex(airfoil, 4.0, workspace).data());
+        state.SetComplexityN(panelCount);
+        state.SetItemsProcessed(state.iterations() * panelCount);
+    }
+    BENCHMARK(PanelMethods_computeSourceVortexWorkspace)->RangeMultiplier(2)->Range(64, 2048)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+
+    void PanelMethods_computePolar(benchmark::State &state)
+    {
+        int angleCount = state.range(0);
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        std::vector<double> angles(angleCount);
+        for (int k = 0; k < angleCount; ++k)
+            angles[k] = -10.0 + 20.0 * k / angleCount;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(PanelMethods::computePolar(airfoil, angles));
+        state.SetComplexityN(angleCount);
+        state.SetItemsProcessed(state.iterations() * angleCount);
+    }
+    BENCHMARK(PanelMethods_computePolar)->RangeMultiplier(4)->Range(1, 1024)->Complexity()->Unit(benchmark::kMillisecond);
+
+    /// @brief the velocity of a solved airfoil at every point of a side by side grid around it
+    void PanelMethods_computeStreamline(benchmark::State &state)
+    {
+        int side = state.range(0);
+        Airfoil solved = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(100, 2, 40, 12, false, 0), 4.0);
+        for (auto _ : state)
+            for (int i = 0; i < side; ++i)
+                for (int j = 0; j < side; j++)
+                    benchmark::DoNotOptimize(PanelMethods::computeStreamline(solved, Point{-0.5 + 2.0 * j / side, -0.5 + 1.0 * i / side, 0}));
+        state.SetComplexityN(side * side);
+        state.SetItemsProcessed(state.iterations() * side * side);
+    }
+    BENCHMARK(PanelMethods_computeStreamline)->RangeMultiplier(2)->Range(8, 128)->Complexity(benchmark::oN)->Unit(benchmark::kMillisecond);
+} // namespace
\ No newline at end of file
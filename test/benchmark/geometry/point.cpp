@@ -0,0 +1,28 @@
+#include "point.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "vector.h"
+
+using geometry::Point;
+using geometry::Vector;
+
+namespace
+{
+    void Point_rotate(benchmark::State &state)
+    {
+        int count = state.range(0);
+        std::vector<Point> points(count);
+        for (int k = 0; k < count; ++k)
+            points[k] = Point{k / static_cast<double>(count), 0.1, 0};
+        Vector axis(Point::zero(), Point{0, 0, 1});
+        for (auto _ : state)
+            for (const Point &point : points)
+                benchmark::DoNotOptimize(point.rotate(0.1, axis));
+        state.SetComplexityN(count);
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(Point_rotate)->RangeMultiplier(8)->Range(8, 32768)->Complexity(benchmark::oN);
+} // namespace
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "polygon.h"
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "point.h"
+#include "point_cloud.h"
+
+using geometry::Point;
+using geometry::PointCloud;
+using geometry::Polygon;
+
+namespace
+{
+    // Query points of each iteration, half of them inside the polygon
+    const int queryCount = 256;
+
+    void Polygon_pointIsInside(benchmark::State &state)
+    {
+        int vertexCount = state.range(0);
+        PointCloud vertices(vertexCount);
+        for (int k = 0; k < vertexCount; ++k)
+        {
+            double angle = 2.0 * M_PI * k / vertexCount;
+            double radius = 1.0 + 0.2 * std::sin(7.0 * angle);
+            vertices[k] = Point{radius * std::cos(angle), radius * std::sin(angle), 0};
+        }
+        Polygon polygon(vertices);
+        std::vector<Point> queries(queryCount);
+        for (int k = 0; k < queryCount; ++k)
+            queries[k] = Point{(k % 16) / 8.0 - 1.0, (k / 16) / 8.0 - 1.0, 0};
+        for (auto _ : state)
+            for (const Point &query : queries)
+                benchmark::DoNotOptimize(polygon.pointIsInside(query));
+        state.SetComplexityN(vertexCount);
+        state.SetItemsProcessed(state.iterations() * queryCount);
+    }
+    BENCHMARK(Polygon_pointIsInside)->RangeMultiplier(4)->Range(16, 16384)->Complexity(benchmark::oN);
+} // namespace
\ No newline at end of file
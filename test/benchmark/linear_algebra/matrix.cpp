@@ -0,0 +1,63 @@
+#include "matrix.h"
+
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include "lu_factorization.h"
+
+using linear_algebra::LUFactorization;
+using linear_algebra::Matrix;
+
+namespace
+{
+    /// @brief a dense, diagonally dominant system like the panel influence matrix, so pivoting stays well conditioned
+    Matrix getSystem(int n)
+    {
+        Matrix a(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; j++)
+                a(i, j) = i == j ? n : std::sin(0.37 * i + 0.11 * j);
+        return a;
+    }
+
+    void Matrix_lowerUpperDecomposition(benchmark::State &state)
+    {
+        int n = state.range(0);
+        Matrix a = getSystem(n);
+        Matrix b(n, 1);
+        for (int i = 0; i < n; ++i)
+            b(i, 0) = 1.0;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Matrix::lowerUpperDecomposition(a, b));
+        state.SetComplexityN(n);
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(Matrix_lowerUpperDecomposition)->RangeMultiplier(2)->Range(32, 1024)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+
+    void LUFactorization_factorize(benchmark::State &state)
+    {
+        int n = state.range(0);
+        Matrix a = getSystem(n);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(LUFactorization(a));
+        state.SetComplexityN(n);
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(LUFactorization_factorize)->RangeMultiplier(2)->Range(32, 1024)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+
+    void LUFactorization_solve(benchmark::State &state)
+    {
+        int n = state.range(0);
+        LUFactorization factorization(getSystem(n));
+        std::vector<double> b(n, 1.0), x(n);
+        for (auto _ : state)
+        {
+            factorization.solve(b.data(), x.data());
+            benchmark::DoNotOptimize(x.data());
+        }
+        state.SetComplexityN(n);
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(LUFactorization_solve)->RangeMultiplier(2)->Range(32, 1024)->Complexity(benchmark::oNSquared);
+} // namespace
\ No newline at end of file
@@ -207,7 +207,7 @@ namespace
         ASSERT_THROW(Airfoil::getNACA4Airfoil(200, 2, 40, 0, false, 0), std::invalid_argument);
         ASSERT_THROW(Airfoil::getNACA4Airfoil(200, 2, 40, 41, false, 0), std::invalid_argument);
         ASSERT_THROW(Airfoil::getNACA4Airfoil(19, 2, 40, 12, false, 0), std::invalid_argument);
-        ASSERT_THROW(Airfoil::getNACA4Airfoil(201, 2, 40, 12, false, 0), std::invalid_argument);
+        ASSERT_THROW(Airfoil::getNACA4Airfoil(20002, 2, 40, 12, false, 0), std::invalid_argument);
         ASSERT_THROW(Airfoil::getNACA4Airfoil(101, 2, 40, 12, false, 0), std::invalid_argument);
     }
 } // namespace
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "geometric_integrals.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel.h"
+#include "panel_geometry.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::GeometricIntegrals;
+using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
+
+namespace
+{
+    double ulpDistance(double a, double b)
+    {
+        if (a == b)
+            return 0.0;
+        std::int64_t x, y;
+        std::memcpy(&x, &a, sizeof(x));
+        std::memcpy(&y, &b, sizeof(y));
+        if ((x < 0) != (y < 0))
+            return HUGE_VAL;
+        return std::fabs(static_cast<double>(x - y));
+    }
+
+    /// @brief the textbook integral with two arctangents
+    double integral(double a, double b, double c, double d, double s)
+    {
+        double e = std::sqrt(b - a * a);
+        return (c / 2.0) * std::log((s * s + 2.0 * a * s + b) / b) + ((d - a * c) / e) * (std::atan((s + a) / e) - std::atan(a / e));
+    }
+
+    /// @brief selects the kernels of a lane count until the end of the scope
+    class LaneCountScope
+    {
+    private:
+        int mPrevious;
+
+    public:
+        LaneCountScope(int laneCount) : mPrevious(GeometricIntegrals::laneCount()) { GeometricIntegrals::setLaneCount(laneCount); }
+        ~LaneCountScope() { GeometricIntegrals::setLaneCount(mPrevious); }
+    };
+
+    TEST(GeometricIntegrals, log)
+    {
+        std::mt19937_64 generator(7);
+        std::uniform_real_distribution<double> exponent(-700.0, 700.0);
+        std::vector<double> x(10001), result(x.size());
+        for (double &value : x)
+            value = std::exp(exponent(generator));
+        x[0] = 0.0;
+        x[1] = -1.0;
+        x[2] = HUGE_VAL;
+        x[3] = 1e-310;
+        for (int laneCount : GeometricIntegrals::getSupportedLaneCounts())
+        {
+            SCOPED_TRACE(laneCount);
+            LaneCountScope scope(laneCount);
+            GeometricIntegrals::log(x.data(), result.data(), x.size());
+            ASSERT_EQ(result[0], -HUGE_VAL);
+            ASSERT_TRUE(std::isnan(result[1]));
+            ASSERT_EQ(result[2], HUGE_VAL);
+            for (int i = 3; i < x.size(); ++i)
+                ASSERT_LE(ulpDistance(result[i], std::log(x[i])), 1.0) << x[i];
+        }
+    }
+
+    TEST(GeometricIntegrals, atan2)
+    {
+        std::mt19937_64 generator(11);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::vector<double> y(10003), x(y.size()), result(y.size());
+        for (int i = 0; i < y.size(); ++i)
+        {
+            y[i] = uniform(generator) * std::exp(20.0 * uniform(generator));
+            x[i] = uniform(generator) * std::exp(20.0 * uniform(generator));
+        }
+        y[0] = 0.0;
+        x[0] = -1.0;
+        y[1] = 1.0;
+        x[1] = 0.0;
+        y[2] = 0.0;
+        x[2] = 0.0;
+        for (int laneCount : GeometricIntegrals::getSupportedLaneCounts())
+        {
+            SCOPED_TRACE(laneCount);
+            LaneCountScope scope(laneCount);
+            GeometricIntegrals::atan2(y.data(), x.data(), result.data(), y.size());
+            for (int i = 0; i < y.size(); ++i)
+                ASSERT_LE(ulpDistance(result[i], std::atan2(y[i], x[i])), 2.0) << y[i] << " " << x[i];
+        }
+    }
+
+    TEST(GeometricIntegrals, computePanelIntegrals)
+    {
+        PanelGeometry geometry(Airfoil::getNACA4Airfoil(42, 2, 40, 12, false, 0));
+        int count = geometry.size();
+        std::vector<double> normal(count), tangential(count);
+        for (int laneCount : GeometricIntegrals::getSupportedLaneCounts())
+        {
+            SCOPED_TRACE(laneCount);
+            LaneCountScope scope(laneCount);
+            for (int i = 0; i < count; ++i)
+            {
+                // an odd offset exercises both the SIMD batches and the scalar remainder
+                GeometricIntegrals::computePanelIntegrals(geometry, i, 3, count, normal.data(), tangential.data());
+                double sinI = geometry.getSinPhi()[i];
+                double cosI = geometry.getCosPhi()[i];
+                for (int j = 3; j < count; j++)
+                {
+                    if (i == j)
+                    {
+                        ASSERT_EQ(normal[j - 3], 0.0);
+                        ASSERT_EQ(tangential[j - 3], 0.0);
+                        continue;
+                    }
+                    double sinJ = geometry.getSinPhi()[j];
+                    double cosJ = geometry.getCosPhi()[j];
+                    double dx = geometry.getMidX()[i] - geometry.getStartX()[j];
+                    double dy = geometry.getMidY()[i] - geometry.getStartY()[j];
+                    double a = -dx * cosJ - dy * sinJ;
+                    double b = dx * dx + dy * dy;
+                    double s = geometry.getLength()[j];
+                    ASSERT_NEAR(normal[j - 3], integral(a, b, sinI * cosJ - cosI * sinJ, -dx * sinI + dy * cosI, s), 1e-12);
+                    ASSERT_NEAR(tangential[j - 3], integral(a, b, -(cosI * cosJ + sinI * sinJ), dx * cosI + dy * sinI, s), 1e-12);
+                }
+            }
+        }
+    }
+
+    TEST(GeometricIntegrals, computePanelIntegralsSingleOutput)
+    {
+        PanelGeometry geometry(Airfoil::getNACA4Airfoil(42, 2, 40, 12, false, 0));
+        int count = geometry.size();
+        std::vector<double> normal(count), tangential(count), single(count);
+        for (int laneCount : GeometricIntegrals::getSupportedLaneCounts())
+        {
+            SCOPED_TRACE(laneCount);
+            LaneCountScope scope(laneCount);
+            for (int i = 0; i < count; ++i)
+            {
+                GeometricIntegrals::computePanelIntegrals(geometry, i, 1, count, normal.data(), tangential.data());
+                GeometricIntegrals::computePanelIntegrals(geometry, i, 1, count, single.data(), nullptr);
+                ASSERT_EQ(std::vector<double>(single.begin(), single.end() - 1), std::vector<double>(normal.begin(), normal.end() - 1));
+                GeometricIntegrals::computePanelIntegrals(geometry, i, 1, count, nullptr, single.data());
+                ASSERT_EQ(std::vector<double>(single.begin(), single.end() - 1), std::vector<double>(tangential.begin(), tangential.end() - 1));
+            }
+        }
+    }
+
+    TEST(GeometricIntegrals, computePointIntegrals)
+    {
+        PanelGeometry geometry(Airfoil::getNACA4Airfoil(42, 2, 40, 12, false, 0));
+        int count = geometry.size();
+        std::vector<double> mx(count), my(count);
+        double x = 0.3, y = 0.4;
+        for (int laneCount : GeometricIntegrals::getSupportedLaneCounts())
+        {
+            SCOPED_TRACE(laneCount);
+            LaneCountScope scope(laneCount);
+            GeometricIntegrals::computePointIntegrals(geometry, x, y, 0, count, mx.data(), my.data());
+            for (int j = 0; j < count; j++)
+            {
+                double sinJ = geometry.getSinPhi()[j];
+                double cosJ = geometry.getCosPhi()[j];
+                double dx = x - geometry.getMidX()[j];
+                double dy = y - geometry.getMidY()[j];
+                double a = -dx * cosJ - dy * sinJ;
+                double b = dx * dx + dy * dy;
+                double s = geometry.getLength()[j];
+                ASSERT_NEAR(mx[j], integral(a, b, -cosJ, dx, s), 1e-12);
+                ASSERT_NEAR(my[j], integral(a, b, -sinJ, dy, s), 1e-12);
+            }
+        }
+    }
+
+    TEST(GeometricIntegrals, computePointIntegralsPanel)
+    {
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(42, 2, 40, 12, false, 0);
+        PanelGeometry geometry(airfoil);
+        int count = geometry.size();
+        std::vector<double> mx(count), my(count);
+        double x = 0.3, y = 0.4;
+        GeometricIntegrals::computePointIntegrals(geometry, x, y, 0, count, mx.data(), my.data());
+        for (int j = 0; j < count; j++)
+        {
+            double panelMx, panelMy;
+            GeometricIntegrals::computePointIntegrals(airfoil[j], x, y, panelMx, panelMy);
+            ASSERT_NEAR(panelMx, mx[j], 1e-12);
+            ASSERT_NEAR(panelMy, my[j], 1e-12);
+        }
+    }
+
+    TEST(GeometricIntegrals, setLaneCount)
+    {
+        std::vector<int> laneCounts = GeometricIntegrals::getSupportedLaneCounts();
+        ASSERT_EQ(laneCounts.front(), 1);
+        ASSERT_EQ(GeometricIntegrals::laneCount(), laneCounts.back());
+        {
+            LaneCountScope scope(1);
+            ASSERT_EQ(GeometricIntegrals::laneCount(), 1);
+        }
+        ASSERT_EQ(GeometricIntegrals::laneCount(), laneCounts.back());
+        ASSERT_THROW(GeometricIntegrals::setLaneCount(3), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "naca_sweep.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel_methods.h"
+#include "polar.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::NACASweep;
+using aerodynamics::PanelMethods;
+using aerodynamics::Polar;
+using aerodynamics::SweepCase;
+using aerodynamics::SweepSettings;
+
+namespace
+{
+    TEST(NACASweep, getCase)
+    {
+        SweepSettings settings;
+        settings.maxCamberPercent = {0.0, 4.0, 3};
+        settings.maxCamberPositionPercent = {20.0, 40.0, 2};
+        settings.thicknessPercent = {10.0, 12.0, 2};
+        settings.pointCounts = {40, 60};
+        ASSERT_EQ(NACASweep::countCases(settings), 24);
+        SweepCase first = NACASweep::getCase(settings, 0);
+        ASSERT_EQ(first.maxCamberPercent, 0.0);
+        ASSERT_EQ(first.maxCamberPositionPercent, 20.0);
+        ASSERT_EQ(first.thicknessPercent, 10.0);
+        ASSERT_EQ(first.pointCount, 40);
+        SweepCase last = NACASweep::getCase(settings, 23);
+        ASSERT_EQ(last.maxCamberPercent, 4.0);
+        ASSERT_EQ(last.maxCamberPositionPercent, 40.0);
+        ASSERT_EQ(last.thicknessPercent, 12.0);
+        ASSERT_EQ(last.pointCount, 60);
+        SweepCase middle = NACASweep::getCase(settings, 13);
+        ASSERT_EQ(middle.maxCamberPercent, 2.0);
+        ASSERT_EQ(middle.maxCamberPositionPercent, 40.0);
+        ASSERT_EQ(middle.thicknessPercent, 10.0);
+        ASSERT_EQ(middle.pointCount, 60);
+    }
+
+    TEST(NACASweep, run)
+    {
+        SweepSettings settings;
+        settings.maxCamberPercent = {0.0, 4.0, 3};
+        settings.maxCamberPositionPercent = {40.0, 40.0, 1};
+        settings.thicknessPercent = {10.0, 14.0, 3};
+        settings.pointCounts = {40, 80};
+        settings.angles = {0.0, 4.0};
+        std::vector<int> visits(NACASweep::countCases(settings), 0);
+        std::vector<Polar> polars(visits.size());
+        NACASweep::run(settings, [&visits, &polars](const SweepCase &sweepCase)
+                       {
+            visits[sweepCase.index]++;
+            polars[sweepCase.index] = sweepCase.polar; });
+        for (int visit : visits)
+            ASSERT_EQ(visit, 1);
+
+        SweepCase sweepCase = NACASweep::getCase(settings, 7);
+        Polar expected = PanelMethods::computePolar(Airfoil::getNACA4Airfoil(sweepCase.pointCount, sweepCase.maxCamberPercent, sweepCase.maxCamberPositionPercent, sweepCase.thicknessPercent, false, 0.0), settings.angles);
+        ASSERT_EQ(polars[7].angles, settings.angles);
+        ASSERT_EQ(polars[7].lift, expected.lift);
+        ASSERT_EQ(polars[7].drag, expected.drag);
+    }
+
+    TEST(NACASweep, runInvalidArguments)
+    {
+        SweepSettings settings;
+        settings.thicknessPercent = {10.0, 50.0, 2};
+        ASSERT_THROW(NACASweep::run(settings, [](const SweepCase &) {}), std::invalid_argument);
+        settings.thicknessPercent.count = 0;
+        ASSERT_THROW(NACASweep::countCases(settings), std::invalid_argument);
+        settings.thicknessPercent.count = 1;
+        settings.pointCounts.clear();
+        ASSERT_THROW(NACASweep::countCases(settings), std::invalid_argument);
+        settings.pointCounts = {40};
+        ASSERT_THROW(NACASweep::getCase(settings, 1), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "panel_geometry.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel.h"
+#include "point.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
+using geometry::Point;
+
+namespace
+{
+    TEST(PanelGeometry, PanelGeometry)
+    {
+        Point p1{1.25, 3.75, 0};
+        Point p2{3.25, 2.5, 0};
+        Panel l{p1, p2};
+        l.alphaAngle = M_PI_4;
+        PanelGeometry g(std::vector<Panel>{l});
+        ASSERT_EQ(g.size(), 1);
+        ASSERT_FLOAT_EQ(g.getStartX()[0], 1.25);
+        ASSERT_FLOAT_EQ(g.getStartY()[0], 3.75);
+        ASSERT_FLOAT_EQ(g.getMidX()[0], 2.25);
+        ASSERT_FLOAT_EQ(g.getMidY()[0], 3.125);
+        ASSERT_FLOAT_EQ(g.getLength()[0], l.getLength());
+        ASSERT_FLOAT_EQ(g.getPhi()[0], 5.724585991836024);
+        ASSERT_FLOAT_EQ(g.getSinPhi()[0], std::sin(5.724585991836024));
+        ASSERT_FLOAT_EQ(g.getCosPhi()[0], std::cos(5.724585991836024));
+        ASSERT_FLOAT_EQ(g.getBeta()[0], 0.22679884805388628);
+    }
+
+    TEST(PanelGeometry, PanelGeometryAirfoil)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(40, 2, 40, 12, false, 0.1);
+        PanelGeometry g(a);
+        ASSERT_EQ(g.size(), a.size());
+        for (int i = 0; i < a.size(); ++i)
+        {
+            ASSERT_FLOAT_EQ(g.getMidX()[i], a[i].getMid().x);
+            ASSERT_FLOAT_EQ(g.getMidY()[i], a[i].getMid().y);
+            ASSERT_FLOAT_EQ(g.getPhi()[i], a[i].getPhiAngle());
+            ASSERT_FLOAT_EQ(g.getBeta()[i], a[i].getBetaAngle());
+        }
+    }
+
+    TEST(PanelGeometry, assign)
+    {
+        Airfoil large = Airfoil::getNACA4Airfoil(40, 2, 40, 12, false, 0.1);
+        Airfoil small = Airfoil::getNACA4Airfoil(20, 0, 0, 15, true, -0.2);
+        PanelGeometry g(large);
+        const double *data = g.getBeta().data();
+        g.assign(small);
+        PanelGeometry expected(small);
+        ASSERT_EQ(g.size(), small.size());
+        ASSERT_EQ(g.getBeta().data(), data);
+        for (int i = 0; i < small.size(); ++i)
+        {
+            ASSERT_EQ(g.getStartX()[i], expected.getStartX()[i]);
+            ASSERT_EQ(g.getMidY()[i], expected.getMidY()[i]);
+            ASSERT_EQ(g.getLength()[i], expected.getLength()[i]);
+            ASSERT_EQ(g.getSinPhi()[i], expected.getSinPhi()[i]);
+            ASSERT_EQ(g.getBeta()[i], expected.getBeta()[i]);
+        }
+    }
+} // namespace
\ No newline at end of file
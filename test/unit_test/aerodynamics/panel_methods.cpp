@@ -2,14 +2,42 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <vector>
+
 #include "airfoil.h"
+#include "gmres.h"
+#include "influence_matrices.h"
+#include "lu_factorization.h"
+#include "matrix.h"
+#include "panel.h"
+#include "panel_geometry.h"
 #include "point.h"
+#include "solver_options.h"
+#include "solver_workspace.h"
+#include "thread_pool.h"
+#include "velocity_field.h"
 #include "vector.h"
 
 using aerodynamics::Airfoil;
+using aerodynamics::FieldGrid;
+using aerodynamics::HierarchicalInfluenceMatrices;
+using aerodynamics::InfluenceMatrices;
+using aerodynamics::Panel;
+using aerodynamics::PanelGeometry;
 using aerodynamics::PanelMethods;
+using aerodynamics::Polar;
+using aerodynamics::SolverMethod;
+using aerodynamics::SolverOptions;
+using aerodynamics::SolverWorkspace;
+using aerodynamics::SourceVortexBasis;
+using aerodynamics::VelocityField;
+using concurrency::ThreadPool;
 using geometry::Point;
 using geometry::Vector;
+using linear_algebra::LUFactorization;
+using linear_algebra::Matrix;
+using linear_algebra::SolverReport;
 
 namespace
 {
@@ -22,6 +50,271 @@ namespace
         ASSERT_FLOAT_EQ(b.getCoefficientOfMoment(), -0.05526644272468364);
     }
 
+    TEST(PanelMethods, computeInfluenceMatrices)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(60, 2, 40, 12, false, 0);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(PanelGeometry(a));
+        Matrix system = PanelMethods::computeSourceVortexMatrix(a);
+        ASSERT_EQ(matrices.system.rowCount(), 61);
+        ASSERT_EQ(matrices.tangential.rowCount(), 60);
+        for (int i = 0; i < system.rowCount(); ++i)
+            for (int j = 0; j < system.columnCount(); j++)
+                ASSERT_DOUBLE_EQ(matrices.system(i, j), system(i, j));
+        for (int i = 0; i < 60; ++i)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < 60; j++)
+                sum += matrices.tangential(i, j);
+            ASSERT_DOUBLE_EQ(matrices.tangential(i, i), 0.0);
+            ASSERT_NEAR(matrices.system(i, 60), -sum, 1e-12);
+        }
+    }
+
+    TEST(PanelMethods, computeInfluenceMatricesThreadCount)
+    {
+        PanelGeometry geometry(Airfoil::getNACA4Airfoil(100, 2, 40, 12, false, 0));
+        ThreadPool::setSharedThreadCount(1);
+        InfluenceMatrices serial = PanelMethods::computeInfluenceMatrices(geometry);
+        ThreadPool::setSharedThreadCount(4);
+        InfluenceMatrices parallel = PanelMethods::computeInfluenceMatrices(geometry);
+        ThreadPool::setSharedThreadCount(ThreadPool::defaultThreadCount());
+        for (int i = 0; i < serial.system.rowCount(); ++i)
+            for (int j = 0; j < serial.system.columnCount(); j++)
+                ASSERT_EQ(serial.system(i, j), parallel.system(i, j));
+        ASSERT_EQ(serial.vortexTangential, parallel.vortexTangential);
+    }
+
+    TEST(PanelMethods, computeSurfaceVelocity)
+    {
+        Airfoil a = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0), 2);
+        PanelGeometry geometry(a);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(geometry);
+        Airfoil b{a};
+        std::vector<double> v = PanelMethods::computeSurfaceVelocity(b, geometry, matrices);
+        ASSERT_EQ(v.size(), a.size());
+        for (int i = 0; i < a.size(); ++i)
+        {
+            ASSERT_NEAR(b[i].coefficientOfPressure, a[i].coefficientOfPressure, 1e-12);
+            ASSERT_NEAR(b[i].coefficientOfPressure, 1 - v[i] * v[i], 1e-12);
+        }
+        // the Kutta condition makes the trailing edge velocities equal and opposite
+        ASSERT_NEAR(v.front() + v.back(), 0.0, 1e-9);
+        Airfoil c = Airfoil::getNACA4Airfoil(30, 2, 40, 12, false, 0);
+        ASSERT_THROW(PanelMethods::computeSurfaceVelocity(c, geometry, matrices), std::invalid_argument);
+    }
+
+    TEST(PanelMethods, computeSourceVortexFactorization)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(PanelGeometry(a));
+        LUFactorization lu(matrices.system);
+        Airfoil b = PanelMethods::computeSourceVortex(a, matrices, lu, 2);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfLift(), 0.49225303229453155);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfDrag(), 0.01698688438654304);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfMoment(), -0.05526644272468364);
+        Airfoil c = PanelMethods::computeSourceVortex(a, matrices, lu, 5);
+        Airfoil d = PanelMethods::computeSourceVortex(a, 5);
+        ASSERT_FLOAT_EQ(c.getCoefficientOfLift(), d.getCoefficientOfLift());
+        ASSERT_FLOAT_EQ(c.getCoefficientOfDrag(), d.getCoefficientOfDrag());
+        ASSERT_FLOAT_EQ(c.getCoefficientOfMoment(), d.getCoefficientOfMoment());
+    }
+
+    TEST(PanelMethods, computeSourceVortexFactorizationInvalidArguments)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(20, 2, 40, 12, false, 0);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(PanelGeometry(a));
+        LUFactorization lu(linear_algebra::Matrix::identity(20));
+        ASSERT_THROW(PanelMethods::computeSourceVortex(a, matrices, lu, 2), std::invalid_argument);
+        InfluenceMatrices other = PanelMethods::computeInfluenceMatrices(PanelGeometry(Airfoil::getNACA4Airfoil(30, 2, 40, 12, false, 0)));
+        ASSERT_THROW(PanelMethods::computeSourceVortex(a, other, LUFactorization(matrices.system), 2), std::invalid_argument);
+    }
+
+    TEST(PanelMethods, computeSourceVortexWorkspace)
+    {
+        Airfoil large = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        Airfoil small = Airfoil::getNACA4Airfoil(120, 0, 0, 15, true, 0);
+        SolverWorkspace workspace(large.size());
+        const double *system = workspace.matrices.system.data();
+        const double *lu = workspace.factorization.getLU().data();
+        const double *strengths = workspace.strengths.data();
+        const Panel *panels = workspace.solved.data();
+        for (double angle : {2.0, -3.0, 5.0})
+            for (const Airfoil *airfoil : {&large, &small})
+            {
+                const Airfoil &solved = PanelMethods::computeSourceVortex(*airfoil, angle, workspace);
+                Airfoil expected = PanelMethods::computeSourceVortex(*airfoil, angle);
+                ASSERT_EQ(&solved, &workspace.solved);
+                ASSERT_EQ(solved.size(), expected.size());
+                for (int i = 0; i < expected.size(); ++i)
+                {
+                    ASSERT_NEAR(solved[i].lambda, expected[i].lambda, 1e-10);
+                    ASSERT_NEAR(solved[i].gamma, expected[i].gamma, 1e-10);
+                    ASSERT_NEAR(solved[i].coefficientOfPressure, expected[i].coefficientOfPressure, 1e-10);
+                }
+                ASSERT_NEAR(solved.getCoefficientOfLift(), expected.getCoefficientOfLift(), 1e-10);
+            }
+        // every solve ran in the buffers allocated up front
+        ASSERT_EQ(workspace.matrices.system.data(), system);
+        ASSERT_EQ(workspace.factorization.getLU().data(), lu);
+        ASSERT_EQ(workspace.strengths.data(), strengths);
+        ASSERT_EQ(workspace.solved.data(), panels);
+        ASSERT_THROW(PanelMethods::computeSourceVortex(Airfoil(0), 2, workspace), std::invalid_argument);
+    }
+
+    TEST(PanelMethods, computeSourceVortexWorkspaceResolve)
+    {
+        // the returned airfoil solved again at another angle matches a solve of the original geometry
+        Airfoil a = Airfoil::getNACA4Airfoil(100, 2, 40, 12, false, 0);
+        SolverWorkspace workspace(a.size());
+        const Airfoil &solved = PanelMethods::computeSourceVortex(a, 2.0, workspace);
+        const Airfoil &resolved = PanelMethods::computeSourceVortex(solved, 6.0, workspace);
+        Airfoil expected = PanelMethods::computeSourceVortex(a, 6.0);
+        ASSERT_EQ(&resolved, &solved);
+        ASSERT_EQ(resolved.size(), expected.size());
+        for (int i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_NEAR(resolved[i].lambda, expected[i].lambda, 1e-10);
+            ASSERT_NEAR(resolved[i].gamma, expected[i].gamma, 1e-10);
+            ASSERT_NEAR(resolved[i].coefficientOfPressure, expected[i].coefficientOfPressure, 1e-10);
+        }
+    }
+
+    TEST(PanelMethods, computeSourceVortexBasis)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        SourceVortexBasis basis = PanelMethods::computeSourceVortexBasis(a);
+        for (double angle : {-8.0, 0.0, 2.0, 13.5})
+        {
+            Airfoil b = PanelMethods::computeSourceVortex(basis, angle);
+            Airfoil c = PanelMethods::computeSourceVortex(a, angle);
+            for (int i = 0; i < a.size(); ++i)
+            {
+                ASSERT_NEAR(b[i].lambda, c[i].lambda, 1e-12);
+                ASSERT_NEAR(b[i].gamma, c[i].gamma, 1e-12);
+                ASSERT_NEAR(b[i].coefficientOfPressure, c[i].coefficientOfPressure, 1e-10);
+            }
+            ASSERT_NEAR(b.getCoefficientOfLift(), c.getCoefficientOfLift(), 1e-10);
+            ASSERT_NEAR(b.getCoefficientOfDrag(), c.getCoefficientOfDrag(), 1e-10);
+            ASSERT_NEAR(b.getCoefficientOfMoment(), c.getCoefficientOfMoment(), 1e-10);
+
+            // central difference of the combined lift in radians
+            double step = 1e-4;
+            double difference = (PanelMethods::computeSourceVortex(basis, angle + step).getCoefficientOfLift() - PanelMethods::computeSourceVortex(basis, angle - step).getCoefficientOfLift()) / (2.0 * step * M_PI / 180.0);
+            ASSERT_NEAR(PanelMethods::computeLiftSlope(basis, angle), difference, 1e-6);
+        }
+    }
+
+    TEST(PanelMethods, computeSourceVortexBasisInvalidArguments)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(20, 2, 40, 12, false, 0);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(PanelGeometry(a));
+        InfluenceMatrices other = PanelMethods::computeInfluenceMatrices(PanelGeometry(Airfoil::getNACA4Airfoil(30, 2, 40, 12, false, 0)));
+        ASSERT_THROW(PanelMethods::computeSourceVortexBasis(a, other, LUFactorization(matrices.system)), std::invalid_argument);
+        ASSERT_THROW(PanelMethods::computeSourceVortexBasis(a, matrices, LUFactorization(other.system)), std::invalid_argument);
+    }
+
+    TEST(PanelMethods, computePolar)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        std::vector<double> angles;
+        for (int k = 0; k < 21; ++k)
+            angles.push_back(-10.0 + k);
+        Polar polar = PanelMethods::computePolar(a, angles, true);
+        ASSERT_EQ(polar.angles, angles);
+        ASSERT_EQ(polar.panelCount, 200);
+        ASSERT_EQ(polar.pressure.size(), 21 * 200);
+        for (int k = 0; k < 21; k += 5)
+        {
+            Airfoil b = PanelMethods::computeSourceVortex(a, angles[k]);
+            ASSERT_NEAR(polar.lift[k], b.getCoefficientOfLift(), 1e-10);
+            ASSERT_NEAR(polar.drag[k], b.getCoefficientOfDrag(), 1e-10);
+            ASSERT_NEAR(polar.moment[k], b.getCoefficientOfMoment(), 1e-10);
+            for (int i = 0; i < 200; ++i)
+                ASSERT_NEAR(polar.pressure[k * 200 + i], b[i].coefficientOfPressure, 1e-10);
+        }
+
+        Polar coefficients = PanelMethods::computePolar(a, angles);
+        ASSERT_EQ(coefficients.panelCount, 0);
+        ASSERT_TRUE(coefficients.pressure.empty());
+        ASSERT_EQ(coefficients.lift, polar.lift);
+    }
+
+    TEST(PanelMethods, computeCoefficients)
+    {
+        SourceVortexBasis basis = PanelMethods::computeSourceVortexBasis(Airfoil::getNACA4Airfoil(120, 4, 40, 15, true, 0));
+        std::vector<double> pressures(120);
+        for (double angle : {-6.0, 0.0, 3.5, 12.0})
+        {
+            double lift, drag, moment;
+            PanelMethods::computeCoefficients(basis, angle, lift, drag, moment, pressures.data());
+            Airfoil b = PanelMethods::computeSourceVortex(basis, angle);
+            ASSERT_DOUBLE_EQ(lift, b.getCoefficientOfLift());
+            ASSERT_DOUBLE_EQ(drag, b.getCoefficientOfDrag());
+            ASSERT_DOUBLE_EQ(moment, b.getCoefficientOfMoment());
+            for (int i = 0; i < 120; ++i)
+                ASSERT_EQ(pressures[i], b[i].coefficientOfPressure);
+        }
+    }
+
+    TEST(PanelMethods, computeSourceVortexGMRES)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        SolverOptions options;
+        options.method = SolverMethod::GMRES;
+        options.tolerance = 1e-12;
+        SolverReport report;
+        Airfoil b = PanelMethods::computeSourceVortex(a, 2, options, &report);
+        ASSERT_TRUE(report.converged);
+        ASSERT_LE(report.residual, 1e-12);
+        ASSERT_GT(report.iterations, 0);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfLift(), 0.49225303229453155);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfDrag(), 0.01698688438654304);
+        ASSERT_FLOAT_EQ(b.getCoefficientOfMoment(), -0.05526644272468364);
+    }
+
+    TEST(PanelMethods, computeSourceVortexMatrixFree)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        SolverOptions options;
+        options.method = SolverMethod::MatrixFreeGMRES;
+        options.tolerance = 1e-12;
+        SolverReport report;
+        Airfoil b = PanelMethods::computeSourceVortex(a, 2, options, &report);
+        ASSERT_TRUE(report.converged);
+        ASSERT_NEAR(b.getCoefficientOfLift(), 0.49225303229453155, 1e-7);
+        ASSERT_NEAR(b.getCoefficientOfDrag(), 0.01698688438654304, 1e-7);
+        ASSERT_NEAR(b.getCoefficientOfMoment(), -0.05526644272468364, 1e-7);
+
+        // without a preconditioner the same system takes more iterations
+        options.preconditionerBlockSize = 0;
+        SolverReport unpreconditioned;
+        Airfoil c = PanelMethods::computeSourceVortex(a, 2, options, &unpreconditioned);
+        ASSERT_TRUE(unpreconditioned.converged);
+        ASSERT_GE(unpreconditioned.iterations, report.iterations);
+        ASSERT_NEAR(c.getCoefficientOfLift(), 0.49225303229453155, 1e-7);
+    }
+
+    TEST(PanelMethods, computeSourceVortexHierarchical)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
+        SolverOptions options;
+        options.method = SolverMethod::HierarchicalGMRES;
+        options.tolerance = 1e-12;
+        SolverReport report;
+        Airfoil b = PanelMethods::computeSourceVortex(a, 2, options, &report);
+        ASSERT_TRUE(report.converged);
+        ASSERT_NEAR(b.getCoefficientOfLift(), 0.49225303229453155, 1e-7);
+        ASSERT_NEAR(b.getCoefficientOfDrag(), 0.01698688438654304, 1e-7);
+        ASSERT_NEAR(b.getCoefficientOfMoment(), -0.05526644272468364, 1e-7);
+
+        // the compressed matrices are reused across angles
+        HierarchicalInfluenceMatrices matrices = PanelMethods::computeHierarchicalInfluenceMatrices(PanelGeometry(a));
+        Airfoil c = PanelMethods::computeSourceVortex(a, matrices, 5, options);
+        Airfoil d = PanelMethods::computeSourceVortex(a, 5);
+        ASSERT_NEAR(c.getCoefficientOfLift(), d.getCoefficientOfLift(), 1e-7);
+        ASSERT_THROW(PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(30, 2, 40, 12, false, 0), matrices, 5, options), std::invalid_argument);
+    }
+
     TEST(PanelMethods, computeStreamline)
     {
         Airfoil a = Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0);
@@ -31,4 +324,66 @@ namespace
         ASSERT_FLOAT_EQ(v.y, 0.0094638597);
         ASSERT_FLOAT_EQ(v.z, -0.06855532416961796);
     }
+
+    TEST(PanelMethods, computeVelocityField)
+    {
+        Airfoil a = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(200, 2, 40, 12, false, 0), 2);
+        FieldGrid grid;
+        grid.originX = -0.5;
+        grid.originY = -0.5;
+        grid.spacingX = 0.1;
+        grid.spacingY = 0.125;
+        grid.columns = 21;
+        grid.rows = 9;
+        VelocityField field = PanelMethods::computeVelocityField(a, grid);
+        ASSERT_EQ(field.vx.size(), 189);
+        std::vector<double> x(field.vx.size()), y(field.vx.size()), vx(x.size()), vy(x.size()), cp(x.size());
+        for (int row = 0; row < grid.rows; ++row)
+            for (int column = 0; column < grid.columns; column++)
+            {
+                int index = row * grid.columns + column;
+                x[index] = grid.originX + column * grid.spacingX;
+                y[index] = grid.originY + row * grid.spacingY;
+                Vector v = PanelMethods::computeStreamline(a, Point{x[index], y[index], 0});
+                ASSERT_NEAR(field.vx[index], v.x, 1e-12);
+                ASSERT_NEAR(field.vy[index], v.y, 1e-12);
+                ASSERT_NEAR(field.cp[index], v.z, 1e-12);
+            }
+        PanelMethods::computeVelocityField(a, x.data(), y.data(), x.size(), vx.data(), vy.data(), cp.data());
+        ASSERT_EQ(vx, field.vx);
+        ASSERT_EQ(vy, field.vy);
+        ASSERT_EQ(cp, field.cp);
+
+        Vector v = PanelMethods::computeStreamline(a, Point{1, 1, 1});
+        double far[] = {1.0};
+        PanelMethods::computeVelocityField(a, far, far, 1, vx.data(), vy.data(), cp.data());
+        ASSERT_NEAR(vx[0], v.x, 1e-12);
+        ASSERT_NEAR(cp[0], v.z, 1e-12);
+        grid.rows = -1;
+        ASSERT_THROW(PanelMethods::computeVelocityField(a, grid), std::invalid_argument);
+        ASSERT_THROW(PanelMethods::computeVelocityField(std::vector<aerodynamics::Panel>(), x.data(), y.data(), 1, vx.data(), vy.data(), cp.data()), std::invalid_argument);
+        ASSERT_THROW(PanelMethods::computeStreamline(std::vector<aerodynamics::Panel>(), Point{1, 1, 1}), std::invalid_argument);
+    }
+
+    TEST(PanelMethods, computeVelocityFieldBasis)
+    {
+        // more panels than one block of integrals
+        Airfoil a = Airfoil::getNACA4Airfoil(300, 2, 40, 12, false, 0);
+        SourceVortexBasis basis = PanelMethods::computeSourceVortexBasis(a);
+        PanelGeometry geometry(a);
+        std::vector<double> x = {-0.5, 0.25, 0.5, 1.5, 3.0}, y = {0.0, 0.1, -0.3, 0.2, -2.0};
+        std::vector<double> vx(x.size()), vy(x.size()), cp(x.size()), expectedVx(x.size()), expectedVy(x.size()), expectedCp(x.size());
+        for (double angle : {-6.0, 0.0, 4.5})
+        {
+            PanelMethods::computeVelocityField(basis, geometry, angle, x.data(), y.data(), x.size(), vx.data(), vy.data(), cp.data());
+            PanelMethods::computeVelocityField(PanelMethods::computeSourceVortex(basis, angle), x.data(), y.data(), x.size(), expectedVx.data(), expectedVy.data(), expectedCp.data());
+            for (std::size_t k = 0; k < x.size(); ++k)
+            {
+                ASSERT_NEAR(vx[k], expectedVx[k], 1e-12);
+                ASSERT_NEAR(vy[k], expectedVy[k], 1e-12);
+                ASSERT_NEAR(cp[k], expectedCp[k], 1e-12);
+            }
+        }
+        ASSERT_THROW(PanelMethods::computeVelocityField(basis, PanelGeometry(Airfoil::getNACA4Airfoil(20, 2, 40, 12, false, 0)), 2.0, x.data(), y.data(), 1, vx.data(), vy.data(), cp.data()), std::invalid_argument);
+    }
 } // namespace
\ No newline at end of file
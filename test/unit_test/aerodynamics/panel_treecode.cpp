@@ -0,0 +1,72 @@
+#include "panel_treecode.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel_methods.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using aerodynamics::PanelTreecode;
+using aerodynamics::TreecodeOptions;
+
+namespace
+{
+    TEST(PanelTreecode, computeVelocityField)
+    {
+        Airfoil a = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(1000, 2, 40, 12, false, 0), 4);
+        std::mt19937_64 generator(3);
+        std::uniform_real_distribution<double> uniform(-1.0, 2.0);
+        int count = 500;
+        std::vector<double> x(count), y(count);
+        for (int k = 0; k < count; ++k)
+        {
+            x[k] = uniform(generator);
+            y[k] = uniform(generator) - 0.5;
+        }
+        // points on the chord line and just off the surface exercise the direct near field
+        x[0] = 0.5;
+        y[0] = 0.0;
+        x[1] = a[250].getMid().x;
+        y[1] = a[250].getMid().y + 1e-3;
+        std::vector<double> vx(count), vy(count), cp(count), treeVx(count), treeVy(count), treeCp(count);
+        PanelMethods::computeVelocityField(a, x.data(), y.data(), count, vx.data(), vy.data(), cp.data());
+
+        TreecodeOptions options;
+        PanelTreecode tree(a, options);
+        ASSERT_GT(tree.nodeCount(), 1);
+        tree.computeVelocityField(x.data(), y.data(), count, treeVx.data(), treeVy.data(), treeCp.data());
+        for (int k = 0; k < count; ++k)
+        {
+            ASSERT_NEAR(treeVx[k], vx[k], 1e-6);
+            ASSERT_NEAR(treeVy[k], vy[k], 1e-6);
+            ASSERT_NEAR(treeCp[k], cp[k], 1e-6);
+        }
+
+        // a lower order trades accuracy for speed
+        options.order = 4;
+        PanelMethods::computeVelocityField(a, x.data(), y.data(), count, treeVx.data(), treeVy.data(), treeCp.data(), options);
+        for (int k = 0; k < count; ++k)
+            ASSERT_NEAR(treeVx[k], vx[k], 1e-2);
+    }
+
+    TEST(PanelTreecode, PanelTreecodeInvalidArguments)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(20, 2, 40, 12, false, 0);
+        TreecodeOptions options;
+        options.theta = 1.0;
+        ASSERT_THROW(PanelTreecode(a, options), std::invalid_argument);
+        options.theta = 0.5;
+        options.order = -1;
+        ASSERT_THROW(PanelTreecode(a, options), std::invalid_argument);
+        options.order = 4;
+        options.leafSize = 0;
+        ASSERT_THROW(PanelTreecode(a, options), std::invalid_argument);
+        ASSERT_THROW(PanelTreecode(std::vector<aerodynamics::Panel>()), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
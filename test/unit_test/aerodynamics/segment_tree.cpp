@@ -0,0 +1,108 @@
+#include "segment_tree.h"
+
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using aerodynamics::SegmentTree;
+using aerodynamics::TreecodeOptions;
+
+namespace
+{
+    TEST(SegmentTree, findInteractions)
+    {
+        std::mt19937_64 generator(5);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        int count = 300;
+        std::vector<std::complex<double>> starts(count), ends(count);
+        for (int j = 0; j < count; ++j)
+        {
+            starts[j] = std::complex<double>(uniform(generator), uniform(generator));
+            ends[j] = starts[j] + 0.01 * std::complex<double>(uniform(generator), uniform(generator));
+        }
+        TreecodeOptions options;
+        options.leafSize = 8;
+        SegmentTree tree(starts, ends, options);
+        ASSERT_GT(tree.nodeCount(), 1);
+
+        // every segment is covered once by the far clusters and near leaves of a point
+        std::vector<int> far, near, stack, covered(count);
+        std::complex<double> z(0.25, 0.75);
+        tree.findInteractions(z, far, near, stack);
+        ASSERT_FALSE(far.empty());
+        for (int index : far)
+            for (int j = tree.getNodes()[index].begin; j < tree.getNodes()[index].end; j++)
+                covered[tree.getOrder()[j]]++;
+        for (int index : near)
+        {
+            ASSERT_EQ(tree.getNodes()[index].childCount, 0);
+            for (int j = tree.getNodes()[index].begin; j < tree.getNodes()[index].end; j++)
+                covered[tree.getOrder()[j]]++;
+        }
+        for (int j = 0; j < count; ++j)
+            ASSERT_EQ(covered[j], 1);
+    }
+
+    TEST(SegmentTree, evaluateExpansion)
+    {
+        std::vector<std::complex<double>> starts = {{0.0, 0.0}, {0.1, 0.05}};
+        std::vector<std::complex<double>> ends = {{0.1, 0.05}, {0.2, 0.0}};
+        std::vector<std::complex<double>> strengths = {{1.0, 0.5}, {-0.25, 2.0}};
+        SegmentTree tree(starts, ends);
+        std::vector<std::complex<double>> moments(tree.nodeCount() * tree.termCount());
+        tree.computeMoments(strengths.data(), moments.data());
+
+        // the integral of ds / (z - z(s)) along a straight segment is conj(t) log((z - z0) / (z - z1))
+        std::complex<double> z(2.0, 1.5);
+        std::complex<double> exact = 0.0;
+        for (int j = 0; j < 2; ++j)
+        {
+            std::complex<double> t = (ends[j] - starts[j]) / std::abs(ends[j] - starts[j]);
+            exact += strengths[j] * std::conj(t) * std::log((z - starts[j]) / (z - ends[j]));
+        }
+        std::complex<double> series = tree.evaluateExpansion(0, moments.data(), z);
+        ASSERT_NEAR(series.real(), exact.real(), 1e-14);
+        ASSERT_NEAR(series.imag(), exact.imag(), 1e-14);
+    }
+
+    TEST(SegmentTree, sortItems)
+    {
+        int count = 40;
+        std::vector<std::complex<double>> starts(count), ends(count);
+        std::vector<int> items(count);
+        for (int j = 0; j < count; ++j)
+        {
+            // alternate ends of the line so the sorted order differs from the input order
+            double x = j % 2 == 0 ? j : count - j;
+            starts[j] = std::complex<double>(x, 0.0);
+            ends[j] = std::complex<double>(x + 0.5, 0.0);
+            items[j] = 10 * j;
+        }
+        TreecodeOptions options;
+        options.leafSize = 4;
+        SegmentTree tree(starts, ends, options);
+        std::vector<int> sorted = tree.sortItems(items);
+        ASSERT_EQ(sorted.size(), count);
+        for (int j = 0; j < count; ++j)
+            ASSERT_EQ(sorted[j], items[tree.getOrder()[j]]);
+    }
+
+    TEST(SegmentTree, SegmentTreeInvalidArguments)
+    {
+        std::vector<std::complex<double>> starts = {0.0}, ends = {1.0};
+        ASSERT_THROW(SegmentTree(std::vector<std::complex<double>>(), std::vector<std::complex<double>>()), std::invalid_argument);
+        ASSERT_THROW(SegmentTree(starts, std::vector<std::complex<double>>(2)), std::invalid_argument);
+        TreecodeOptions options;
+        options.theta = 0.0;
+        ASSERT_THROW(SegmentTree(starts, ends, options), std::invalid_argument);
+        options.theta = 0.5;
+        options.order = -1;
+        ASSERT_THROW(SegmentTree(starts, ends, options), std::invalid_argument);
+        options.order = 4;
+        options.leafSize = 0;
+        ASSERT_THROW(SegmentTree(starts, ends, options), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
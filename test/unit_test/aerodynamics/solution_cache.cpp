@@ -0,0 +1,176 @@
+#include "solution_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "gmres.h"
+#include "panel_methods.h"
+#include "solver_options.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::CachedSolution;
+using aerodynamics::PanelMethods;
+using aerodynamics::SolutionCache;
+using aerodynamics::SolverMethod;
+using aerodynamics::SolverOptions;
+using linear_algebra::SolverReport;
+
+namespace
+{
+    CachedSolution createSolution(int count, double value)
+    {
+        CachedSolution solution{std::vector<double>(count, value), std::vector<double>(count, -value), std::vector<double>(count, 2.0 * value), SolverReport()};
+        solution.report.iterations = 7;
+        solution.report.residual = 1e-11;
+        solution.report.converged = true;
+        return solution;
+    }
+
+    TEST(SolutionCache, hash)
+    {
+        ASSERT_EQ(SolutionCache::hash(""), 0xcbf29ce484222325ull);
+        ASSERT_EQ(SolutionCache::hash("a"), 0xaf63dc4c8601ec8cull);
+    }
+
+    TEST(SolutionCache, createKey)
+    {
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(40, 2.0, 40.0, 12.0, true, 0.0);
+        SolverOptions options;
+        std::string key = SolutionCache::createKey(airfoil, 4.0, options);
+        ASSERT_EQ(key, SolutionCache::createKey(airfoil, 4.0, options));
+        ASSERT_NE(key, SolutionCache::createKey(airfoil, 5.0, options));
+
+        // options the method does not read leave the key unchanged
+        SolverOptions tolerance = options;
+        tolerance.tolerance = 1e-6;
+        ASSERT_EQ(key, SolutionCache::createKey(airfoil, 4.0, tolerance));
+        options.method = SolverMethod::GMRES;
+        tolerance.method = SolverMethod::GMRES;
+        ASSERT_NE(SolutionCache::createKey(airfoil, 4.0, options), SolutionCache::createKey(airfoil, 4.0, tolerance));
+
+        Airfoil moved{airfoil};
+        moved[3] = aerodynamics::Panel(moved[3].getStart(), geometry::Point(0.5, 0.5, 0.0));
+        ASSERT_NE(SolutionCache::createKey(airfoil, 4.0, SolverOptions()), SolutionCache::createKey(moved, 4.0, SolverOptions()));
+    }
+
+    TEST(SolutionCache, find)
+    {
+        SolutionCache cache(1 << 20);
+        CachedSolution solution;
+        ASSERT_FALSE(cache.find("a", solution));
+        cache.insert("a", createSolution(10, 1.0));
+        ASSERT_TRUE(cache.find("a", solution));
+        ASSERT_EQ(solution.lambdas, std::vector<double>(10, 1.0));
+        ASSERT_EQ(solution.gammas, std::vector<double>(10, -1.0));
+        ASSERT_EQ(solution.pressures, std::vector<double>(10, 2.0));
+        ASSERT_EQ(solution.report.iterations, 7);
+        ASSERT_EQ(cache.hitCount(), 1);
+        ASSERT_EQ(cache.missCount(), 1);
+
+        // inserting an existing key replaces its solution
+        cache.insert("a", createSolution(10, 3.0));
+        ASSERT_EQ(cache.entryCount(), 1);
+        ASSERT_TRUE(cache.find("a", solution));
+        ASSERT_EQ(solution.lambdas, std::vector<double>(10, 3.0));
+    }
+
+    TEST(SolutionCache, insert)
+    {
+        // room for two solutions of 100 panels
+        SolutionCache cache(2 * (3 * 100 * sizeof(double) + 256));
+        cache.insert("a", createSolution(100, 1.0));
+        cache.insert("b", createSolution(100, 2.0));
+        ASSERT_EQ(cache.entryCount(), 2);
+
+        // looking up a makes b the least recently used
+        CachedSolution solution;
+        ASSERT_TRUE(cache.find("a", solution));
+        cache.insert("c", createSolution(100, 3.0));
+        ASSERT_EQ(cache.entryCount(), 2);
+        ASSERT_TRUE(cache.find("a", solution));
+        ASSERT_FALSE(cache.find("b", solution));
+        ASSERT_TRUE(cache.find("c", solution));
+        ASSERT_LE(cache.sizeBytes(), 2 * (3 * 100 * sizeof(double) + 256));
+
+        // a solution larger than the capacity is not kept
+        cache.insert("d", createSolution(1000, 4.0));
+        ASSERT_FALSE(cache.find("d", solution));
+        ASSERT_EQ(cache.entryCount(), 2);
+
+        cache.clear();
+        ASSERT_EQ(cache.entryCount(), 0);
+        ASSERT_EQ(cache.sizeBytes(), 0);
+    }
+
+    TEST(SolutionCache, directory)
+    {
+        std::string directory = testing::TempDir();
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(20, 2.0, 40.0, 12.0, true, 0.0);
+        int count = airfoil.size();
+        std::string key = SolutionCache::createKey(airfoil, 3.0, SolverOptions());
+        {
+            SolutionCache cache(1 << 20, directory);
+            cache.insert(key, createSolution(count, 5.0));
+        }
+
+        // a new cache finds the solution on disk
+        SolutionCache cache(1 << 20, directory);
+        CachedSolution solution;
+        ASSERT_TRUE(cache.find(key, solution));
+        ASSERT_EQ(solution.lambdas, std::vector<double>(count, 5.0));
+        ASSERT_EQ(solution.gammas, std::vector<double>(count, -5.0));
+        ASSERT_EQ(solution.pressures, std::vector<double>(count, 10.0));
+        ASSERT_EQ(solution.report.iterations, 7);
+        ASSERT_EQ(solution.report.residual, 1e-11);
+        ASSERT_TRUE(solution.report.converged);
+        ASSERT_EQ(cache.entryCount(), 1);
+        ASSERT_FALSE(cache.find(key + " other", solution));
+
+        // a file whose value count disagrees with the panel count of its key is rejected
+        std::string mismatched = SolutionCache::createKey(airfoil, 4.0, SolverOptions());
+        SolutionCache(1 << 20, directory).insert(mismatched, createSolution(count + 1, 5.0));
+        ASSERT_FALSE(cache.find(mismatched, solution));
+        ASSERT_FALSE(SolutionCache(1 << 20, directory).find("short", solution));
+    }
+
+    TEST(SolutionCache, computeSourceVortex)
+    {
+        Airfoil airfoil = Airfoil::getNACA4Airfoil(60, 2.0, 40.0, 12.0, true, 0.0);
+        Airfoil expected = PanelMethods::computeSourceVortex(airfoil, 4.0);
+
+        std::shared_ptr<SolutionCache> cache = std::make_shared<SolutionCache>(1 << 20);
+        PanelMethods::setSolutionCache(cache);
+        Airfoil first = PanelMethods::computeSourceVortex(airfoil, 4.0);
+        Airfoil second = PanelMethods::computeSourceVortex(airfoil, 4.0);
+        PanelMethods::setSolutionCache(nullptr);
+
+        ASSERT_EQ(cache->missCount(), 1);
+        ASSERT_EQ(cache->hitCount(), 1);
+        for (int i = 0; i < airfoil.size(); ++i)
+        {
+            ASSERT_EQ(first[i].lambda, expected[i].lambda);
+            ASSERT_EQ(second[i].lambda, expected[i].lambda);
+            ASSERT_EQ(second[i].gamma, expected[i].gamma);
+            ASSERT_EQ(second[i].coefficientOfPressure, expected[i].coefficientOfPressure);
+            ASSERT_EQ(second[i].alphaAngle, expected[i].alphaAngle);
+        }
+        ASSERT_EQ(second.getCoefficientOfLift(), expected.getCoefficientOfLift());
+
+        // a different solver is a different entry, and the report of a hit is the stored one
+        SolverOptions options;
+        options.method = SolverMethod::GMRES;
+        PanelMethods::setSolutionCache(cache);
+        SolverReport solved, stored;
+        PanelMethods::computeSourceVortex(airfoil, 4.0, options, &solved);
+        PanelMethods::computeSourceVortex(airfoil, 4.0, options, &stored);
+        PanelMethods::setSolutionCache(nullptr);
+        ASSERT_EQ(cache->missCount(), 2);
+        ASSERT_EQ(cache->hitCount(), 2);
+        ASSERT_TRUE(stored.converged);
+        ASSERT_EQ(stored.iterations, solved.iterations);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "solver_workspace.h"
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using aerodynamics::SolverWorkspace;
+
+namespace
+{
+    TEST(SolverWorkspace, SolverWorkspace)
+    {
+        SolverWorkspace workspace(50);
+        ASSERT_TRUE(workspace.solved.empty());
+        ASSERT_EQ(workspace.geometry.size(), 0);
+        ASSERT_EQ(workspace.matrices.system.rowCount(), 0);
+        ASSERT_EQ(workspace.matrices.tangential.rowCount(), 0);
+        ASSERT_EQ(workspace.factorization.order(), 0);
+        ASSERT_GE(workspace.solved.capacity(), 50);
+        ASSERT_GE(workspace.geometry.getBeta().capacity(), 50);
+        ASSERT_GE(workspace.matrices.vortexTangential.capacity(), 50);
+        ASSERT_GE(workspace.rightHandSide.capacity(), 51);
+        ASSERT_GE(workspace.strengths.capacity(), 51);
+        ASSERT_GE(workspace.velocities.capacity(), 50);
+    }
+
+    TEST(SolverWorkspace, SolverWorkspaceInvalidArguments)
+    {
+        ASSERT_THROW(SolverWorkspace(-1), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "source_vortex_operator.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "influence_matrices.h"
+#include "matrix.h"
+#include "panel_geometry.h"
+#include "panel_methods.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::InfluenceMatrices;
+using aerodynamics::PanelGeometry;
+using aerodynamics::PanelMethods;
+using aerodynamics::SourceVortexOperator;
+using aerodynamics::TreecodeOptions;
+using linear_algebra::Matrix;
+
+namespace
+{
+    TEST(SourceVortexOperator, apply)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(600, 2, 40, 12, false, 0);
+        InfluenceMatrices matrices = PanelMethods::computeInfluenceMatrices(PanelGeometry(a));
+        TreecodeOptions options;
+        options.leafSize = 16;
+        SourceVortexOperator sourceVortex(a, options);
+        ASSERT_EQ(sourceVortex.size(), 601);
+
+        std::mt19937_64 generator(7);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::vector<double> x(601), expected(601), y(601);
+        for (int j = 0; j < 601; ++j)
+            x[j] = uniform(generator);
+        matrices.system.multiply(x.data(), expected.data());
+        sourceVortex.apply(x.data(), y.data());
+        // the far clusters are truncated expansions, the near pairs are exact
+        for (int i = 0; i < 601; ++i)
+            ASSERT_NEAR(y[i], expected[i], 1e-7);
+
+        matrices.tangential.multiply(x.data(), expected.data());
+        sourceVortex.multiplyTangential(x.data(), y.data());
+        for (int i = 0; i < 600; ++i)
+        {
+            ASSERT_NEAR(y[i], expected[i], 1e-7);
+            ASSERT_NEAR(sourceVortex.getVortexTangential()[i], matrices.vortexTangential[i], 1e-7);
+        }
+    }
+
+    TEST(SourceVortexOperator, entry)
+    {
+        Airfoil a = Airfoil::getNACA4Airfoil(60, 2, 40, 12, false, 0);
+        Matrix system = PanelMethods::computeSourceVortexMatrix(a);
+        SourceVortexOperator sourceVortex(a);
+        // panel pairs and the Kutta row are exact, the vortex column sums a row through the expansions
+        for (int i = 0; i <= 60; ++i)
+        {
+            for (int j = 0; j < 60; j++)
+                ASSERT_NEAR(sourceVortex.entry(i, j), system(i, j), 1e-12);
+            ASSERT_NEAR(sourceVortex.entry(i, 60), system(i, 60), 1e-8);
+        }
+        ASSERT_THROW(sourceVortex.entry(61, 0), std::invalid_argument);
+        ASSERT_THROW(sourceVortex.entry(0, -1), std::invalid_argument);
+    }
+
+    TEST(SourceVortexOperator, SourceVortexOperatorInvalidArguments)
+    {
+        ASSERT_THROW(SourceVortexOperator(std::vector<aerodynamics::Panel>()), std::invalid_argument);
+        TreecodeOptions options;
+        options.leafSize = 0;
+        ASSERT_THROW(SourceVortexOperator(Airfoil::getNACA4Airfoil(20, 2, 40, 12, false, 0), options), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
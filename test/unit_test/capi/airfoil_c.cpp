@@ -0,0 +1,119 @@
+#include "airfoil_c.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel_methods.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+
+namespace
+{
+    TEST(AirfoilC, airfoil_naca4_points)
+    {
+        ASSERT_EQ(airfoil_abi_version(), AIRFOIL_ABI_VERSION);
+        airfoil_naca4 naca{2.0, 40.0, 12.0, 60, 0};
+        std::vector<double> x(61), y(61);
+        ASSERT_EQ(airfoil_naca4_points(&naca, x.data(), y.data()), AIRFOIL_OK);
+        Airfoil a = Airfoil::getNACA4Airfoil(60, 2.0, 40.0, 12.0, false, 0.0);
+        for (int i = 0; i < 60; ++i)
+        {
+            ASSERT_EQ(x[i], a[i].getStart().x);
+            ASSERT_EQ(y[i], a[i].getStart().y);
+        }
+        ASSERT_EQ(x[60], a[59].getEnd().x);
+        ASSERT_STREQ(airfoil_last_error(), "");
+
+        naca.point_count = 61;
+        ASSERT_EQ(airfoil_naca4_points(&naca, x.data(), y.data()), AIRFOIL_INVALID_ARGUMENT);
+        ASSERT_STRNE(airfoil_last_error(), "");
+        ASSERT_EQ(airfoil_naca4_points(nullptr, x.data(), y.data()), AIRFOIL_INVALID_ARGUMENT);
+    }
+
+    TEST(AirfoilC, airfoil_solver_solve)
+    {
+        airfoil_naca4 naca{2.0, 40.0, 12.0, 80, 1};
+        airfoil_solver *solver = nullptr;
+        ASSERT_EQ(airfoil_solver_create_naca4(&naca, &solver), AIRFOIL_OK);
+        ASSERT_EQ(airfoil_solver_panel_count(solver), 80);
+
+        double lift, drag, moment;
+        std::vector<double> pressures(80);
+        ASSERT_EQ(airfoil_solver_solve(solver, 4.0, &lift, &drag, &moment, pressures.data()), AIRFOIL_OK);
+        Airfoil b = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(80, 2.0, 40.0, 12.0, true, 0.0), 4.0);
+        ASSERT_NEAR(lift, b.getCoefficientOfLift(), 1e-10);
+        ASSERT_NEAR(drag, b.getCoefficientOfDrag(), 1e-10);
+        ASSERT_NEAR(moment, b.getCoefficientOfMoment(), 1e-10);
+        for (int i = 0; i < 80; ++i)
+            ASSERT_NEAR(pressures[i], b[i].coefficientOfPressure, 1e-10);
+        ASSERT_EQ(airfoil_solver_solve(solver, 4.0, nullptr, &drag, &moment, nullptr), AIRFOIL_INVALID_ARGUMENT);
+
+        // the same contour given as points solves to the same airfoil
+        std::vector<double> x(81), y(81);
+        ASSERT_EQ(airfoil_naca4_points(&naca, x.data(), y.data()), AIRFOIL_OK);
+        airfoil_solver *contour = nullptr;
+        ASSERT_EQ(airfoil_solver_create(x.data(), y.data(), 81, &contour), AIRFOIL_OK);
+        double contourLift, contourDrag, contourMoment;
+        ASSERT_EQ(airfoil_solver_solve(contour, 4.0, &contourLift, &contourDrag, &contourMoment, nullptr), AIRFOIL_OK);
+        ASSERT_NEAR(contourLift, lift, 1e-12);
+        airfoil_solver_destroy(contour);
+        airfoil_solver_destroy(solver);
+        airfoil_solver_destroy(nullptr);
+
+        x[1] = x[0];
+        y[1] = y[0];
+        ASSERT_EQ(airfoil_solver_create(x.data(), y.data(), 81, &contour), AIRFOIL_INVALID_ARGUMENT);
+        ASSERT_EQ(contour, nullptr);
+        ASSERT_EQ(airfoil_solver_create(x.data(), y.data(), 3, &contour), AIRFOIL_INVALID_ARGUMENT);
+    }
+
+    TEST(AirfoilC, airfoil_solver_polar)
+    {
+        airfoil_naca4 naca{4.0, 40.0, 12.0, 60, 0};
+        airfoil_solver *solver = nullptr;
+        ASSERT_EQ(airfoil_solver_create_naca4(&naca, &solver), AIRFOIL_OK);
+        std::vector<double> angles = {-4.0, 0.0, 6.0};
+        std::vector<double> lift(3), drag(3), moment(3), pressures(3 * 60);
+        ASSERT_EQ(airfoil_solver_polar(solver, angles.data(), 3, lift.data(), drag.data(), moment.data(), pressures.data()), AIRFOIL_OK);
+        for (int k = 0; k < 3; ++k)
+        {
+            double single[3];
+            std::vector<double> singlePressures(60);
+            airfoil_solver_solve(solver, angles[k], &single[0], &single[1], &single[2], singlePressures.data());
+            ASSERT_EQ(lift[k], single[0]);
+            ASSERT_EQ(drag[k], single[1]);
+            ASSERT_EQ(moment[k], single[2]);
+            ASSERT_EQ(pressures[k * 60 + 17], singlePressures[17]);
+        }
+        ASSERT_EQ(airfoil_solver_polar(solver, angles.data(), -1, lift.data(), drag.data(), moment.data(), nullptr), AIRFOIL_INVALID_ARGUMENT);
+        airfoil_solver_destroy(solver);
+    }
+
+    TEST(AirfoilC, airfoil_solver_field)
+    {
+        airfoil_naca4 naca{2.0, 40.0, 12.0, 60, 0};
+        airfoil_solver *solver = nullptr;
+        ASSERT_EQ(airfoil_solver_create_naca4(&naca, &solver), AIRFOIL_OK);
+        std::vector<double> x = {-0.5, 0.5, 1.5}, y = {0.0, 0.3, -0.2};
+        std::vector<double> vx(3), vy(3), cp(3), treeVx(3), treeVy(3), treeCp(3);
+        ASSERT_EQ(airfoil_solver_field(solver, 3.0, x.data(), y.data(), 3, 0, vx.data(), vy.data(), cp.data()), AIRFOIL_OK);
+        ASSERT_EQ(airfoil_solver_field(solver, 3.0, x.data(), y.data(), 3, 1, treeVx.data(), treeVy.data(), treeCp.data()), AIRFOIL_OK);
+
+        Airfoil b = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(60, 2.0, 40.0, 12.0, false, 0.0), 3.0);
+        std::vector<double> expectedVx(3), expectedVy(3), expectedCp(3);
+        PanelMethods::computeVelocityField(b, x.data(), y.data(), 3, expectedVx.data(), expectedVy.data(), expectedCp.data());
+        for (int k = 0; k < 3; ++k)
+        {
+            ASSERT_NEAR(vx[k], expectedVx[k], 1e-10);
+            ASSERT_NEAR(vy[k], expectedVy[k], 1e-10);
+            ASSERT_NEAR(cp[k], expectedCp[k], 1e-10);
+            ASSERT_NEAR(treeVx[k], expectedVx[k], 1e-8);
+            ASSERT_NEAR(treeCp[k], expectedCp[k], 1e-8);
+        }
+        airfoil_solver_destroy(solver);
+    }
+} // namespace
\ No newline at end of file
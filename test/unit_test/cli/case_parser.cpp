@@ -0,0 +1,93 @@
+#include "case_parser.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "case_definition.h"
+#include "field_writer.h"
+#include "json_value.h"
+#include "solver_options.h"
+
+using aerodynamics::SolverMethod;
+using cli::CaseDefinition;
+using cli::CaseParser;
+using cli::CommandLine;
+using io::FieldFormat;
+using io::JsonValue;
+
+namespace
+{
+    TEST(CaseParser, parse)
+    {
+        CaseDefinition definition = CaseParser::parse(JsonValue::parse("{\"id\": 7, \"naca\": \"2412\", \"points\": 60, \"alpha\": \"-2:3:2.5\", \"solver\": \"matrix-free\", \"tolerance\": 1e-8, "
+                                                                       "\"pressure\": true, \"polar\": \"a.polar\", \"field\": \"a.vtk\", \"fieldFormat\": \"vtk\", \"fieldGrid\": [-1, -0.5, 0.1, 0.05, 30, 20], \"fieldTreecode\": true}"));
+        ASSERT_EQ(definition.id, "7");
+        ASSERT_EQ(definition.maxCamberPercent, 2.0);
+        ASSERT_EQ(definition.maxCamberPositionPercent, 40.0);
+        ASSERT_EQ(definition.thicknessPercent, 12.0);
+        ASSERT_EQ(definition.pointCount, 60);
+        ASSERT_EQ(definition.angles, std::vector<double>({-2.0, 0.5, 3.0}));
+        ASSERT_EQ(definition.solver.method, SolverMethod::MatrixFreeGMRES);
+        ASSERT_EQ(definition.solver.tolerance, 1e-8);
+        ASSERT_TRUE(definition.includePressure);
+        ASSERT_EQ(definition.polarPath, "a.polar");
+        ASSERT_EQ(definition.fieldPath, "a.vtk");
+        ASSERT_EQ(definition.field.format, FieldFormat::VTK);
+        ASSERT_TRUE(definition.field.useTreecode);
+        ASSERT_EQ(definition.fieldGrid.originX, -1.0);
+        ASSERT_EQ(definition.fieldGrid.spacingY, 0.05);
+        ASSERT_EQ(definition.fieldGrid.columns, 30);
+        ASSERT_EQ(definition.fieldGrid.rows, 20);
+
+        definition = CaseParser::parse(JsonValue::parse("{\"naca\": 12, \"maxCamber\": 1.5, \"alpha\": [1, 2]}"));
+        ASSERT_EQ(definition.maxCamberPercent, 1.5);
+        ASSERT_EQ(definition.maxCamberPositionPercent, 0.0);
+        ASSERT_EQ(definition.thicknessPercent, 12.0);
+        ASSERT_EQ(definition.angles, std::vector<double>({1.0, 2.0}));
+        ASSERT_EQ(definition.solver.method, SolverMethod::LowerUpperDecomposition);
+
+        definition = CaseParser::parse(JsonValue::parse("{\"alpha\": \"4:-4:-4\"}"));
+        ASSERT_EQ(definition.angles, std::vector<double>({4.0, 0.0, -4.0}));
+    }
+
+    TEST(CaseParser, parseInvalidArguments)
+    {
+        for (const char *text : {"[]", "{\"unknown\": 1}", "{\"naca\": \"24120\"}", "{\"naca\": \"24a2\"}", "{\"points\": 61}", "{\"points\": 2}", "{\"alpha\": []}", "{\"alpha\": \"0:4:-1\"}",
+                                 "{\"alpha\": \"0:4\"}", "{\"solver\": \"qr\"}", "{\"tolerance\": 0}", "{\"fieldGrid\": [0, 0, 1, 1, 2.5, 3]}", "{\"fieldFormat\": \"png\"}", "{\"pressure\": 1}"})
+            ASSERT_THROW(CaseParser::parse(JsonValue::parse(text)), std::invalid_argument) << text;
+    }
+
+    TEST(CaseParser, parseArguments)
+    {
+        const char *arguments[] = {"airfoil_cli", "--naca", "0012", "--alpha", "-4:4:2", "--points", "80", "--field-grid", "0,0,0.5,0.5,3,2", "--pressure", "--cases", "-", "--output", "out.jsonl", "--id", "a,b"};
+        CommandLine commandLine = CaseParser::parseArguments(16, arguments);
+        ASSERT_EQ(commandLine.casesPath, "-");
+        ASSERT_EQ(commandLine.outputPath, "out.jsonl");
+        ASSERT_FALSE(commandLine.help);
+        ASSERT_EQ(commandLine.flags.serialize(), "{\"naca\":\"0012\",\"alpha\":\"-4:4:2\",\"points\":80,\"fieldGrid\":[0,0,0.5,0.5,3,2],\"pressure\":true,\"id\":\"a,b\"}");
+
+        CaseDefinition definition = CaseParser::parse(commandLine.flags);
+        ASSERT_EQ(definition.thicknessPercent, 12.0);
+        ASSERT_EQ(definition.angles, std::vector<double>({-4.0, -2.0, 0.0, 2.0, 4.0}));
+        ASSERT_EQ(definition.fieldGrid.columns, 3);
+        ASSERT_TRUE(definition.includePressure);
+
+        const char *help[] = {"airfoil_cli", "--help"};
+        ASSERT_TRUE(CaseParser::parseArguments(2, help).help);
+        const char *positional[] = {"airfoil_cli", "2412"};
+        ASSERT_THROW(CaseParser::parseArguments(2, positional), std::invalid_argument);
+        const char *missing[] = {"airfoil_cli", "--cases"};
+        ASSERT_THROW(CaseParser::parseArguments(2, missing), std::invalid_argument);
+
+        const char *server[] = {"airfoil_cli", "--socket", "/tmp/airfoil.sock", "--solver", "gmres", "--profile", "profile.json", "--trace", "trace.json"};
+        CommandLine serverLine = CaseParser::parseArguments(9, server);
+        ASSERT_TRUE(serverLine.serve);
+        ASSERT_EQ(serverLine.socketPath, "/tmp/airfoil.sock");
+        ASSERT_EQ(serverLine.profilePath, "profile.json");
+        ASSERT_EQ(serverLine.tracePath, "trace.json");
+        ASSERT_EQ(serverLine.flags.serialize(), "{\"solver\":\"gmres\"}");
+    }
+} // namespace
\ No newline at end of file
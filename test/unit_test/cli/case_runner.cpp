@@ -0,0 +1,97 @@
+#include "case_runner.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "case_definition.h"
+#include "field_writer.h"
+#include "json_value.h"
+#include "panel_methods.h"
+#include "polar_file.h"
+#include "polar_files.h"
+#include "solver_options.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using aerodynamics::SolverMethod;
+using cli::CaseDefinition;
+using cli::CaseRunner;
+using cli::PolarFiles;
+using io::FieldFormat;
+using io::JsonValue;
+using io::PolarReader;
+using io::PolarRecord;
+
+namespace
+{
+    TEST(CaseRunner, run)
+    {
+        CaseDefinition definition;
+        definition.id = "case";
+        definition.maxCamberPercent = 2.0;
+        definition.maxCamberPositionPercent = 40.0;
+        definition.pointCount = 60;
+        definition.angles = {0.0, 4.0};
+        definition.includePressure = true;
+        PolarFiles polarFiles;
+        JsonValue result = CaseRunner::run(definition, 0, polarFiles);
+
+        Airfoil solved = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(60, 2.0, 40.0, 12.0, false, 0.0), 4.0);
+        ASSERT_EQ(result.find("id")->getString(), "case");
+        ASSERT_EQ(result.find("points")->getNumber(), 60);
+        ASSERT_EQ(result.find("alpha")->getArray().size(), 2);
+        ASSERT_NEAR(result.find("cl")->getArray()[1].getNumber(), solved.getCoefficientOfLift(), 1e-10);
+        ASSERT_NEAR(result.find("cd")->getArray()[1].getNumber(), solved.getCoefficientOfDrag(), 1e-10);
+        ASSERT_NEAR(result.find("cm")->getArray()[1].getNumber(), solved.getCoefficientOfMoment(), 1e-10);
+        ASSERT_EQ(result.find("cp")->getArray()[1].getArray().size(), 60);
+        ASSERT_NEAR(result.find("cp")->getArray()[1].getArray()[5].getNumber(), solved[5].coefficientOfPressure, 1e-10);
+        ASSERT_EQ(result.find("iterations"), nullptr);
+        ASSERT_GE(result.find("seconds")->getNumber(), 0.0);
+
+        // an iterative solver reports its iterations
+        definition.solver.method = SolverMethod::GMRES;
+        definition.includePressure = false;
+        result = CaseRunner::run(definition, 0, polarFiles);
+        ASSERT_NEAR(result.find("cl")->getArray()[1].getNumber(), solved.getCoefficientOfLift(), 1e-8);
+        ASSERT_GT(result.find("iterations")->getNumber(), 0);
+        ASSERT_EQ(result.find("cp"), nullptr);
+    }
+
+    TEST(CaseRunner, runFiles)
+    {
+        std::string polarPath = testing::TempDir() + "/case_runner.polar";
+        std::string fieldPath = testing::TempDir() + "/case_runner.vtk";
+        std::remove(polarPath.c_str());
+        CaseDefinition definition;
+        definition.pointCount = 40;
+        definition.angles = {2.0, 6.0};
+        definition.polarPath = polarPath;
+        definition.fieldPath = fieldPath;
+        definition.fieldGrid = {-0.5, -0.5, 0.1, 0.1, 20, 10};
+        definition.field.format = FieldFormat::VTK;
+        PolarFiles polarFiles;
+        JsonValue first = CaseRunner::run(definition, 3, polarFiles);
+        definition.thicknessPercent = 9.0;
+        CaseRunner::run(definition, 4, polarFiles);
+        ASSERT_EQ(polarFiles.fileCount(), 1);
+
+        PolarReader reader(polarPath);
+        ASSERT_EQ(reader.caseCount(), 2);
+        PolarRecord record = reader.getCase(0);
+        ASSERT_EQ(record.index, 3);
+        ASSERT_EQ(record.pointCount, 40);
+        ASSERT_EQ(record.angleCount, 2);
+        ASSERT_EQ(record.lift[1], first.find("cl")->getArray()[1].getNumber());
+        ASSERT_EQ(reader.getCase(1).thicknessPercent, 9.0);
+
+        std::ifstream field(fieldPath, std::ios::binary | std::ios::ate);
+        ASSERT_GT(static_cast<long>(field.tellg()), 16 * 200);
+        std::remove(polarPath.c_str());
+        std::remove(fieldPath.c_str());
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "polar_files.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "naca_sweep.h"
+#include "polar.h"
+#include "polar_file.h"
+
+using aerodynamics::Polar;
+using aerodynamics::SweepCase;
+using cli::PolarFiles;
+using io::PolarReader;
+
+namespace
+{
+    TEST(PolarFiles, append)
+    {
+        std::string first = testing::TempDir() + "/polar_files_first.polar";
+        std::string second = testing::TempDir() + "/polar_files_second.polar";
+        std::remove(first.c_str());
+        std::remove(second.c_str());
+        Polar polar{{2.0}, {0.2}, {0.01}, {-0.05}, 0, {}};
+        PolarFiles polarFiles;
+        for (int k = 0; k < 5; ++k)
+            polarFiles.append(k % 2 == 0 ? first : second, SweepCase{k, 2.0, 40.0, 12.0, 40, polar});
+        ASSERT_EQ(polarFiles.fileCount(), 2);
+
+        PolarReader firstReader(first);
+        ASSERT_EQ(firstReader.caseCount(), 3);
+        ASSERT_EQ(firstReader.getCase(2).index, 4);
+        ASSERT_EQ(PolarReader(second).caseCount(), 2);
+
+        // a file that cannot be opened is not kept, so a later case retries it
+        ASSERT_THROW(polarFiles.append(testing::TempDir() + "/missing/case.polar", SweepCase{5, 2.0, 40.0, 12.0, 40, polar}), std::runtime_error);
+        ASSERT_EQ(polarFiles.fileCount(), 2);
+        std::remove(first.c_str());
+        std::remove(second.c_str());
+    }
+} // namespace
\ No newline at end of file
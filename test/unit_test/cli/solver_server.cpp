@@ -0,0 +1,172 @@
+#include "solver_server.h"
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "airfoil.h"
+#include "json_value.h"
+#include "panel_methods.h"
+#include "polar_file.h"
+#include "thread_pool.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using cli::ServerOptions;
+using cli::SolverServer;
+using concurrency::ThreadPool;
+using io::JsonType;
+using io::JsonValue;
+using io::PolarReader;
+using io::PolarRecord;
+
+namespace
+{
+    TEST(SolverServer, handle)
+    {
+        ServerOptions options;
+        options.defaults.set("points", 60);
+        SolverServer server(options);
+
+        JsonValue first = server.handle("{\"id\":\"a\",\"naca\":\"2412\",\"alpha\":[0,4]}");
+        Airfoil solved = PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(60, 2.0, 40.0, 12.0, false, 0.0), 4.0);
+        ASSERT_EQ(first.find("id")->getString(), "a");
+        ASSERT_EQ(first.find("type")->getString(), "solve");
+        ASSERT_EQ(first.find("points")->getNumber(), 60);
+        ASSERT_NEAR(first.find("cl")->getArray()[1].getNumber(), solved.getCoefficientOfLift(), 1e-10);
+        ASSERT_GE(first.find("latency")->getNumber(), 0.0);
+
+        // a second angle of the same airfoil reuses its basis solution
+        JsonValue second = server.handle("{\"naca\":\"2412\",\"alpha\":4}");
+        ASSERT_NEAR(second.find("cl")->getArray()[0].getNumber(), solved.getCoefficientOfLift(), 1e-10);
+        server.handle("{\"naca\":\"2412\",\"alpha\":4,\"solver\":\"gmres\"}");
+        server.handle("{\"naca\":\"2412\",\"alpha\":4,\"solver\":\"gmres\"}");
+
+        JsonValue statistics = server.handle("{\"type\":\"stats\"}");
+        ASSERT_EQ(statistics.find("type")->getString(), "stats");
+        ASSERT_EQ(statistics.find("requests")->getNumber(), 4);
+        ASSERT_EQ(statistics.find("errors")->getNumber(), 0);
+        ASSERT_EQ(statistics.find("basisEntries")->getNumber(), 1);
+        ASSERT_EQ(statistics.find("basisHits")->getNumber(), 1);
+        ASSERT_EQ(statistics.find("basisMisses")->getNumber(), 1);
+        ASSERT_EQ(statistics.find("solutionHits")->getNumber(), 1);
+        ASSERT_GE(statistics.find("maxLatency")->getNumber(), statistics.find("meanLatency")->getNumber());
+
+        JsonValue invalid = server.handle("{\"id\":\"b\",\"naca\":\"24x\"}");
+        ASSERT_EQ(invalid.find("id")->getString(), "b");
+        ASSERT_NE(invalid.find("error"), nullptr);
+        ASSERT_NE(server.handle("[1]").find("error"), nullptr);
+        ASSERT_NE(server.handle("{\"type\":\"plot\"}").find("error"), nullptr);
+        ASSERT_NE(server.handle("{\"type\":\"field\",\"naca\":\"0012\"}").find("error"), nullptr);
+        ASSERT_EQ(server.handle("{\"type\":\"stats\"}").find("errors")->getNumber(), 4);
+    }
+
+    TEST(SolverServer, serve)
+    {
+        // several workers so a request after the shutdown would be answered if the reader kept going
+        ThreadPool::setSharedThreadCount(4);
+        SolverServer server;
+        std::istringstream input("{\"id\":\"a\",\"naca\":\"0012\",\"points\":40}\n"
+                                 "\n"
+                                 "{\"id\":\"b\",\"naca\":\"0012\",\"points\":40,\"alpha\":2}\n"
+                                 "not json\n"
+                                 "{\"type\":\"shutdown\"}\n"
+                                 "{\"id\":\"c\",\"naca\":\"0012\",\"points\":40}\n");
+        std::ostringstream output;
+        server.serve(input, output);
+
+        // responses come in completion order, and the request after the shutdown is not read
+        std::istringstream lines(output.str());
+        std::set<std::string> ids;
+        int errors = 0;
+        int count = 0;
+        for (std::string line; std::getline(lines, line); ++count)
+        {
+            JsonValue response = JsonValue::parse(line);
+            if (response.find("error") != nullptr)
+                errors++;
+            else if (response.find("id") != nullptr)
+                ids.insert(response.find("id")->getString());
+        }
+        ThreadPool::setSharedThreadCount(ThreadPool::defaultThreadCount());
+        ASSERT_EQ(count, 4);
+        ASSERT_EQ(errors, 1);
+        ASSERT_EQ(ids, std::set<std::string>({"a", "b"}));
+    }
+
+    TEST(SolverServer, serveIndices)
+    {
+        std::string path = "/tmp/airfoils_solver_server_test.polar";
+        std::remove(path.c_str());
+        ThreadPool::setSharedThreadCount(4);
+        {
+            SolverServer server;
+            std::string requests;
+            for (int k = 0; k < 8; ++k)
+                requests += "{\"type\":\"polar\",\"naca\":\"0012\",\"points\":40,\"alpha\":" + std::to_string(k) + ",\"polar\":\"" + path + "\"}\n";
+            std::istringstream input(requests);
+            std::ostringstream output;
+            server.serve(input, output);
+        }
+        ThreadPool::setSharedThreadCount(ThreadPool::defaultThreadCount());
+
+        // concurrent requests store the index of their line, each one once
+        PolarReader reader(path);
+        ASSERT_EQ(reader.caseCount(), 8);
+        std::set<int> indices;
+        for (int k = 0; k < reader.caseCount(); ++k)
+        {
+            PolarRecord record = reader.getCase(k);
+            indices.insert(record.index);
+            ASSERT_EQ(record.angles[0], record.index);
+        }
+        ASSERT_EQ(indices.size(), 8);
+        std::remove(path.c_str());
+    }
+
+    TEST(SolverServer, listen)
+    {
+        std::string path = "/tmp/airfoils_solver_server_test.sock";
+        SolverServer server;
+        std::thread listener([&server, &path]
+                             { server.listen(path); });
+
+        int descriptor = -1;
+        for (int attempt = 0; attempt < 200 && descriptor < 0; ++attempt)
+        {
+            descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            path.copy(address.sun_path, path.size());
+            if (::connect(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+            {
+                ::close(descriptor);
+                descriptor = -1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        ASSERT_GE(descriptor, 0);
+
+        std::string request = "{\"id\":\"a\",\"naca\":\"0012\",\"points\":40,\"alpha\":2}\n{\"type\":\"shutdown\"}\n";
+        ASSERT_EQ(::write(descriptor, request.data(), request.size()), static_cast<ssize_t>(request.size()));
+        std::string received;
+        char buffer[4096];
+        for (ssize_t count; (count = ::read(descriptor, buffer, sizeof(buffer))) > 0;)
+            received.append(buffer, count);
+        ::close(descriptor);
+        listener.join();
+
+        ASSERT_NE(received.find("\"id\":\"a\""), std::string::npos);
+        ASSERT_NE(received.find("\"type\":\"shutdown\""), std::string::npos);
+        ASSERT_NE(::access(path.c_str(), F_OK), 0);
+    }
+} // namespace
\ No newline at end of file
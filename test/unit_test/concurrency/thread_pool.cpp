@@ -0,0 +1,112 @@
+#include "thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using concurrency::ThreadPool;
+
+namespace
+{
+    TEST(ThreadPool, parallelFor)
+    {
+        for (int threadCount = 1; threadCount <= 4; ++threadCount)
+        {
+            ThreadPool pool(threadCount);
+            ASSERT_EQ(pool.threadCount(), threadCount);
+            std::vector<int> visits(1001, 0);
+            pool.parallelFor(0, visits.size(), 7, [&visits](int begin, int end)
+                             {
+                for (int i = begin; i < end; ++i)
+                    visits[i]++; });
+            for (int visit : visits)
+                ASSERT_EQ(visit, 1);
+        }
+    }
+
+    TEST(ThreadPool, parallelForNested)
+    {
+        ThreadPool pool(3);
+        std::atomic<int> sum(0);
+        pool.parallelFor(0, 8, 1, [&pool, &sum](int, int)
+                         { pool.parallelFor(0, 100, 3, [&sum](int innerBegin, int innerEnd)
+                                            { sum += innerEnd - innerBegin; }); });
+        ASSERT_EQ(sum.load(), 800);
+    }
+
+    TEST(ThreadPool, parallelForException)
+    {
+        ThreadPool pool(4);
+        std::atomic<int> chunks(0);
+        ASSERT_THROW(pool.parallelFor(0, 64, 1, [&chunks](int begin, int)
+                                      {
+                                          chunks++;
+                                          if (begin == 13)
+                                              throw std::runtime_error("chunk failed"); }),
+                     std::runtime_error);
+        ASSERT_EQ(chunks.load(), 64);
+    }
+
+    TEST(ThreadPool, submit)
+    {
+        for (int threadCount = 1; threadCount <= 3; ++threadCount)
+        {
+            ThreadPool pool(threadCount);
+            std::promise<int> promise;
+            std::future<int> future = promise.get_future();
+            pool.submit([&promise]
+                        { promise.set_value(42); });
+            ASSERT_EQ(future.get(), 42);
+        }
+    }
+
+    TEST(ThreadPool, submitStealing)
+    {
+        // a task that waits on tasks it queued on its own deque only finishes if other workers steal them
+        ThreadPool pool(3);
+        std::promise<void> promise;
+        std::future<void> future = promise.get_future();
+        pool.submit([&pool, &promise]
+                    {
+            std::atomic<int> finished(0);
+            for (int i = 0; i < 16; ++i)
+                pool.submit([&finished]
+                            { finished++; });
+            while (finished.load() < 16)
+                std::this_thread::yield();
+            promise.set_value(); });
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+    }
+
+    TEST(ThreadPool, submitDrains)
+    {
+        std::atomic<int> finished(0);
+        {
+            ThreadPool pool(4);
+            for (int i = 0; i < 1000; ++i)
+                pool.submit([&finished]
+                            { finished++; });
+        }
+        ASSERT_EQ(finished.load(), 1000);
+    }
+
+    TEST(ThreadPool, shared)
+    {
+        ThreadPool::setSharedThreadCount(2);
+        ASSERT_EQ(ThreadPool::shared().threadCount(), 2);
+        ThreadPool::setSharedThreadCount(ThreadPool::defaultThreadCount());
+        ASSERT_EQ(ThreadPool::shared().threadCount(), ThreadPool::defaultThreadCount());
+    }
+
+    TEST(ThreadPool, ThreadPoolInvalidArguments)
+    {
+        ASSERT_THROW(ThreadPool(0), std::invalid_argument);
+        ThreadPool pool(2);
+        ASSERT_THROW(pool.parallelFor(0, 10, 0, [](int, int) {}), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "json_value.h"
+#include "panel_methods.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::PanelMethods;
+using instrumentation::Counter;
+using instrumentation::Profiler;
+using instrumentation::ScopedTimer;
+using io::JsonValue;
+
+namespace
+{
+    TEST(Profiler, getReport)
+    {
+        Profiler::reset();
+        Profiler::setEnabled(false);
+        Profiler::count(Counter::Allocations, 1);
+        {
+            ScopedTimer timer("disabled");
+        }
+        ASSERT_EQ(Profiler::getReport().find("timers")->getMembers().size(), 0);
+        ASSERT_EQ(Profiler::getReport().find("threads")->getArray().size(), 0);
+
+        Profiler::setEnabled(true);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Profiler::recordTimer("phase", start, start + std::chrono::milliseconds(2));
+        Profiler::recordTimer("phase", start, start + std::chrono::milliseconds(4));
+        Profiler::count(Counter::SolveResidual, 1e-3);
+        Profiler::count(Counter::SolveResidual, 1e-5);
+        std::thread([]
+                    {
+            ScopedTimer timer("phase");
+            Profiler::count(Counter::TranscendentalCalls, 10); })
+            .join();
+        Profiler::setEnabled(false);
+
+        JsonValue report = Profiler::getReport();
+        const JsonValue &phase = *report.find("timers")->find("phase");
+        ASSERT_EQ(phase.find("count")->getNumber(), 3);
+        ASSERT_NEAR(phase.find("max")->getNumber(), 4e-3, 1e-9);
+        ASSERT_GE(phase.find("total")->getNumber(), 6e-3);
+        const JsonValue &residual = *report.find("counters")->find("solveResidual");
+        ASSERT_EQ(residual.find("count")->getNumber(), 2);
+        ASSERT_DOUBLE_EQ(residual.find("min")->getNumber(), 1e-5);
+        ASSERT_DOUBLE_EQ(residual.find("max")->getNumber(), 1e-3);
+        ASSERT_EQ(report.find("counters")->find("transcendentalCalls")->find("sum")->getNumber(), 10);
+        ASSERT_EQ(report.find("counters")->find("allocations"), nullptr);
+
+        // the records of each thread are kept apart in the report
+        ASSERT_EQ(report.find("threads")->getArray().size(), 2);
+        ASSERT_EQ(report.find("threads")->getArray()[1].find("timers")->find("phase")->find("count")->getNumber(), 1);
+
+        Profiler::reset();
+        ASSERT_EQ(Profiler::getReport().find("timers")->getMembers().size(), 0);
+    }
+
+    TEST(Profiler, writeChromeTrace)
+    {
+        Profiler::reset();
+        Profiler::setEventCapacity(2);
+        Profiler::setEnabled(true);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int k = 0; k < 3; ++k)
+            Profiler::recordTimer("step", start, start + std::chrono::microseconds(1500));
+        Profiler::setEnabled(false);
+        Profiler::setEventCapacity(std::size_t(1) << 20);
+        ASSERT_EQ(Profiler::getReport().find("droppedEvents")->getNumber(), 1);
+
+        std::string path = "profiler_trace_test.json";
+        Profiler::writeChromeTrace(path);
+        std::ifstream file(path);
+        std::stringstream text;
+        text << file.rdbuf();
+        JsonValue trace = JsonValue::parse(text.str());
+        int complete = 0;
+        for (const JsonValue &event : trace.find("traceEvents")->getArray())
+            if (event.find("ph")->getString() == "X")
+            {
+                complete++;
+                ASSERT_EQ(event.find("name")->getString(), "step");
+                ASSERT_DOUBLE_EQ(event.find("dur")->getNumber(), 1500.0);
+            }
+        ASSERT_EQ(complete, 2);
+        std::remove(path.c_str());
+        ASSERT_THROW(Profiler::writeChromeTrace("missing_directory/trace.json"), std::runtime_error);
+        Profiler::reset();
+    }
+
+    TEST(Profiler, computeSourceVortex)
+    {
+        // the phases are only recorded when the solver is compiled with AIRFOILS_INSTRUMENTATION
+        Profiler::reset();
+        Profiler::setEnabled(true);
+        PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(60, 2, 40, 12, false, 0), 4.0);
+        Profiler::setEnabled(false);
+        JsonValue report = Profiler::getReport();
+        if (Profiler::isCompiledIn())
+        {
+            for (const char *phase : {"computeSourceVortex", "geometry", "assembly", "factorization", "solve", "pressure"})
+                ASSERT_NE(report.find("timers")->find(phase), nullptr) << phase;
+            ASSERT_GE(report.find("counters")->find("transcendentalCalls")->find("sum")->getNumber(), 2.0 * 60 * 59);
+            ASSERT_GE(report.find("counters")->find("matrixBytes")->find("sum")->getNumber(), 8.0 * 61 * 61);
+        }
+        else
+            ASSERT_EQ(report.find("timers")->getMembers().size(), 0);
+        Profiler::reset();
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "field_writer.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "airfoil.h"
+#include "panel.h"
+#include "panel_methods.h"
+#include "velocity_field.h"
+
+using aerodynamics::Airfoil;
+using aerodynamics::FieldGrid;
+using aerodynamics::Panel;
+using aerodynamics::PanelMethods;
+using aerodynamics::VelocityField;
+using io::FieldFormat;
+using io::FieldWriter;
+using io::FieldWriterOptions;
+
+namespace
+{
+    std::vector<unsigned char> readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    float readFloat(const unsigned char *bytes, bool bigEndian)
+    {
+        std::uint32_t bits = 0;
+        for (int b = 0; b < 4; ++b)
+            bits |= static_cast<std::uint32_t>(bytes[bigEndian ? 3 - b : b]) << (8 * b);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::vector<Panel> createPanels()
+    {
+        return PanelMethods::computeSourceVortex(Airfoil::getNACA4Airfoil(100, 2, 40, 12, false, 0), 4).getRotatedPanels();
+    }
+
+    FieldGrid createGrid()
+    {
+        FieldGrid grid;
+        grid.originX = -0.5;
+        grid.originY = -0.5;
+        grid.spacingX = 0.2;
+        grid.spacingY = 0.1;
+        grid.columns = 11;
+        grid.rows = 7;
+        return grid;
+    }
+
+    TEST(FieldWriter, writeRaw)
+    {
+        std::vector<Panel> panels = createPanels();
+        FieldGrid grid = createGrid();
+        VelocityField expected = PanelMethods::computeVelocityField(panels, grid);
+
+        // tiles of two rows, the last one partial
+        std::string path = testing::TempDir() + "/field_writer_raw.bin";
+        FieldWriterOptions options;
+        options.tilePoints = 25;
+        FieldWriter::write(panels, grid, path, options);
+        std::vector<unsigned char> bytes = readFile(path);
+        ASSERT_EQ(bytes.size(), 12 * grid.columns * grid.rows);
+        for (int k = 0; k < grid.columns * grid.rows; ++k)
+        {
+            ASSERT_EQ(readFloat(&bytes[12 * k], false), static_cast<float>(expected.vx[k]));
+            ASSERT_EQ(readFloat(&bytes[12 * k + 4], false), static_cast<float>(expected.vy[k]));
+            ASSERT_EQ(readFloat(&bytes[12 * k + 8], false), static_cast<float>(expected.cp[k]));
+        }
+
+        // the treecode field matches to its accuracy
+        options.useTreecode = true;
+        options.treecode.leafSize = 8;
+        FieldWriter::write(panels, grid, path, options);
+        bytes = readFile(path);
+        ASSERT_EQ(bytes.size(), 12 * grid.columns * grid.rows);
+        for (int k = 0; k < grid.columns * grid.rows; ++k)
+            ASSERT_NEAR(readFloat(&bytes[12 * k + 8], false), expected.cp[k], 1e-5);
+        std::remove(path.c_str());
+    }
+
+    TEST(FieldWriter, writeVTK)
+    {
+        std::vector<Panel> panels = createPanels();
+        FieldGrid grid = createGrid();
+        VelocityField expected = PanelMethods::computeVelocityField(panels, grid);
+        int count = grid.columns * grid.rows;
+
+        std::string path = testing::TempDir() + "/field_writer.vtk";
+        FieldWriterOptions options;
+        options.format = FieldFormat::VTK;
+        options.tilePoints = 1;
+        FieldWriter::write(panels, grid, path, options);
+        std::vector<unsigned char> bytes = readFile(path);
+        std::string text(bytes.begin(), bytes.end());
+        ASSERT_EQ(text.find("# vtk DataFile Version 3.0\n"), 0);
+        ASSERT_NE(text.find("DIMENSIONS 11 7 1\n"), std::string::npos);
+        ASSERT_NE(text.find("POINT_DATA 77\n"), std::string::npos);
+
+        std::string scalarHeader = "LOOKUP_TABLE default\n";
+        std::string vectorHeader = "\nVECTORS velocity float\n";
+        std::size_t scalars = text.find(scalarHeader) + scalarHeader.size();
+        std::size_t vectors = scalars + 4 * count + vectorHeader.size();
+        ASSERT_EQ(text.substr(scalars + 4 * count, vectorHeader.size()), vectorHeader);
+        ASSERT_EQ(bytes.size(), vectors + 12 * count);
+        for (int k = 0; k < count; ++k)
+        {
+            ASSERT_EQ(readFloat(&bytes[scalars + 4 * k], true), static_cast<float>(expected.cp[k]));
+            ASSERT_EQ(readFloat(&bytes[vectors + 12 * k], true), static_cast<float>(expected.vx[k]));
+            ASSERT_EQ(readFloat(&bytes[vectors + 12 * k + 4], true), static_cast<float>(expected.vy[k]));
+            ASSERT_EQ(readFloat(&bytes[vectors + 12 * k + 8], true), 0.0f);
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST(FieldWriter, writeInvalidArguments)
+    {
+        std::vector<Panel> panels = createPanels();
+        FieldGrid grid = createGrid();
+        std::string path = testing::TempDir() + "/field_writer_invalid.bin";
+        ASSERT_THROW(FieldWriter::write(std::vector<Panel>(), grid, path), std::invalid_argument);
+        grid.rows = 0;
+        ASSERT_THROW(FieldWriter::write(panels, grid, path), std::invalid_argument);
+        grid = createGrid();
+        FieldWriterOptions options;
+        options.tilePoints = 0;
+        ASSERT_THROW(FieldWriter::write(panels, grid, path, options), std::invalid_argument);
+        ASSERT_THROW(FieldWriter::write(panels, grid, testing::TempDir() + "/missing/field.bin"), std::runtime_error);
+    }
+} // namespace
\ No newline at end of file
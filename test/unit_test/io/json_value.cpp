@@ -0,0 +1,62 @@
+#include "json_value.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using io::JsonType;
+using io::JsonValue;
+
+namespace
+{
+    TEST(JsonValue, parse)
+    {
+        JsonValue value = JsonValue::parse(" {\"id\": \"a\\\"b\\u00e9\", \"alpha\": [-4, 0.5e1, 1E-2], \"pressure\": true, \"polar\": null, \"nested\": {\"x\": false}} ");
+        ASSERT_EQ(value.getType(), JsonType::Object);
+        ASSERT_EQ(value.getMembers().size(), 5);
+        ASSERT_EQ(value.find("id")->getString(), "a\"b\xc3\xa9");
+        const std::vector<JsonValue> &alpha = value.find("alpha")->getArray();
+        ASSERT_EQ(alpha.size(), 3);
+        ASSERT_EQ(alpha[0].getNumber(), -4.0);
+        ASSERT_EQ(alpha[1].getNumber(), 5.0);
+        ASSERT_EQ(alpha[2].getNumber(), 0.01);
+        ASSERT_TRUE(value.find("pressure")->getBoolean());
+        ASSERT_EQ(value.find("polar")->getType(), JsonType::Null);
+        ASSERT_FALSE(value.find("nested")->find("x")->getBoolean());
+        ASSERT_EQ(value.find("missing"), nullptr);
+        ASSERT_EQ(JsonValue::parse("\"\\ud83d\\ude00\"").getString(), "\xf0\x9f\x98\x80");
+    }
+
+    TEST(JsonValue, parseInvalidArguments)
+    {
+        for (const char *text : {"", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "01", "1.", "-", "+1", "0x10", "tru", "\"a", "\"\\q\"", "1 2", "[1] x"})
+            ASSERT_THROW(JsonValue::parse(text), std::invalid_argument) << text;
+        ASSERT_THROW(JsonValue::parse(std::string(100, '[') + std::string(100, ']')), std::invalid_argument);
+        ASSERT_THROW(JsonValue::parse("1").getString(), std::invalid_argument);
+        ASSERT_THROW(JsonValue::parse("[]").find("a"), std::invalid_argument);
+    }
+
+    TEST(JsonValue, serialize)
+    {
+        JsonValue value = JsonValue::object();
+        value.set("id", "a\"\n\x01");
+        value.set("cl", std::vector<double>{0.1, -2.0, std::numeric_limits<double>::quiet_NaN()});
+        value.set("ok", true);
+        value.set("points", 100);
+        value.set("points", 200);
+        JsonValue nested = JsonValue::array();
+        nested.push(JsonValue());
+        nested.push(JsonValue::object());
+        value.set("nested", nested);
+        ASSERT_EQ(value.serialize(), "{\"id\":\"a\\\"\\n\\u0001\",\"cl\":[0.10000000000000001,-2,null],\"ok\":true,\"points\":200,\"nested\":[null,{}]}");
+
+        // numbers round trip
+        double third = 1.0 / 3.0;
+        ASSERT_EQ(JsonValue::parse(JsonValue(third).serialize()).getNumber(), third);
+        ASSERT_EQ(JsonValue::parse(value.serialize()).serialize(), value.serialize());
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "polar_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "naca_sweep.h"
+#include "polar.h"
+
+using aerodynamics::Polar;
+using aerodynamics::SweepCase;
+using io::PolarReader;
+using io::PolarRecord;
+using io::PolarWriter;
+
+namespace
+{
+    std::string createPath(const std::string &name)
+    {
+        std::string path = testing::TempDir() + "/" + name;
+        std::remove(path.c_str());
+        return path;
+    }
+
+    SweepCase createCase(int index, int angleCount, int panelCount)
+    {
+        SweepCase sweepCase{index, 0.5 * index, 40.0, 12.0, 2 * panelCount + 2, Polar()};
+        Polar &polar = sweepCase.polar;
+        for (int k = 0; k < angleCount; ++k)
+        {
+            polar.angles.push_back(k - 2.0);
+            polar.lift.push_back(0.1 * k + index);
+            polar.drag.push_back(0.01 * k);
+            polar.moment.push_back(-0.02 * k);
+        }
+        polar.panelCount = panelCount;
+        for (int i = 0; i < angleCount * panelCount; ++i)
+            polar.pressure.push_back(1.0 - 0.25 * i);
+        return sweepCase;
+    }
+
+    void expectRecord(const PolarRecord &record, const SweepCase &sweepCase)
+    {
+        const Polar &polar = sweepCase.polar;
+        ASSERT_EQ(record.index, sweepCase.index);
+        ASSERT_EQ(record.pointCount, sweepCase.pointCount);
+        ASSERT_EQ(record.maxCamberPercent, sweepCase.maxCamberPercent);
+        ASSERT_EQ(record.maxCamberPositionPercent, sweepCase.maxCamberPositionPercent);
+        ASSERT_EQ(record.thicknessPercent, sweepCase.thicknessPercent);
+        ASSERT_EQ(record.angleCount, polar.angles.size());
+        ASSERT_EQ(record.panelCount, polar.panelCount);
+        ASSERT_EQ(std::vector<double>(record.angles, record.angles + record.angleCount), polar.angles);
+        ASSERT_EQ(std::vector<double>(record.lift, record.lift + record.angleCount), polar.lift);
+        ASSERT_EQ(std::vector<double>(record.drag, record.drag + record.angleCount), polar.drag);
+        ASSERT_EQ(std::vector<double>(record.moment, record.moment + record.angleCount), polar.moment);
+        if (polar.panelCount == 0)
+            ASSERT_EQ(record.pressure, nullptr);
+        else
+            ASSERT_EQ(std::vector<double>(record.pressure, record.pressure + record.angleCount * record.panelCount), polar.pressure);
+    }
+
+    TEST(PolarWriter, append)
+    {
+        std::string path = createPath("polar_writer_append.polar");
+        std::vector<SweepCase> cases = {createCase(0, 5, 0), createCase(1, 3, 8), createCase(2, 1, 0)};
+        {
+            PolarWriter writer(path);
+            writer.append(cases[0]);
+            writer.append(cases[1]);
+        }
+        {
+            // reopening appends after the existing cases
+            PolarWriter writer(path);
+            writer.append(cases[2]);
+        }
+
+        PolarReader reader(path);
+        ASSERT_EQ(reader.caseCount(), 3);
+        for (int k = 0; k < 3; ++k)
+            expectRecord(reader.getCase(k), cases[k]);
+
+        // the header and values are little-endian
+        std::ifstream file(path, std::ios::binary);
+        std::vector<unsigned char> bytes(96);
+        file.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+        ASSERT_EQ(std::string(bytes.begin(), bytes.begin() + 8), "AIRFPOLR");
+        ASSERT_EQ(bytes[8], 1);
+        ASSERT_EQ(bytes[9], 0);
+        ASSERT_EQ(bytes[64 + 24], 5);
+        ASSERT_EQ(bytes[64 + 25], 0);
+    }
+
+    TEST(PolarWriter, appendInvalidArguments)
+    {
+        PolarWriter writer(createPath("polar_writer_invalid.polar"));
+        SweepCase sweepCase = createCase(0, 3, 4);
+        sweepCase.polar.drag.pop_back();
+        ASSERT_THROW(writer.append(sweepCase), std::invalid_argument);
+        sweepCase = createCase(0, 3, 4);
+        sweepCase.polar.pressure.pop_back();
+        ASSERT_THROW(writer.append(sweepCase), std::invalid_argument);
+    }
+
+    TEST(PolarReader, partialBlock)
+    {
+        std::string path = createPath("polar_reader_partial.polar");
+        std::vector<SweepCase> cases = {createCase(0, 4, 6), createCase(1, 4, 6)};
+        {
+            PolarWriter writer(path);
+            writer.append(cases[0]);
+        }
+        std::size_t completeBytes = PolarReader(path).validBytes();
+        {
+            // an interrupted append leaves the start of a block
+            std::ofstream file(path, std::ios::binary | std::ios::app);
+            file.write("CASE\x40\0\0\0", 8);
+        }
+
+        {
+            PolarReader reader(path);
+            ASSERT_EQ(reader.caseCount(), 1);
+            ASSERT_EQ(reader.validBytes(), completeBytes);
+            expectRecord(reader.getCase(0), cases[0]);
+            ASSERT_THROW(reader.getCase(1), std::invalid_argument);
+        }
+
+        // the writer drops the partial block before appending
+        {
+            PolarWriter writer(path);
+            writer.append(cases[1]);
+        }
+        PolarReader reader(path);
+        ASSERT_EQ(reader.caseCount(), 2);
+        expectRecord(reader.getCase(1), cases[1]);
+    }
+
+    TEST(PolarReader, oversizedCounts)
+    {
+        std::string path = createPath("polar_reader_oversized.polar");
+        SweepCase sweepCase = createCase(0, 4, 6);
+        {
+            PolarWriter writer(path);
+            writer.append(sweepCase);
+        }
+        std::size_t completeBytes = PolarReader(path).validBytes();
+
+        // counts whose block size wraps to the bare header, once above INT_MAX and once below it
+        const std::vector<std::vector<unsigned char>> counts = {{0, 0, 0, 0x80, 0xfc, 0xff, 0xff, 0x3f}, {0, 0, 0, 0x40, 0xfc, 0xff, 0xff, 0x7f}};
+        for (const std::vector<unsigned char> &count : counts)
+        {
+            std::vector<unsigned char> header(64, 0);
+            std::copy_n("CASE", 4, header.begin());
+            header[8] = 64;
+            std::copy(count.begin(), count.end(), header.begin() + 24);
+            {
+                PolarWriter writer(path);
+            }
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::app);
+                file.write(reinterpret_cast<const char *>(header.data()), header.size());
+                file.write(std::string(64, '\0').data(), 64);
+            }
+
+            PolarReader reader(path);
+            ASSERT_EQ(reader.caseCount(), 1);
+            ASSERT_EQ(reader.validBytes(), completeBytes);
+            expectRecord(reader.getCase(0), sweepCase);
+        }
+    }
+
+    TEST(PolarReader, invalidFile)
+    {
+        std::string path = createPath("polar_reader_invalid.polar");
+        ASSERT_THROW(PolarReader reader(path), std::runtime_error);
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << std::string(100, 'x');
+        }
+        ASSERT_THROW(PolarReader reader(path), std::invalid_argument);
+        ASSERT_THROW(PolarWriter writer(path), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
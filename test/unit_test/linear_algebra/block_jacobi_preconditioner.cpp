@@ -0,0 +1,56 @@
+#include "block_jacobi_preconditioner.h"
+
+#include <gtest/gtest.h>
+
+#include "matrix.h"
+
+using linear_algebra::BlockJacobiPreconditioner;
+using linear_algebra::Matrix;
+
+namespace
+{
+    TEST(BlockJacobiPreconditioner, apply)
+    {
+        Matrix a(3, 3);
+        a[0][0] = 2;
+        a[0][1] = 1;
+        a[1][0] = 1;
+        a[1][1] = 3;
+        a[2][2] = 4;
+        // Off block entries are ignored
+        a[0][2] = 10;
+        a[2][0] = 10;
+        BlockJacobiPreconditioner preconditioner(a, 2);
+        ASSERT_EQ(preconditioner.blockCount(), 2);
+        double r[3] = {3, 4, 8};
+        double z[3];
+        preconditioner.apply(r, z);
+        ASSERT_FLOAT_EQ(z[0], 1);
+        ASSERT_FLOAT_EQ(z[1], 1);
+        ASSERT_FLOAT_EQ(z[2], 2);
+    }
+
+    TEST(BlockJacobiPreconditioner, applyEntries)
+    {
+        // the blocks of the matrix above given entry by entry
+        double entries[3][3] = {{2, 1, 10}, {1, 3, 0}, {10, 0, 4}};
+        BlockJacobiPreconditioner preconditioner(3, 2, [&entries](int i, int j)
+                                                 { return entries[i][j]; });
+        ASSERT_EQ(preconditioner.blockCount(), 2);
+        double r[3] = {3, 4, 8};
+        double z[3];
+        preconditioner.apply(r, z);
+        ASSERT_FLOAT_EQ(z[0], 1);
+        ASSERT_FLOAT_EQ(z[1], 1);
+        ASSERT_FLOAT_EQ(z[2], 2);
+    }
+
+    TEST(BlockJacobiPreconditioner, BlockJacobiPreconditionerInvalidArguments)
+    {
+        ASSERT_THROW(BlockJacobiPreconditioner(Matrix(3, 4), 2), std::invalid_argument);
+        ASSERT_THROW(BlockJacobiPreconditioner(Matrix::identity(3), 0), std::invalid_argument);
+        ASSERT_THROW(BlockJacobiPreconditioner(-1, 2, [](int, int)
+                                               { return 0.0; }),
+                     std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "gmres.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "block_jacobi_preconditioner.h"
+#include "linear_operator.h"
+#include "matrix.h"
+
+using linear_algebra::BlockJacobiPreconditioner;
+using linear_algebra::GMRES;
+using linear_algebra::Matrix;
+using linear_algebra::MatrixOperator;
+using linear_algebra::SolverReport;
+
+namespace
+{
+    Matrix nonsymmetric(int order)
+    {
+        Matrix a(order, order);
+        for (int i = 0; i < order; ++i)
+            for (int j = 0; j < order; j++)
+                a[i][j] = i == j ? 4.0 + i % 3 : 1.0 / (1.0 + std::abs(i - 2 * j));
+        return a;
+    }
+
+    TEST(GMRES, solve)
+    {
+        Matrix a(3, 3);
+        a[0][0] = 1;
+        a[0][1] = -2;
+        a[0][2] = 3;
+        a[1][0] = -1;
+        a[1][1] = 3;
+        a[1][2] = -1;
+        a[2][0] = 2;
+        a[2][1] = -5;
+        a[2][2] = 5;
+        std::vector<double> b{9, -6, 17};
+        std::vector<double> x;
+        SolverReport report = GMRES(1e-12).solve(MatrixOperator(a), b, x);
+        ASSERT_TRUE(report.converged);
+        ASSERT_LE(report.iterations, 3);
+        ASSERT_NEAR(x[0], 1, 1e-10);
+        ASSERT_NEAR(x[1], -1, 1e-10);
+        ASSERT_NEAR(x[2], 2, 1e-10);
+    }
+
+    TEST(GMRES, solveRestarted)
+    {
+        Matrix a = nonsymmetric(60);
+        std::vector<double> b(60);
+        for (int i = 0; i < 60; ++i)
+            b[i] = std::sin(i);
+        std::vector<double> x;
+        SolverReport report = GMRES(1e-10, 5, 1000).solve(MatrixOperator(a), b, x);
+        ASSERT_TRUE(report.converged);
+        ASSERT_GT(report.restarts, 0);
+        std::vector<double> product(60);
+        a.multiply(x.data(), product.data());
+        for (int i = 0; i < 60; ++i)
+            ASSERT_NEAR(product[i], b[i], 1e-8);
+    }
+
+    TEST(GMRES, solvePreconditioned)
+    {
+        Matrix a = nonsymmetric(60);
+        std::vector<double> b(60, 1.0);
+        std::vector<double> plain, preconditioned;
+        SolverReport plainReport = GMRES(1e-10).solve(MatrixOperator(a), b, plain);
+        BlockJacobiPreconditioner preconditioner(a, 8);
+        SolverReport preconditionedReport = GMRES(1e-10).solve(MatrixOperator(a), b, preconditioned, &preconditioner);
+        ASSERT_TRUE(preconditionedReport.converged);
+        ASSERT_LE(preconditionedReport.iterations, plainReport.iterations);
+        for (int i = 0; i < 60; ++i)
+            ASSERT_NEAR(preconditioned[i], plain[i], 1e-8);
+    }
+
+    TEST(GMRES, solveMaxIterations)
+    {
+        Matrix a = nonsymmetric(60);
+        std::vector<double> b(60, 1.0);
+        std::vector<double> x;
+        SolverReport report = GMRES(1e-14, 50, 2).solve(MatrixOperator(a), b, x);
+        ASSERT_FALSE(report.converged);
+        ASSERT_EQ(report.iterations, 2);
+        ASSERT_GT(report.residual, 1e-14);
+    }
+
+    TEST(GMRES, solveZeroRightHandSide)
+    {
+        Matrix a = Matrix::identity(4);
+        std::vector<double> b(4, 0.0);
+        std::vector<double> x(4, 1.0);
+        SolverReport report = GMRES().solve(MatrixOperator(a), b, x);
+        ASSERT_TRUE(report.converged);
+        ASSERT_EQ(report.iterations, 0);
+        for (double value : x)
+            ASSERT_FLOAT_EQ(value, 0.0);
+    }
+
+    TEST(GMRES, GMRESInvalidArguments)
+    {
+        ASSERT_THROW(GMRES(0.0), std::invalid_argument);
+        ASSERT_THROW(GMRES(1e-10, 0), std::invalid_argument);
+        ASSERT_THROW(GMRES(1e-10, 10, 0), std::invalid_argument);
+        std::vector<double> x;
+        ASSERT_THROW(GMRES().solve(MatrixOperator(Matrix::identity(3)), std::vector<double>(4), x), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
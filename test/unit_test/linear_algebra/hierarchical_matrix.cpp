@@ -0,0 +1,71 @@
+#include "hierarchical_matrix.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "matrix.h"
+
+using linear_algebra::HierarchicalMatrix;
+using linear_algebra::HierarchicalOptions;
+using linear_algebra::Matrix;
+
+namespace
+{
+    TEST(HierarchicalMatrix, apply)
+    {
+        // log |z_i - z_j| between points along a circle, with 1 on the diagonal
+        int count = 1000;
+        std::vector<double> x(count), y(count);
+        for (int i = 0; i < count; ++i)
+        {
+            x[i] = std::cos(2.0 * M_PI * i / count);
+            y[i] = std::sin(2.0 * M_PI * i / count);
+        }
+        Matrix a(count, count);
+        for (int i = 0; i < count; ++i)
+            for (int j = 0; j < count; j++)
+                a(i, j) = i == j ? 1.0 : std::log(std::hypot(x[i] - x[j], y[i] - y[j]));
+        HierarchicalMatrix h(x, y, [&a](int i, int columnBegin, int columnEnd, double *values)
+                             {
+            for (int j = columnBegin; j < columnEnd; j++)
+                values[j - columnBegin] = a(i, j); });
+        ASSERT_EQ(h.size(), count);
+        ASSERT_GT(h.lowRankBlockCount(), 0);
+        ASSERT_LT(h.storedValueCount(), static_cast<std::size_t>(count) * count / 2);
+
+        std::mt19937_64 generator(11);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::vector<double> v(count), expected(count), result(count);
+        for (int j = 0; j < count; ++j)
+            v[j] = uniform(generator);
+        a.multiply(v.data(), expected.data());
+        h.apply(v.data(), result.data());
+        for (int i = 0; i < count; ++i)
+            ASSERT_NEAR(result[i], expected[i], 1e-8);
+        for (int i = 0; i < count; i += 37)
+            for (int j = 0; j < count; j += 41)
+                ASSERT_NEAR(h.entry(i, j), a(i, j), 1e-9);
+    }
+
+    TEST(HierarchicalMatrix, HierarchicalMatrixInvalidArguments)
+    {
+        auto row = [](int, int, int, double *) {};
+        std::vector<double> x = {0.0, 1.0}, y = {0.0, 0.0};
+        ASSERT_THROW(HierarchicalMatrix(std::vector<double>(), std::vector<double>(), row), std::invalid_argument);
+        ASSERT_THROW(HierarchicalMatrix(x, std::vector<double>(1), row), std::invalid_argument);
+        HierarchicalOptions options;
+        options.leafSize = 0;
+        ASSERT_THROW(HierarchicalMatrix(x, y, row, options), std::invalid_argument);
+        options.leafSize = 32;
+        options.tolerance = 0.0;
+        ASSERT_THROW(HierarchicalMatrix(x, y, row, options), std::invalid_argument);
+        options.tolerance = 1e-8;
+        options.eta = 0.0;
+        ASSERT_THROW(HierarchicalMatrix(x, y, row, options), std::invalid_argument);
+        ASSERT_THROW(HierarchicalMatrix(x, y, row).entry(2, 0), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "lu_factorization.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "matrix.h"
+
+using linear_algebra::LUFactorization;
+using linear_algebra::Matrix;
+
+namespace
+{
+    TEST(LUFactorization, solve)
+    {
+        Matrix a(3, 3);
+        a[0][0] = 1;
+        a[0][1] = -2;
+        a[0][2] = 3;
+        a[1][0] = -1;
+        a[1][1] = 3;
+        a[1][2] = -1;
+        a[2][0] = 2;
+        a[2][1] = -5;
+        a[2][2] = 5;
+        Matrix b(3, 1);
+        b[0][0] = 9;
+        b[1][0] = -6;
+        b[2][0] = 17;
+        LUFactorization lu(a);
+        Matrix x = lu.solve(b);
+        ASSERT_FLOAT_EQ(x[0][0], 1);
+        ASSERT_FLOAT_EQ(x[1][0], -1);
+        ASSERT_FLOAT_EQ(x[2][0], 2);
+    }
+
+    TEST(LUFactorization, solveZeroLeadingMinor)
+    {
+        Matrix a(3, 3);
+        a[0][0] = 0;
+        a[0][1] = 2;
+        a[0][2] = 1;
+        a[1][0] = 1;
+        a[1][1] = 1;
+        a[1][2] = 0;
+        a[2][0] = 2;
+        a[2][1] = 0;
+        a[2][2] = 3;
+        Matrix b(3, 1);
+        b[0][0] = 7;
+        b[1][0] = 3;
+        b[2][0] = 11;
+        LUFactorization lu(a);
+        Matrix x = lu.solve(b);
+        ASSERT_FLOAT_EQ(x[0][0], 1);
+        ASSERT_FLOAT_EQ(x[1][0], 2);
+        ASSERT_FLOAT_EQ(x[2][0], 3);
+        ASSERT_EQ(lu.getPivots()[0], 2);
+    }
+
+    TEST(LUFactorization, solveMultipleColumns)
+    {
+        Matrix a(2, 2);
+        a[0][0] = 4;
+        a[0][1] = 3;
+        a[1][0] = 6;
+        a[1][1] = 3;
+        Matrix b(2, 3);
+        b[0][0] = 10;
+        b[1][0] = 12;
+        b[0][1] = 1;
+        b[1][1] = 0;
+        b[0][2] = 0;
+        b[1][2] = 1;
+        LUFactorization lu(a);
+        Matrix x = lu.solve(b);
+        ASSERT_FLOAT_EQ(x[0][0], 1);
+        ASSERT_FLOAT_EQ(x[1][0], 2);
+        // the last two columns are the inverse of a
+        ASSERT_FLOAT_EQ(x[0][1], -0.5);
+        ASSERT_FLOAT_EQ(x[1][1], 1);
+        ASSERT_FLOAT_EQ(x[0][2], 0.5);
+        ASSERT_FLOAT_EQ(x[1][2], -2.0 / 3.0);
+    }
+
+    TEST(LUFactorization, solveRepeated)
+    {
+        Matrix a = Matrix::identity(3);
+        a[0][2] = 2;
+        LUFactorization lu(a);
+        for (int i = 0; i < 3; ++i)
+        {
+            Matrix b(3, 1);
+            b[i][0] = 1;
+            Matrix x = lu.solve(b);
+            Matrix product = a * x;
+            for (int j = 0; j < 3; j++)
+                ASSERT_FLOAT_EQ(product[j][0], b[j][0]);
+        }
+    }
+
+    TEST(LUFactorization, solveBlocked)
+    {
+        // Larger than a panel, then than a column block, and not a multiple of the tile size so every blocked path runs with every kernel
+        std::vector<int> laneCounts = LUFactorization::getSupportedLaneCounts();
+        for (int order : {203, 581})
+        {
+            Matrix a(order, order);
+            Matrix b(order, 2);
+            for (int i = 0; i < order; ++i)
+            {
+                for (int j = 0; j < order; j++)
+                    a[i][j] = std::sin(0.37 * i + 1.91 * j) + (i == j ? 0.5 : 0.0);
+                b[i][0] = std::cos(0.13 * i);
+                b[i][1] = i % 7 - 3.0;
+            }
+            for (int laneCount : laneCounts)
+            {
+                SCOPED_TRACE(laneCount);
+                LUFactorization::setLaneCount(laneCount);
+                Matrix x = LUFactorization(a).solve(b);
+                Matrix product = a * x;
+                for (int i = 0; i < order; ++i)
+                {
+                    ASSERT_NEAR(product[i][0], b[i][0], 1e-9);
+                    ASSERT_NEAR(product[i][1], b[i][1], 1e-9);
+                }
+            }
+        }
+        LUFactorization::setLaneCount(laneCounts.back());
+        ASSERT_EQ(LUFactorization::laneCount(), laneCounts.back());
+        ASSERT_THROW(LUFactorization::setLaneCount(3), std::invalid_argument);
+    }
+
+    TEST(LUFactorization, factor)
+    {
+        // Each order reuses the storage reserved for the largest one and matches a fresh factorization
+        LUFactorization lu(203);
+        ASSERT_EQ(lu.order(), 0);
+        const double *data = lu.getLU().data();
+        for (int order : {203, 70, 5, 203})
+        {
+            Matrix a(order, order);
+            std::vector<double> b(order), x(order), expected(order);
+            for (int i = 0; i < order; ++i)
+            {
+                for (int j = 0; j < order; j++)
+                    a[i][j] = std::sin(0.37 * i + 1.91 * j + order) + (i == j ? 0.5 : 0.0);
+                b[i] = std::cos(0.13 * i);
+            }
+            lu.factor(a);
+            ASSERT_EQ(lu.order(), order);
+            ASSERT_EQ(lu.getLU().data(), data);
+            lu.solve(b.data(), x.data());
+            LUFactorization(a).solve(b.data(), expected.data());
+            for (int i = 0; i < order; ++i)
+                ASSERT_NEAR(x[i], expected[i], 1e-9);
+        }
+        ASSERT_THROW(lu.factor(Matrix(3, 4)), std::invalid_argument);
+        ASSERT_THROW(lu.factor(Matrix(3, 3)), std::invalid_argument);
+    }
+
+    TEST(LUFactorization, LUFactorizationInvalidArguments)
+    {
+        ASSERT_THROW(LUFactorization(Matrix(3, 4)), std::invalid_argument);
+        ASSERT_THROW(LUFactorization(Matrix(3, 3)), std::invalid_argument);
+        ASSERT_THROW(LUFactorization(Matrix::identity(3)).solve(Matrix(4, 1)), std::invalid_argument);
+    }
+} // namespace
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "matrix.h"
 
+#include <cstdint>
+
 #include <gtest/gtest.h>
 
 #include "point.h"
@@ -27,6 +29,78 @@ namespace
         ASSERT_FLOAT_EQ(m[2][0], 3.75);
     }
 
+    TEST(Matrix, MatrixInvalidArguments)
+    {
+        ASSERT_THROW(Matrix(-1, 2), std::invalid_argument);
+        ASSERT_THROW(Matrix(2, -1), std::invalid_argument);
+    }
+
+    TEST(Matrix, contiguousStorage)
+    {
+        Matrix m(3, 5);
+        ASSERT_EQ(m.stride(), 5);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(m.data()) % 64, 0);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 5; j++)
+                m(i, j) = i * 5 + j;
+        for (int k = 0; k < 15; ++k)
+            ASSERT_FLOAT_EQ(m.data()[k], k);
+        ASSERT_EQ(m[1], m.data() + 5);
+    }
+
+    TEST(Matrix, resize)
+    {
+        Matrix m(4, 4);
+        const double *data = m.data();
+        m(1, 1) = 2.5;
+        m.resize(2, 3);
+        ASSERT_EQ(m.rowCount(), 2);
+        ASSERT_EQ(m.columnCount(), 3);
+        ASSERT_EQ(m.stride(), 3);
+        ASSERT_EQ(m.data(), data);
+        for (int k = 0; k < 6; ++k)
+            ASSERT_FLOAT_EQ(m.data()[k], 0.0);
+        m.resize(5, 5);
+        ASSERT_EQ(m.rowCount(), 5);
+        ASSERT_FLOAT_EQ(m(4, 4), 0.0);
+        ASSERT_THROW(m.resize(-1, 2), std::invalid_argument);
+    }
+
+    TEST(Matrix, at)
+    {
+        Matrix m(2, 3);
+        m.at(1, 2) = 4.5;
+        ASSERT_FLOAT_EQ(m(1, 2), 4.5);
+        ASSERT_THROW(m.at(2, 0), std::out_of_range);
+        ASSERT_THROW(m.at(0, 3), std::out_of_range);
+        ASSERT_THROW(m.at(-1, 0), std::out_of_range);
+    }
+
+    TEST(Matrix, rowAndColumn)
+    {
+        Matrix m(2, 3);
+        m[0][0] = 1.0;
+        m[0][1] = 2.0;
+        m[0][2] = 3.0;
+        m[1][0] = 4.0;
+        m[1][1] = 5.0;
+        m[1][2] = 6.0;
+        linear_algebra::StridedView<double> row = m.row(1);
+        ASSERT_EQ(row.size(), 3);
+        ASSERT_EQ(row.stride(), 1);
+        ASSERT_FLOAT_EQ(row[2], 6.0);
+        const Matrix &c = m;
+        linear_algebra::StridedView<const double> column = c.column(1);
+        ASSERT_EQ(column.size(), 2);
+        ASSERT_EQ(column.stride(), 3);
+        ASSERT_FLOAT_EQ(column[0], 2.0);
+        ASSERT_FLOAT_EQ(column[1], 5.0);
+        m.column(2)[1] = 7.5;
+        ASSERT_FLOAT_EQ(m[1][2], 7.5);
+        ASSERT_THROW(m.row(2), std::out_of_range);
+        ASSERT_THROW(m.column(3), std::out_of_range);
+    }
+
     TEST(Matrix, identity2x2)
     {
         Matrix m = Matrix::identity(2);
@@ -126,6 +200,22 @@ namespace
         ASSERT_FLOAT_EQ(m[1][1], 19.0625);
     }
 
+    TEST(Matrix, multiplyVector)
+    {
+        Matrix m(2, 3);
+        m[0][0] = 1.0;
+        m[0][1] = 2.0;
+        m[0][2] = 3.0;
+        m[1][0] = -1.0;
+        m[1][1] = 0.5;
+        m[1][2] = 4.0;
+        double x[3] = {2.0, 1.0, -1.0};
+        double y[2];
+        m.multiply(x, y);
+        ASSERT_FLOAT_EQ(y[0], 1.0);
+        ASSERT_FLOAT_EQ(y[1], -5.5);
+    }
+
     TEST(Matrix, multiplicationInvalidArguments)
     {
         ASSERT_THROW(Matrix(3, 4) * Matrix(3, 4), std::invalid_argument);